@@ -31,6 +31,21 @@ namespace Minesweeper {
         static constexpr int WINDOW_WIDTH = BOARD_WIDTH * TILE_SIZE;
         static constexpr int WINDOW_HEIGHT = BOARD_HEIGHT * TILE_SIZE + UI_HEIGHT;
         
+        // Main loop: the simulation advances in fixed steps, rendering runs
+        // as fast as allowed (VSync, FRAMERATE_LIMIT, 0 = uncapped)
+        static constexpr int SIMULATION_RATE = 120; // steps per second
+        static constexpr int MAX_STEPS_PER_FRAME = 8; // drops the backlog after a long stall
+        static constexpr bool VSYNC_ENABLED = true;
+        static constexpr unsigned int FRAMERATE_LIMIT = 0;
+        
+        // Partie en cours, sauvegardée à la pause et à la sortie
+        static constexpr const char* AUTOSAVE_PATH = "autosave.mssave";
+        // Replays des parties terminées, un fichier par partie
+        static constexpr const char* REPLAY_DIRECTORY = "replays";
+        // Statistiques: journal des parties terminées et son index
+        static constexpr const char* STATS_LOG_PATH = "stats.mslog";
+        static constexpr const char* STATS_INDEX_PATH = "stats.msidx";
+        
         // Colors
         static constexpr unsigned int BACKGROUND_COLOR = 0x1E1E2EFF;
         static constexpr unsigned int UI_BACKGROUND_COLOR = 0x181825FF;
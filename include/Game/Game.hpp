@@ -17,12 +17,11 @@ namespace Minesweeper {
     private:
         sf::RenderWindow window_;
         StateManager stateManager_;
-        sf::Clock gameClock_;
         
         void initializeWindow();
         void initializeStates();
         void processEvents();
         void update(float deltaTime);
-        void render();
+        void render(float alpha);
     };
 }
\ No newline at end of file
@@ -19,7 +19,7 @@ namespace Minesweeper {
         std::shared_ptr<Renderer> renderer_;
         MouseHandler mouseHandler_;
         
-        void handleMouseEvents(sf::RenderWindow& window);
+        void handleMouseEvents(const BoardView& board);
         void handleKeyboardEvents(const sf::Event& event);
         void handleWindowEvents(const sf::Event& event, sf::RenderWindow& window);
     };
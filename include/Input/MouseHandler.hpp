@@ -13,12 +13,15 @@ namespace Minesweeper {
         // Button checks
         bool isLeftClicked() const { return leftClicked_; }
         bool isRightClicked() const { return rightClicked_; }
+        // Middle click, or left and right held together (the second press
+        // chords instead of counting as a click of its own)
+        bool isChordClicked() const { return chordClicked_; }
         bool isLeftPressed() const { return leftPressed_; }
         bool isRightPressed() const { return rightPressed_; }
         
         // Position
+        // Window coordinates; the Renderer maps them onto the board
         sf::Vector2i getPosition() const { return mousePosition_; }
-        sf::Vector2i getBoardPosition(const sf::Window& window) const;
         
     private:
         sf::Vector2i mousePosition_;
@@ -26,8 +29,10 @@ namespace Minesweeper {
         bool rightPressed_ = false;
         bool leftClicked_ = false;
         bool rightClicked_ = false;
+        bool chordClicked_ = false;
         
         bool wasLeftPressed_ = false;
         bool wasRightPressed_ = false;
+        bool wasMiddlePressed_ = false;
     };
 }
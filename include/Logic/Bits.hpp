@@ -0,0 +1,25 @@
+#pragma once
+#include <cstdint>
+
+namespace Minesweeper {
+    // Portable bit tricks on 64-bit words (C++17 has no <bit>)
+    namespace Bits {
+        inline int popcount64(std::uint64_t word) {
+            word = word - ((word >> 1) & 0x5555555555555555ull);
+            word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+            word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+            return static_cast<int>((word * 0x0101010101010101ull) >> 56);
+        }
+
+        // Index of the lowest set bit; word must not be 0
+        inline int lowestBit(std::uint64_t word) {
+            static const int positions[64] = {
+                 0,  1, 48,  2, 57, 49, 28,  3, 61, 58, 50, 42, 38, 29, 17,  4,
+                62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12,  5,
+                63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11,
+                46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19,  9, 13,  8,  7,  6
+            };
+            return positions[((word & (~word + 1)) * 0x03F79D71B4CB0A89ull) >> 58];
+        }
+    }
+}
@@ -1,27 +1,178 @@
 #pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <vector>
 #include <memory>
+#include <string>
 #include "Cell.hpp"
+#include "MappedFile.hpp"
 #include "../Game/Config.hpp"
 
 namespace Minesweeper {
+    class BoardView;
+    
+    // Storage order of the cells. Tiled stores 8x8 blocks of cells
+    // contiguously: a block is one 64-byte cache line, so a cell's 3x3
+    // neighborhood spans one line most of the time (at most four) instead of
+    // three rows a board-width apart.
+    enum class CellLayout {
+        RowMajor,
+        Tiled
+    };
+    
+    // Cells revealed by the last cascade, the clicked cell first. When the
+    // board tracks levels (an animation is attached), cells of level i are
+    // cells[levelStarts[i] .. levelStarts[i+1]): level 0 is the clicked
+    // cell, then BFS levels, or Chebyshev rings around the click when a
+    // precomputed opening was revealed in bulk. Otherwise all the cells
+    // are one level, in no particular order.
+    struct RevealTrace {
+        std::vector<size_t> cells; // storage indices (Board::cellIndex)
+        std::vector<size_t> levelStarts;
+        
+        size_t getLevelCount() const { return levelStarts.size(); }
+    };
+    
+    // Bounding box of the cells changed since the region was last taken,
+    // so a cached drawing of the board only redraws that part
+    struct DirtyRegion {
+        int minX = 0;
+        int minY = 0;
+        int maxX = -1;
+        int maxY = -1;
+        
+        bool isEmpty() const { return maxX < minX || maxY < minY; }
+        void include(int x, int y) {
+            if (isEmpty()) {
+                minX = maxX = x;
+                minY = maxY = y;
+                return;
+            }
+            minX = std::min(minX, x);
+            minY = std::min(minY, y);
+            maxX = std::max(maxX, x);
+            maxY = std::max(maxY, y);
+        }
+    };
+    
+    // Difficulty of a generated board, computed with the openings.
+    // 3BV is the minimum number of left clicks that clears the board: one
+    // per opening plus one per number cell that touches no opening.
+    struct BoardMetrics {
+        int bbbv = 0;
+        int openings = 0;
+        int isolatedNumbers = 0;
+    };
+
+    // Cell mapping used to move a board generated for one first click (the
+    // origin) to another: a symmetry of the board (transpose on square
+    // boards, then flips), then a cyclic translation. It is a bijection of
+    // the cells, so a uniform placement stays uniform.
+    struct BoardTransform {
+        bool transpose = false;
+        bool flipX = false;
+        bool flipY = false;
+        int dx = 0; // in [0, width)
+        int dy = 0; // in [0, height)
+        
+        bool isSymmetry() const { return dx == 0 && dy == 0; }
+        void apply(int width, int height, int& x, int& y) const {
+            if (transpose) {
+                std::swap(x, y);
+            }
+            if (flipX) {
+                x = width - 1 - x;
+            }
+            if (flipY) {
+                y = height - 1 - y;
+            }
+            x = (x + dx) % width;
+            y = (y + dy) % height;
+        }
+        
+        // A transform taking the cells kept free of mines around the origin
+        // exactly onto those around the click (same shape: both inside,
+        // both on an edge, or both in a corner), symmetries first
+        static bool find(int width, int height, int originX, int originY,
+                         int clickX, int clickY, BoardTransform& transform);
+    };
+    
     class Board {
     public:
         Board(int width = Config::BOARD_WIDTH, 
               int height = Config::BOARD_HEIGHT, 
-              int mineCount = Config::MINES_COUNT);
+              int mineCount = Config::MINES_COUNT,
+              CellLayout layout = CellLayout::RowMajor);
+        ~Board();
+        
+        // New size for a board in memory, keeping its allocations when the
+        // cells fit (boards reused between games), reset with the same
+        // seed. Fails on mapped boards.
+        bool resize(int width, int height, int mineCount);
+        
+        // Boards backed by a memory-mapped board file (format in
+        // BoardFile.hpp). Opening costs the same whatever the board size,
+        // the OS pages cells in and out. Return nullptr on failure: the
+        // header is checked against the file size before any cell is
+        // touched. Up to MAX_CELLS cells, the counters being int.
+        static constexpr size_t MAX_CELLS = 0x7FFFFFFF;
+        static std::unique_ptr<Board> createMapped(const std::string& path, int width,
+                                                   int height, int mineCount,
+                                                   CellLayout layout = CellLayout::RowMajor);
+        static std::unique_ptr<Board> openMapped(const std::string& path);
         
-        // Initialization
-        void initialize(int firstClickX, int firstClickY);
-        void reset();
+        bool isMapped() const { return mapping_ != nullptr; }
+        // Mapped boards: update the header and write dirty pages to disk
+        bool flush();
+        
+        // Initialization. Pooled boards (BoardPool) come with their mines,
+        // drawn for the origin: row-major bits, cell i in bit i % 64 of word
+        // i / 64.
+        void initialize(int firstClickX, int firstClickY, const std::uint64_t* originMines = nullptr);
+        bool isInitialized() const { return isInitialized_; }
+        void reset(); // also picks a new random seed and clears the origin
+        void reset(std::uint64_t seed); // same, with this seed (no OS entropy drawn)
+        
+        // Mines are drawn from the seed by initialize(): the same seed and
+        // first click always give the same board. With an origin they are
+        // drawn for a first click there, then moved to the real one by a
+        // BoardTransform (drawn for the click when none fits).
+        void setSeed(std::uint64_t seed) { seed_ = seed; }
+        std::uint64_t getSeed() const { return seed_; }
+        void setOrigin(int x, int y) { originX_ = x, originY_ = y; }
+        bool hasOrigin() const { return originX_ >= 0; }
+        int getOriginX() const { return originX_; }
+        int getOriginY() const { return originY_; }
         
         // Cell access
         Cell& getCell(int x, int y);
         const Cell& getCell(int x, int y) const;
+        BoardView view() const;
+        
+        // Position of a cell in the storage order
+        static constexpr int LAYOUT_TILE_SHIFT = 3; // 8x8 tiles
+        CellLayout getLayout() const { return layout_; }
+        size_t cellIndex(int x, int y) const {
+            if (layout_ == CellLayout::RowMajor) {
+                return static_cast<size_t>(y) * width_ + x;
+            }
+            size_t tile = static_cast<size_t>(y >> LAYOUT_TILE_SHIFT) * tilesPerRow_ + (x >> LAYOUT_TILE_SHIFT);
+            return (tile << (2 * LAYOUT_TILE_SHIFT)) |
+                   static_cast<size_t>((y & 7) << LAYOUT_TILE_SHIFT) | static_cast<size_t>(x & 7);
+        }
+        // Number of stored cells (tiled boards are padded to whole tiles)
+        size_t getStorageSize() const { return storageSize_; }
+        // Inverse of cellIndex() for cells inside the board
+        void cellPosition(size_t index, int& x, int& y) const;
         
         // Game actions
         bool revealCell(int x, int y);
         void toggleFlag(int x, int y);
+        // Chord: on a revealed number with as many flags around it, reveal
+        // every other hidden neighbor in one go (one merged trace, one dirty
+        // region). Returns true if one of them was a mine.
+        bool chordCell(int x, int y);
         
         // Game state checks
         bool checkWin() const;
@@ -31,18 +182,141 @@ namespace Minesweeper {
         int getWidth() const { return width_; }
         int getHeight() const { return height_; }
         int getMineCount() const { return mineCount_; }
-        int getFlagCount() const;
-        int getRevealedCount() const;
+        int getFlagCount() const { return flagCount_; }
+        int getRevealedCount() const { return revealedCount_; }
+        
+        // Openings: connected zero cells, found by initialize(). Revealing
+        // one also reveals the numbers around it. Boards over OPENINGS_MAX_CELLS (and
+        // reopened board files) skip them and reveal with the BFS.
+        bool hasOpenings() const { return openingsReady_; }
+        int getOpeningCount() const { return openingsReady_ ? static_cast<int>(openingStarts_.size()) - 1 : 0; }
+        size_t getOpeningSize(int opening) const { return openingStarts_[opening + 1] - openingStarts_[opening]; } // zero cells
+        
+        // 3BV and friends, all zero when the board has no openings. The
+        // solved count is the part of the 3BV cleared so far by revealCell().
+        const BoardMetrics& getMetrics() const { return metrics_; }
+        int getSolvedBBBV() const { return solvedBBBV_; }
+        
+        // Last reveal cascade (undo journal, solver, animations). The serial
+        // changes with every new cascade and on reset() (which empties the
+        // trace). Levels are only worked out while setRevealLevels(true),
+        // for the animation; they survive reset().
+        const RevealTrace& getLastReveal() const { return lastReveal_; }
+        std::uint64_t getRevealSerial() const { return revealSerial_; }
+        void setRevealLevels(bool enabled) { revealLevels_ = enabled; }
+        
+        // Cells changed since the last call (everything after reset())
+        const DirtyRegion& getDirtyRegion() const { return dirty_; }
+        DirtyRegion takeDirtyRegion();
+        
+        // Undo/redo (see MoveJournal): flip one stored cell without any
+        // cascade. Counters, solved 3BV and the dirty region follow;
+        // clearLastReveal() drops the animation of the last cascade.
+        void setCellRevealed(size_t index, bool revealed);
+        void toggleCellFlag(size_t index);
+        void clearLastReveal();
+        
+        // Saved games (SaveFile.hpp): one bit per stored cell, cell i in bit
+        // i % 64 of word i / 64. restorePlanes() validates the planes, then
+        // rebuilds counts and openings; it leaves the board alone on failure.
+        size_t getPlaneWordCount() const { return (storageSize_ + 63) / 64; }
+        void packPlanes(std::uint64_t* mines, std::uint64_t* revealed, std::uint64_t* flagged) const;
+        bool restorePlanes(const std::uint64_t* mines, const std::uint64_t* revealed,
+                           const std::uint64_t* flagged, bool initialized, std::uint64_t seed);
+        // Same for the revealed and flagged cells only, over the mines in
+        // place (replay keyframes): no count or opening is recomputed
+        bool restoreMarks(const std::uint64_t* revealed, const std::uint64_t* flagged);
         
     private:
+        friend class BoardView;
+        
+        Board(int width, int height, int mineCount, CellLayout layout,
+              std::unique_ptr<MappedFile> mapping);
+        
+        size_t cellCount() const { return static_cast<size_t>(width_) * height_; }
+        static size_t storageSizeFor(int width, int height, CellLayout layout);
+        void setupLayout(CellLayout layout);
+        void writeHeader();
+        void markAllDirty();
+        bool planeFitsBoard(const std::uint64_t* plane) const;
+        bool checkMarkPlanes(const std::uint64_t* revealed, const std::uint64_t* flagged,
+                             int& revealedTotal, int& flagTotal) const;
+        void unpackPlane(const std::uint64_t* plane, int shift);
+        void applyMarkPlanes(const std::uint64_t* revealed, const std::uint64_t* flagged,
+                             int revealedTotal, int flagTotal);
+        
+        // Generation works on bands of rows, in parallel on large boards
+        static constexpr int GENERATION_BAND_ROWS = 64;
+        static constexpr size_t PARALLEL_MIN_CELLS = 1 << 18;
+        
+        size_t bandCount() const;
+        template <typename Fn>
+        void forEachBand(size_t count, Fn&& fn);
+        
         void placeMines(int safeX, int safeY);
+        void placeMovedMines(const std::uint64_t* originMines, const BoardTransform& transform);
         void calculateAdjacentMines();
+        void countBandMines(size_t band);
+        // Reveal cascade (frontier of cell indices, one BFS level at a time)
+        static constexpr size_t PARALLEL_MIN_FRONTIER = 4096;
+        static constexpr size_t FRONTIER_CHUNK = 1024;
+        
+        bool revealSingle(int x, int y); // one cell and its cascade, true on a mine
         void revealEmptyCells(int x, int y);
+        void recordCascade();
+        template <typename Fn>
+        void forEachNeighbor(size_t index, Fn&& fn) const;
+        void expandFrontier(const std::vector<size_t>& frontier, std::vector<size_t>& next);
+        void expandFrontierParallel(const std::vector<size_t>& frontier, std::vector<size_t>& next);
+        
+        // Openings (BoardOpenings.cpp)
+        static constexpr size_t OPENINGS_MAX_CELLS = size_t(1) << 26;
+        static constexpr std::uint32_t NO_OPENING = 0xFFFFFFFF;
+        static constexpr std::uint32_t BORDERING_NUMBER = 0xFFFFFFFE; // number next to an opening
+        static bool isOpening(std::uint32_t id) { return id < BORDERING_NUMBER; }
+        
+        void computeOpenings();
+        void clearOpenings();
+        void revealOpening(std::uint32_t opening, int x, int y);
+        template <typename Fn>
+        void revealOpeningCells(std::uint32_t opening, Fn&& fn);
+        void countSolvedBBBV(size_t index, int delta);
         
         int width_;
         int height_;
         int mineCount_;
-        std::vector<std::vector<Cell>> cells_;
+        CellLayout layout_ = CellLayout::RowMajor;
+        size_t tilesPerRow_ = 0;
+        size_t storageSize_ = 0;
+        std::uint64_t seed_ = 0;
+        int originX_ = -1;
+        int originY_ = -1;
+        std::vector<Cell> ownedCells_;
+        std::unique_ptr<MappedFile> mapping_;
+        Cell* cells_ = nullptr; // storageSize_ cells in layout_ order, in ownedCells_ or mapping_
+        int flagCount_ = 0;
+        int revealedCount_ = 0;
         bool isInitialized_ = false;
+        
+        bool openingsReady_ = false;
+        // Per stored cell: the opening of a zero cell, BORDERING_NUMBER, or
+        // NO_OPENING (mines and isolated numbers)
+        std::vector<std::uint32_t> openingOf_;
+        std::vector<std::uint32_t> openingStarts_; // zero cells of opening i: openingCells_[starts[i] .. starts[i+1])
+        std::vector<std::uint32_t> openingCells_;
+        // A flag was put on one of the opening's zero cells: a BFS could then
+        // stop early, so the opening is no longer revealed in bulk
+        std::vector<std::uint8_t> openingBlocked_;
+        std::vector<std::uint32_t> openingRevealed_; // revealed zero cells; solved while > 0
+        BoardMetrics metrics_;
+        int solvedBBBV_ = 0;
+        
+        RevealTrace lastReveal_;
+        std::uint64_t revealSerial_ = 0;
+        bool revealLevels_ = false;
+        DirtyRegion dirty_;
+        
+        // One bit per cell, set while a parallel reveal level claims the cell
+        std::vector<std::atomic<std::uint64_t>> revealClaims_;
     };
 }
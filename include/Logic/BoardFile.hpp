@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+
+namespace Minesweeper {
+    // On-disk board format, mapped as-is by Board::openMapped().
+    //
+    //   offset 0            BoardFileHeader (64 bytes, little-endian)
+    //   offset headerSize   the cells, bitsPerCell bits each
+    //
+    // Cells are stored tile by tile: tiles of tileWidth x tileHeight cells
+    // in row-major order, cells inside a tile in row-major order. Tiles on the
+    // right and bottom edges are padded to full size. Board reads and writes
+    // two layouts: tiles as wide as the board and one row high (plain
+    // row-major order) and 8x8 tiles (CellLayout::Tiled).
+    //
+    // With 8 bits per cell each byte is a Cell (see Cell.hpp for the bits).
+    namespace BoardFile {
+        constexpr char MAGIC[8] = {'M', 'S', 'B', 'O', 'A', 'R', 'D', '\0'};
+        constexpr std::uint32_t VERSION = 1;
+        
+        // flags
+        constexpr std::uint8_t FLAG_INITIALIZED = 0x01; // mines are placed
+    }
+    
+    struct BoardFileHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t headerSize;    // offset of the first cell
+        std::uint32_t width;
+        std::uint32_t height;
+        std::uint32_t mineCount;
+        std::uint32_t flagCount;     // counters, updated on flush
+        std::uint32_t revealedCount;
+        std::uint32_t tileWidth;
+        std::uint32_t tileHeight;
+        std::uint8_t bitsPerCell;
+        std::uint8_t flags;
+        std::uint8_t reserved[18];   // zero
+    };
+    
+    static_assert(sizeof(BoardFileHeader) == 64, "BoardFileHeader layout is part of the file format");
+}
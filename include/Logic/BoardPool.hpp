@@ -0,0 +1,93 @@
+#pragma once
+#include "Logic/SpscQueue.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Minesweeper {
+    // A board made ahead of time: its seed, and its mines drawn for a first
+    // click at the origin (row-major bits, as Board::initialize() takes them)
+    struct PooledBoard {
+        std::uint64_t seed = 0;
+        int originX = 0;
+        int originY = 0;
+        std::vector<std::uint64_t> mines;
+    };
+
+    // Boards generated on a background thread, so that expensive modes
+    // (the no-guess search) stay off the first click. Ordinary boards are
+    // pooled as well; they cost next to nothing to keep ready.
+    //
+    // A board is drawn for a canonical first click (its origin) and moved
+    // to the real one by a BoardTransform, so each set of settings has a
+    // bounded lock-free queue per origin:
+    //  - ordinary boards only depend on the shape of the cells kept free
+    //    around the click (inside, edge, corner): one origin per shape,
+    //    reached by a symmetry or a cyclic translation, exactly as uniform
+    //    as a board drawn for the click;
+    //  - no-guess boards stay solvable under a symmetry of the board, not
+    //    under a translation: one origin per orbit of the symmetries (a
+    //    quarter of the cells, an eighth on square boards).
+    //
+    // The producer thread sleeps while every queue is full. take() is the
+    // queues' only consumer: call it, and addSettings(), from one thread
+    // (the game's).
+    class BoardPool {
+    public:
+        static constexpr size_t BOARDS_PER_QUEUE = 2;
+        static constexpr size_t MAX_QUEUES = 1024;
+
+        BoardPool();
+        ~BoardPool(); // stops the producer, cutting a no-guess search short
+        BoardPool(const BoardPool&) = delete;
+        BoardPool& operator=(const BoardPool&) = delete;
+
+        // Keeps boards of these settings ready from now on (starting the
+        // producer if needed); false when the pool has no queue left
+        bool addSettings(int width, int height, int mineCount, bool noGuess);
+
+        // A ready board of these settings for a first click at (x, y), in
+        // O(1); false when there is none, the board is then generated inline
+        bool take(int width, int height, int mineCount, bool noGuess, int x, int y,
+                  PooledBoard& board);
+
+    private:
+        struct Queue {
+            int width;
+            int height;
+            int mineCount;
+            bool noGuess;
+            int originX;
+            int originY;
+            SpscQueue<PooledBoard, BOARDS_PER_QUEUE> boards;
+        };
+
+        struct Settings {
+            int width;
+            int height;
+            int mineCount;
+            bool noGuess;
+            std::vector<std::uint32_t> queueOfCell; // row-major, into queues_
+        };
+
+        // Filled by addSettings() before the count is published, never
+        // moved nor removed: the producer reads them without locking
+        std::vector<std::unique_ptr<Queue>> queues_;
+        std::atomic<size_t> queueCount_{0};
+        std::vector<Settings> settings_; // game thread only
+
+        std::thread producer_;
+        std::atomic<bool> stopping_{false};
+        std::atomic<bool> wanted_{false}; // a board was taken, or queues added
+        std::mutex wakeMutex_;            // only for the producer's sleep
+        std::condition_variable wake_;
+
+        void wakeProducer();
+        void produce();
+    };
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include "Board.hpp"
+#include "Cell.hpp"
+
+namespace Minesweeper {
+    // Non-owning, read-only view of a Board.
+    // Meant to be taken once per frame by the renderer, input and UI so the
+    // per-cell loops touch plain pointers instead of shared_ptr copies.
+    // A view stays valid as long as the Board it was taken from is alive.
+    class BoardView {
+    public:
+        // Read-only row of cells. Contiguous for row-major boards; on tiled
+        // boards the row jumps from one 8x8 tile to the next every 8 cells.
+        class RowSpan {
+        public:
+            RowSpan(const Cell* data, int size, bool tiled)
+                : data_(data), size_(size), tiled_(tiled) {}
+
+            const Cell& operator[](int x) const {
+                return tiled_ ? data_[((x >> Board::LAYOUT_TILE_SHIFT) << (2 * Board::LAYOUT_TILE_SHIFT)) | (x & 7)]
+                              : data_[x];
+            }
+            int size() const { return size_; }
+
+        private:
+            const Cell* data_; // first cell of the row
+            int size_;
+            bool tiled_;
+        };
+
+        BoardView() = default;
+        explicit BoardView(const Board& board)
+            : board_(&board), cells_(board.cells_),
+              width_(board.width_), height_(board.height_) {}
+
+        bool isValid() const { return board_ != nullptr; }
+
+        // Cell access
+        RowSpan row(int y) const {
+            return RowSpan(cells_ + board_->cellIndex(0, y), width_,
+                           board_->getLayout() == CellLayout::Tiled);
+        }
+        const Cell& getCell(int x, int y) const { return cells_[board_->cellIndex(x, y)]; }
+        bool isCellValid(int x, int y) const {
+            return x >= 0 && x < width_ && y >= 0 && y < height_;
+        }
+        size_t cellIndex(int x, int y) const { return board_->cellIndex(x, y); }
+        size_t getStorageSize() const { return board_->getStorageSize(); }
+        void cellPosition(size_t index, int& x, int& y) const { board_->cellPosition(index, x, y); }
+
+        // Getters
+        int getWidth() const { return width_; }
+        int getHeight() const { return height_; }
+        int getMineCount() const { return board_->getMineCount(); }
+        int getFlagCount() const { return board_->getFlagCount(); }
+        int getRevealedCount() const { return board_->getRevealedCount(); }
+        const RevealTrace& getLastReveal() const { return board_->getLastReveal(); }
+        std::uint64_t getRevealSerial() const { return board_->getRevealSerial(); }
+        const BoardMetrics& getMetrics() const { return board_->getMetrics(); }
+        int getSolvedBBBV() const { return board_->getSolvedBBBV(); }
+
+    private:
+        const Board* board_ = nullptr;
+        const Cell* cells_ = nullptr;
+        int width_ = 0;
+        int height_ = 0;
+    };
+}
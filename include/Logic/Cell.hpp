@@ -1,21 +1,36 @@
 #pragma once
+#include <cstdint>
 
 namespace Minesweeper {
+    // A cell is packed in a single byte so boards stay compact in memory and
+    // can be mapped straight from a board file (see BoardFile.hpp):
+    //   bits 0-3  adjacent mine count (0-8)
+    //   bit  4    mine
+    //   bit  5    revealed
+    //   bit  6    flagged
+    //   bit  7    reserved, always 0
     class Cell {
     public:
+        static constexpr std::uint8_t ADJACENT_MASK = 0x0F;
+        static constexpr std::uint8_t MINE_BIT = 0x10;
+        static constexpr std::uint8_t REVEALED_BIT = 0x20;
+        static constexpr std::uint8_t FLAGGED_BIT = 0x40;
+        
         Cell();
         
         // Getters
-        bool hasMine() const { return hasMine_; }
-        bool isRevealed() const { return isRevealed_; }
-        bool isFlagged() const { return isFlagged_; }
-        int getAdjacentMines() const { return adjacentMines_; }
+        bool hasMine() const { return (bits_ & MINE_BIT) != 0; }
+        bool isRevealed() const { return (bits_ & REVEALED_BIT) != 0; }
+        bool isFlagged() const { return (bits_ & FLAGGED_BIT) != 0; }
+        int getAdjacentMines() const { return bits_ & ADJACENT_MASK; }
         
         // Setters
-        void setMine(bool hasMine) { hasMine_ = hasMine; }
-        void setRevealed(bool revealed) { isRevealed_ = revealed; }
-        void setFlagged(bool flagged) { isFlagged_ = flagged; }
-        void setAdjacentMines(int count) { adjacentMines_ = count; }
+        void setMine(bool hasMine) { setBit(MINE_BIT, hasMine); }
+        void setRevealed(bool revealed) { setBit(REVEALED_BIT, revealed); }
+        void setFlagged(bool flagged) { setBit(FLAGGED_BIT, flagged); }
+        void setAdjacentMines(int count) {
+            bits_ = static_cast<std::uint8_t>((bits_ & ~ADJACENT_MASK) | (count & ADJACENT_MASK));
+        }
         
         // Actions
         void toggleFlag();
@@ -23,9 +38,12 @@ namespace Minesweeper {
         void reset();
         
     private:
-        bool hasMine_ = false;
-        bool isRevealed_ = false;
-        bool isFlagged_ = false;
-        int adjacentMines_ = 0;
+        std::uint8_t bits_ = 0;
+        
+        void setBit(std::uint8_t bit, bool value) {
+            bits_ = static_cast<std::uint8_t>(value ? (bits_ | bit) : (bits_ & ~bit));
+        }
     };
+    
+    static_assert(sizeof(Cell) == 1, "Cell must stay one byte, it is stored as-is in board files");
 }
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "Cell.hpp"
+
+namespace Minesweeper {
+    // Unbounded board for the endless mode. Cells live in CHUNK_SIZE x
+    // CHUNK_SIZE chunks that are generated on first access. Mines come from a
+    // stateless hash of (seed, x, y), so a chunk can be dropped and rebuilt
+    // identically later; only chunks holding player state (revealed or
+    // flagged cells) are kept for good.
+    class ChunkedBoard {
+    public:
+        static constexpr int CHUNK_SIZE = 32;
+        
+        // Below this density openings may never end (percolation), so the
+        // requested density is clamped
+        static constexpr float MIN_MINE_DENSITY = 0.15f;
+        static constexpr float MAX_MINE_DENSITY = 0.5f;
+        
+        ChunkedBoard(std::uint64_t seed, float mineDensity);
+        
+        void reset(std::uint64_t seed);
+        
+        // Cell access (generates the chunk when needed)
+        const Cell& getCell(int x, int y);
+        
+        // Stateless queries, no chunk is generated
+        bool isMine(int x, int y) const;
+        int countAdjacentMines(int x, int y) const;
+        
+        // Game actions, same rules as Board
+        bool revealCell(int x, int y); // Returns true if a mine was hit
+        void toggleFlag(int x, int y);
+        
+        // Drops the chunks without player state farther than keepRadius
+        // chunks (Chebyshev distance) from the chunk containing (x, y)
+        void evictChunks(int x, int y, int keepRadius);
+        
+        std::uint64_t getSeed() const { return seed_; }
+        float getMineDensity() const { return mineDensity_; }
+        int getRevealedCount() const { return revealedCount_; }
+        int getFlagCount() const { return flagCount_; }
+        size_t getChunkCount() const { return chunks_.size(); }
+        
+    private:
+        struct Chunk {
+            std::vector<Cell> cells; // row-major, CHUNK_SIZE * CHUNK_SIZE
+            int revealed = 0;
+            int flagged = 0;
+            
+            bool hasPlayerState() const { return revealed > 0 || flagged > 0; }
+        };
+        
+        std::uint64_t seed_;
+        float mineDensity_;
+        std::uint64_t mineThreshold_; // hash < threshold => mine
+        std::unordered_map<std::uint64_t, std::unique_ptr<Chunk>> chunks_;
+        int revealedCount_ = 0;
+        int flagCount_ = 0;
+        
+        Chunk& getChunk(int chunkX, int chunkY);
+        Cell& cellAt(int x, int y, Chunk** owner = nullptr);
+        void generateChunk(Chunk& chunk, int chunkX, int chunkY) const;
+        void revealEmptyCells(int x, int y);
+        
+        static int chunkCoord(int v);
+        static int localCoord(int v);
+        static std::uint64_t chunkKey(int chunkX, int chunkY);
+        static std::uint64_t hashCell(std::uint64_t seed, int x, int y);
+    };
+}
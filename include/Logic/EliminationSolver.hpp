@@ -0,0 +1,52 @@
+#pragma once
+#include "Logic/Frontier.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Minesweeper {
+    class Solver;
+
+    // Second deduction engine, for what the Solver's local rules miss when
+    // several numbers overlap. The open constraints become a linear system
+    // over the frontier cells (0/1 unknowns), reduced by Gaussian
+    // elimination; every reduced row still holds for the real mines, and
+    // bound reasoning on it proves cells: a row sum(plus) - sum(minus) = b
+    // with b == |plus| puts mines on plus and none on minus, and the other
+    // way round for b == -|minus|. Cells proven are taken out of every row
+    // and the rows looked at again until nothing moves.
+    //
+    // Coefficients stay in {-1, 0, +1}, so a row is two bitsets packed in
+    // 64-bit words and a row operation is a few XOR/AND per word; an
+    // operation that would make a coefficient of 2 is skipped (the row
+    // stays true, only less reduced). Each frontier component is its own
+    // system; near the end of a game, every unknown cell and the mine
+    // count go into a single one.
+    //
+    // Run it after Solver::solve() and before the ProbabilityEngine: what
+    // it proves leaves the frontier the engine has to count.
+    class EliminationSolver {
+    public:
+        static constexpr size_t MAX_COMPONENT_CELLS = 4096; // larger components keep the local rules only
+        static constexpr size_t MAX_GLOBAL_CELLS = 256;     // unknowns for the mine count to join in
+
+        // Cells (y * width + x) proven safe or mines beyond the solver's own
+        // deductions; the solver must have been solved. False when the
+        // constraints admit no configuration (wrong trusted flags).
+        bool deduce(const Solver& solver, std::vector<std::uint32_t>& safe,
+                    std::vector<std::uint32_t>& mines);
+
+        // Solver::solve(), then the deductions fed back to the solver until
+        // neither finds more; false on a contradiction
+        bool solve(Solver& solver);
+
+    private:
+        Frontier frontier_;
+        std::vector<std::uint32_t> safe_;
+        std::vector<std::uint32_t> mines_;
+
+        bool deduceSystem(const std::vector<const Frontier::Component*>& parts,
+                          const std::vector<std::uint32_t>& interior, int minesLeft,
+                          std::vector<std::uint32_t>& safe, std::vector<std::uint32_t>& mines) const;
+    };
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Minesweeper {
+    class Solver;
+
+    // What the Solver couldn't settle, as a system: its variables are the
+    // frontier cells, each constraint asks for need mines among some of
+    // them. Variables sharing no constraint, directly or not, fall into
+    // separate components that can be worked on independently.
+    class Frontier {
+    public:
+        struct Constraint {
+            int need;
+            std::uint32_t first; // into the constraint variables
+            std::uint32_t count;
+        };
+
+        struct Component {
+            // Breadth-first from its least constrained variable, so that
+            // constraints close soon after they open
+            std::vector<std::uint32_t> variables;
+            std::vector<std::uint32_t> constraints;
+        };
+
+        // From the solver's current constraints (it must have been solved)
+        void build(const Solver& solver);
+
+        size_t getVariableCount() const { return cells_.size(); }
+        std::uint32_t getCell(std::uint32_t variable) const { return cells_[variable]; }
+        // Variable of a cell, -1 off the frontier
+        std::int32_t getVariable(std::uint32_t cell) const { return variableOf_[cell]; }
+        // Index of a variable in its component's order
+        std::uint32_t getPosition(std::uint32_t variable) const { return positionOf_[variable]; }
+
+        const std::vector<Constraint>& getConstraints() const { return constraints_; }
+        const std::uint32_t* getVariables(const Constraint& constraint) const {
+            return constraintVariables_.data() + constraint.first;
+        }
+        // Constraints of a variable: [constraintsBegin, constraintsEnd)
+        const std::uint32_t* constraintsBegin(std::uint32_t variable) const {
+            return variableConstraints_.data() + variableConstraintStarts_[variable];
+        }
+        const std::uint32_t* constraintsEnd(std::uint32_t variable) const {
+            return variableConstraints_.data() + variableConstraintStarts_[variable + 1];
+        }
+
+        const std::vector<Component>& getComponents() const { return components_; }
+
+    private:
+        std::vector<std::int32_t> variableOf_;   // per cell
+        std::vector<std::uint32_t> cells_;       // per variable
+        std::vector<std::uint32_t> positionOf_;  // per variable
+        std::vector<Constraint> constraints_;
+        std::vector<std::uint32_t> constraintVariables_;
+        std::vector<std::uint32_t> variableConstraintStarts_;
+        std::vector<std::uint32_t> variableConstraints_;
+        std::vector<Component> components_;
+
+        void collect(const Solver& solver);
+        void splitComponents();
+    };
+}
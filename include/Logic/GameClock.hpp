@@ -0,0 +1,31 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+namespace Minesweeper {
+    // Stopwatch for the game timer, based on std::chrono::steady_clock.
+    // Measures wall time between start() and stop() minus paused spans, so
+    // the result does not depend on the frame or simulation rate.
+    class GameClock {
+    public:
+        using Clock = std::chrono::steady_clock;
+        
+        void reset();
+        void start();
+        void stop();
+        void pause();
+        void resume();
+        void continueAfterStop(); // keeps counting from the time at stop()
+        // Saved games: start from an elapsed time, running or stopped
+        void restore(std::int64_t elapsedMilliseconds, bool running);
+        
+        bool isRunning() const { return running_ && !paused_; }
+        std::int64_t getElapsedMilliseconds() const;
+        
+    private:
+        Clock::time_point startTime_;
+        Clock::duration accumulated_ = Clock::duration::zero();
+        bool running_ = false;
+        bool paused_ = false;
+    };
+}
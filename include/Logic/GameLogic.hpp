@@ -1,37 +1,120 @@
 #pragma once
 #include <memory>
+#include <string>
 #include "Board.hpp"
+#include "BoardPool.hpp"
+#include "BoardView.hpp"
+#include "GameClock.hpp"
+#include "MoveJournal.hpp"
+#include "Replay.hpp"
+#include "SaveFile.hpp"
+#include "Solver.hpp"
 #include "../Game/Config.hpp"
 
 namespace Minesweeper {
     class GameLogic {
     public:
         GameLogic();
+        // The layout is the board's storage order (saved games keep it)
+        explicit GameLogic(const Config::DifficultySettings& settings,
+                           CellLayout layout = CellLayout::RowMajor);
+        
+        // Starts over on a board of another size, reusing its memory
+        bool resizeBoard(const Config::DifficultySettings& settings);
         
         // Game control
         void startNewGame();
+        void startNewGame(std::uint64_t seed); // same seed, same mines for the same first click
+        // The board of a replay: this seed and origin as they are, neither
+        // searched (no-guess) nor taken from the pool
+        void startReplayedGame(std::uint64_t seed, int originX = -1, int originY = -1);
         void handleLeftClick(int x, int y);
         void handleRightClick(int x, int y);
+        void handleChord(int x, int y); // middle click, or both buttons
+        
+        // No-guess mode: the first click picks a board that deduction alone
+        // clears (NoGuessGenerator), from seeds derived from the game's
+        void setNoGuess(bool noGuess) { noGuess_ = noGuess; }
+        bool isNoGuess() const { return noGuess_; }
+        // Boards made ahead of time, taken on the first click when one is
+        // ready for these settings and mode (BoardPool::addSettings)
+        void setBoardPool(std::shared_ptr<BoardPool> pool) { boardPool_ = std::move(pool); }
+        
+        // History (every move, including the one that ended the game).
+        // Move numbers are those of MoveJournal; the board stays mined when
+        // the first move is undone.
+        bool undo();
+        bool redo();
+        bool rewindTo(size_t moveNumber);
+        const MoveJournal& getJournal() const { return journal_; }
+        // Cells the history holds (MoveJournal); clears it
+        void setJournalCapacity(size_t cells) { journal_ = MoveJournal(cells); }
+        
+        // Saved games (format in SaveFile.hpp): one write, one read. The
+        // save must match this board's size, mine count and layout; the
+        // move history is not saved.
+        bool saveGame(const std::string& path) const;
+        bool loadGame(const std::string& path);
+        static bool readSaveHeader(const std::string& path, SaveFileHeader& header);
+        
+        // Every game is recorded as a Replay of the inputs that changed it.
+        // A game restored by loadGame() has no replay until the next one.
+        const Replay& getReplay() const { return replay_; }
+        bool hasReplay() const { return replayValid_; }
+        ReplayResult getReplayResult() const;
+        bool saveReplay(const std::string& path);
+        bool isRecordingReplay() const { return recordingReplay_; }
+        void setRecordingReplay(bool recording) { recordingReplay_ = recording; }
+        // Replay viewer: the board was set by ReplayTimeline, this sets the
+        // rest of what is displayed (the clock stays stopped)
+        void showReplayFrame(Config::GameState state, int clickCount, std::int64_t elapsedMilliseconds);
+        
+        // Deduction solver on this game's board, attached on first use and
+        // then kept up to date move by move (call solve() before reading it)
+        Solver& getSolver();
         
         // State checks
+        bool isInProgress() const; // first click done, not over yet
         bool isGameOver() const;
         bool isGameWon() const;
         Config::GameState getGameState() const { return gameState_; }
         
         // Getters
         std::shared_ptr<Board> getBoard() const { return board_; }
-        int getGameTime() const { return gameTime_; }
+        BoardView getBoardView() const { return board_->view(); }
+        DirtyRegion takeDirtyRegion() { return board_->takeDirtyRegion(); }
+        int getGameTime() const { return static_cast<int>(gameClock_.getElapsedMilliseconds() / 1000); }
+        std::int64_t getElapsedMilliseconds() const { return gameClock_.getElapsedMilliseconds(); }
+        
+        // Play statistics: clicks that changed the board, 3BV solved per
+        // second and 3BV solved per click (0 until something was solved)
+        int getClickCount() const { return clickCount_; }
+        double getBBBVPerSecond() const;
+        double getClickEfficiency() const;
         
-        // Update
-        void update(float deltaTime);
+        // Timer control (e.g. while the pause menu is open)
+        void pauseTimer() { gameClock_.pause(); }
+        void resumeTimer() { gameClock_.resume(); }
         
     private:
         std::shared_ptr<Board> board_;
         Config::GameState gameState_ = Config::GameState::PLAYING;
-        float elapsedTime_ = 0.0f;
-        int gameTime_ = 0;
+        GameClock gameClock_; // runs from the first click to the end of the game
         bool firstClick_ = true;
+        bool noGuess_ = false;
+        bool boardFixed_ = false; // startReplayedGame()
+        std::shared_ptr<BoardPool> boardPool_;
+        int clickCount_ = 0;
+        MoveJournal journal_;
+        Replay replay_;
+        bool replayValid_ = false;
+        bool recordingReplay_ = true;
+        Solver solver_;
         
         void checkGameState();
+        void recordMove(MoveJournal::MoveType type, int x, int y,
+                        std::uint64_t revealSerial, int revealedCount);
+        void recordReplayEvent(ReplayAction action, int x, int y);
+        void updateSolver(const MoveJournal::Move& move);
     };
 }
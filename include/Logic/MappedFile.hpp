@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+namespace Minesweeper {
+    // Read/write memory mapping of a whole file (mmap on POSIX,
+    // CreateFileMapping on Windows). Writes go to the page cache and reach
+    // the disk when the OS evicts the pages or on flush().
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+        
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        
+        // Maps an existing file with its current size
+        bool open(const std::string& path);
+        // Creates (or truncates) the file to size bytes and maps it
+        bool create(const std::string& path, size_t size);
+        void close();
+        
+        // Writes dirty pages back to the file, blocking until done
+        bool flush();
+        
+        bool isOpen() const { return data_ != nullptr; }
+        void* data() const { return data_; }
+        size_t size() const { return size_; }
+        
+    private:
+        void* data_ = nullptr;
+        size_t size_ = 0;
+#ifdef _WIN32
+        void* file_ = nullptr;    // HANDLE
+        void* mapping_ = nullptr; // HANDLE
+#else
+        int fd_ = -1;
+#endif
+        
+        bool map(const std::string& path, size_t size, bool create);
+    };
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace Minesweeper {
+    // Append-only history of board changes, for undo/redo and rewind.
+    // A move is an opcode plus the storage indices of the cells it changed
+    // (the whole cascade for a reveal), never a copy of the board. Indices
+    // live in one ring buffer: when it is full the oldest moves are dropped,
+    // so memory stays bounded whatever the board size.
+    class MoveJournal {
+    public:
+        enum class MoveType : std::uint8_t {
+            Reveal, // cells revealed
+            Flag,   // one cell flagged or unflagged
+            Chord   // cells revealed around a number
+        };
+
+        struct Move {
+            MoveType type;
+            std::uint8_t outcome;     // Config::GameState after the move
+            std::uint64_t firstCell;  // position in the ring, counted since clear()
+            std::uint32_t cellCount;
+        };
+
+        static constexpr size_t DEFAULT_CELL_CAPACITY = size_t(1) << 22; // 16 MB of indices
+
+        explicit MoveJournal(size_t cellCapacity = DEFAULT_CELL_CAPACITY);
+
+        void clear();
+
+        // Appends a move after the current one, dropping the redo moves.
+        // A move larger than the whole ring empties the journal instead.
+        void record(MoveType type, std::uint8_t outcome, const size_t* cells, size_t count);
+
+        // Moves the cursor; the returned move is the one to revert (undo)
+        // or to apply again (redo), nullptr when there is none
+        const Move* undo();
+        const Move* redo();
+        bool canUndo() const { return cursor_ > 0; }
+        bool canRedo() const { return cursor_ < moves_.size(); }
+
+        // Move numbers count from the start of the game: the current one is
+        // the number of moves played, the oldest one reachable by undo may
+        // be above 0 once the ring dropped moves
+        size_t getMoveNumber() const { return droppedMoves_ + cursor_; }
+        size_t getOldestMoveNumber() const { return droppedMoves_; }
+        size_t getLatestMoveNumber() const { return droppedMoves_ + moves_.size(); }
+        
+        // Move n turns move number n into n + 1; nullptr once dropped
+        const Move* getMove(size_t moveNumber) const;
+
+        template <typename Fn>
+        void forEachCell(const Move& move, Fn&& fn) const {
+            size_t position = static_cast<size_t>(move.firstCell % cells_.size());
+            for (std::uint32_t i = 0; i < move.cellCount; ++i) {
+                fn(cells_[position]);
+                if (++position == cells_.size()) {
+                    position = 0;
+                }
+            }
+        }
+
+    private:
+        std::vector<std::uint32_t> cells_; // ring of cell indices
+        std::uint64_t cellEnd_ = 0;        // ring positions in use: [first move's firstCell, cellEnd_)
+        std::deque<Move> moves_;
+        size_t cursor_ = 0;                // moves_[0 .. cursor_) are applied
+        size_t droppedMoves_ = 0;
+    };
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include "Logic/Parallel.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Minesweeper {
+    class Board;
+    class EliminationSolver;
+    class Solver;
+
+    // Boards that deduction alone clears from the first click ("no
+    // guessing"). The candidates are the ordinary boards of seeds derived
+    // from a base seed; each is played out by the solvers (Solver, then
+    // EliminationSolver with the mine count), revealing every cell proven
+    // safe, until it is cleared or nothing more can be proven.
+    //
+    // Candidates are evaluated speculatively on every core. The winner is
+    // the first cleared one in candidate order, not in time: the same base
+    // seed and first click always give the same board, whatever the number
+    // of threads (unless the time budget runs out). Its seed regenerates it
+    // through Board::initialize(), so saves and replays need nothing more.
+    class NoGuessGenerator {
+    public:
+        static constexpr size_t MAX_CANDIDATES = size_t(1) << 14;
+        // The first click waits on the search: past this, it gets an
+        // ordinary board rather than a longer freeze
+        static constexpr double BUDGET_MILLISECONDS = 100.0;
+
+        // Seed of the winning candidate; false when none was cleared within
+        // the limits (out of candidates or of time, or stop set), seed being
+        // then baseSeed (an ordinary board)
+        static bool findSeed(int width, int height, int mineCount, int firstX, int firstY,
+                             std::uint64_t baseSeed, std::uint64_t& seed,
+                             unsigned maxWorkers = Parallel::workerCount(),
+                             double budgetMilliseconds = BUDGET_MILLISECONDS,
+                             const std::atomic<bool>* stop = nullptr);
+
+        // Generates the board of this seed (board.getSeed() is replaced)
+        // and tells whether deduction clears it from the first click
+        static bool isSolvable(Board& board, std::uint64_t seed, int firstX, int firstY,
+                               Solver& solver, EliminationSolver& elimination);
+    };
+}
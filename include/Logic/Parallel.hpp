@@ -0,0 +1,54 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <type_traits>
+
+namespace Minesweeper {
+    namespace Parallel {
+        inline unsigned workerCount() {
+            return std::max(1u, std::thread::hardware_concurrency());
+        }
+        
+        namespace detail {
+            using Task = void (*)(void* context, unsigned worker, size_t i);
+            
+            // Runs task(context, worker, i) for every i on the persistent
+            // worker threads (Parallel.cpp), the calling thread being worker 0
+            void run(size_t count, unsigned workers, Task task, void* context);
+        }
+        
+        // Calls fn(worker, i) for every i in [0, count) from up to
+        // maxWorkers threads, worker in [0, maxWorkers) telling which thread
+        // runs the task (for per-thread scratch data). Tasks are handed out
+        // one at a time, so their results must not depend on which thread
+        // runs them or in which order. Runs inline when there is a single
+        // task or worker.
+        //
+        // The threads are started once and kept (as many as the largest
+        // maxWorkers asked for), so a call costs a wake-up, not a thread
+        // creation. One call uses them at a time: a call made while they
+        // are busy (from a task, or from another thread) runs inline.
+        template <typename Fn>
+        void forEachOnWorkers(size_t count, Fn&& fn, unsigned maxWorkers = workerCount()) {
+            unsigned workers = static_cast<unsigned>(std::min<size_t>(std::max(1u, maxWorkers), count));
+            if (workers <= 1) {
+                for (size_t i = 0; i < count; ++i) {
+                    fn(0u, i);
+                }
+                return;
+            }
+            
+            using Function = std::remove_reference_t<Fn>;
+            detail::run(count, workers, [](void* context, unsigned worker, size_t i) {
+                (*static_cast<Function*>(context))(worker, i);
+            }, const_cast<void*>(static_cast<const void*>(&fn)));
+        }
+        
+        // Same, for tasks that don't care about the worker: fn(i)
+        template <typename Fn>
+        void forEach(size_t count, Fn&& fn) {
+            forEachOnWorkers(count, [&fn](unsigned, size_t i) { fn(i); });
+        }
+    }
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include "Logic/Frontier.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Minesweeper {
+    class Solver;
+
+    // Mine probability of every cell, numbered like the Solver's
+    // (y * width + x): 0 for revealed or proven safe cells, 1 for proven
+    // mines
+    struct ProbabilityMap {
+        int width = 0;
+        int height = 0;
+        std::vector<float> mine;
+        float interior = 0.0f;       // any unknown cell away from the numbers
+        size_t componentCount = 0;
+        size_t approximatedCount = 0; // components given local estimates only
+        bool complete = false;       // every probability is exact
+
+        float at(int x, int y) const { return mine[static_cast<size_t>(y) * width + x]; }
+    };
+
+    // Exact mine probabilities for the cells the Solver couldn't settle.
+    //
+    // The unknown cells next to numbers (the frontier) split into
+    // components that share no constraint. Each component is counted on
+    // its own: its cells are taken one by one, and the configurations of
+    // the cells done so far are merged by what they leave to the open
+    // constraints, keeping one count per number of mines (a dynamic
+    // program over the enumeration, so equal sub-problems are counted
+    // once). A backward pass gives, for each cell, its configurations as
+    // a mine by total. The components are then combined, every frontier
+    // total weighted by the ways to put the remaining mines in the
+    // interior: C(interior cells, mines left).
+    //
+    // Components are counted in parallel when the frontier is large. A
+    // component too wide for the counting, or still running when the time
+    // budget runs out, gets local estimates (its constraints' densities).
+    // A frontier too large to combine exactly is combined as if the mine
+    // count were a density, which large interiors make nearly exact. Both
+    // mark the map incomplete.
+    class ProbabilityEngine {
+    public:
+        static constexpr double DEFAULT_BUDGET_MILLISECONDS = 8.0; // half a frame
+        static constexpr size_t MAX_OPEN_CONSTRAINTS = 32;  // per step of the counting
+        static constexpr size_t MAX_STATES = size_t(1) << 16; // per step as well
+        static constexpr size_t MAX_COMPONENT_CELLS = 960;  // counts stay below 2^960
+        static constexpr size_t PARALLEL_MIN_CELLS = 64;
+        static constexpr size_t MAX_COMBINE_WORK = size_t(1) << 23; // else density approximation
+
+        // The solver must have been solved; false when the board admits no
+        // configuration at all (wrong trusted flags), the map then holding
+        // estimates only
+        bool compute(const Solver& solver, ProbabilityMap& map,
+                     double budgetMilliseconds = DEFAULT_BUDGET_MILLISECONDS);
+
+    private:
+        struct Component {
+            const Frontier::Component* part;
+            // Configurations by number of mines, and per variable those
+            // where it is a mine: mineCounts[v * (size + 1) + mines]
+            std::vector<double> totals;
+            std::vector<double> mineCounts;
+            bool exact = false;
+        };
+
+        using Clock = std::chrono::steady_clock;
+
+        Frontier frontier_;
+        std::vector<Component> components_;
+
+        bool countComponent(Component& component, Clock::time_point deadline) const;
+        double estimate(std::uint32_t variable) const;
+        static bool tilt(const Component& component, double logOdds,
+                         std::vector<double>& totals, std::vector<double>* mineCounts);
+        static double findLogOdds(const std::vector<const Component*>& components, double minesLeft,
+                                  double interiorCount);
+        static bool combineExact(const std::vector<const Component*>& components, double minesLeft,
+                                 double interiorCount, double logOdds,
+                                 std::vector<double>& probability, double& interior);
+        static bool combineByDensity(const std::vector<const Component*>& components,
+                                     double interiorCount, double logOdds,
+                                     std::vector<double>& probability, double& interior);
+    };
+}
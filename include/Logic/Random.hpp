@@ -0,0 +1,36 @@
+#pragma once
+#include <cstdint>
+
+namespace Minesweeper {
+    // Deterministic random helpers. Unlike the std distributions their output
+    // is specified, and they use no libm function (only integer arithmetic
+    // and IEEE +, *, /, built without FMA contraction), so a seed gives the
+    // same board on every platform.
+    namespace Random {
+        // splitmix64 step, also used to derive independent stream seeds
+        std::uint64_t mix(std::uint64_t value);
+        
+        // Seed for stream `index` of a generator seeded with `seed`
+        std::uint64_t streamSeed(std::uint64_t seed, std::uint64_t index);
+        
+        // Fresh nondeterministic seed (std::random_device)
+        std::uint64_t makeSeed();
+        
+        // xoshiro256** generator
+        class Generator {
+        public:
+            explicit Generator(std::uint64_t seed);
+            
+            std::uint64_t next();
+            double uniform(); // [0, 1), 53 bits
+            
+        private:
+            std::uint64_t state_[4];
+        };
+        
+        // Number of successes when drawing `draws` items without replacement
+        // from `population` (< 2^32) items of which `successes` are successes
+        std::uint64_t hypergeometric(Generator& gen, std::uint64_t population,
+                                     std::uint64_t successes, std::uint64_t draws);
+    }
+}
@@ -0,0 +1,163 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Minesweeper {
+    class Board;
+
+    // Replay file format, compact enough to keep every game:
+    //
+    //   MAGIC (8 bytes), then unsigned LEB128 varints
+    //   version, width, height, mineCount, seed (8 bytes, little-endian)
+    //   origin (version 2): 0, or y * width + x + 1 for a board drawn for a
+    //           first click at (x, y) then moved (Board::setOrigin)
+    //   eventCount, eventBytes, then eventBytes bytes of events
+    //   result: gameState, elapsedMilliseconds, clickCount, revealedCount,
+    //           flagCount, boardHash (8 bytes, little-endian)
+    //
+    // An event is two varints: the game time since the previous event in
+    // milliseconds, then zigzag(cell - previous cell) << 3 | action, with
+    // cell = y * width + x. Undo and redo keep the previous cell. Clicks
+    // close to each other and to the previous one take 2 to 3 bytes.
+    namespace ReplayFile {
+        constexpr char MAGIC[8] = {'M', 'S', 'R', 'E', 'P', 'L', 'A', 'Y'};
+        constexpr std::uint32_t VERSION = 2;
+        constexpr std::uint32_t MIN_VERSION = 1; // no origin
+        constexpr const char* EXTENSION = ".msreplay";
+        // Largest board a replay may declare (2048x2048, about 45 MB to play
+        // back): files are untrusted, and playback allocates the board
+        constexpr std::uint64_t MAX_CELLS = std::uint64_t(1) << 22;
+    }
+
+    // Inputs given to GameLogic, only those that changed the game
+    enum class ReplayAction : std::uint8_t {
+        Reveal, // handleLeftClick
+        Flag,   // handleRightClick
+        Chord,  // handleChord
+        Undo,
+        Redo
+    };
+
+    struct ReplayEvent {
+        std::int64_t timeMilliseconds; // game clock
+        ReplayAction action;
+        int x;
+        int y;
+    };
+
+    // How the game stood when the replay was saved
+    struct ReplayResult {
+        std::uint8_t gameState = 0; // Config::GameState
+        std::uint64_t elapsedMilliseconds = 0;
+        std::uint32_t clickCount = 0;
+        std::uint32_t revealedCount = 0;
+        std::uint32_t flagCount = 0;
+        std::uint64_t boardHash = 0; // Replay::hashBoard()
+    };
+
+    // One game as an event stream: the board parameters and seed (the mines
+    // only depend on the seed and the first click), then the events, kept
+    // encoded as in the file. GameLogic records it, ReplayPlayer plays it.
+    class Replay {
+    public:
+        void begin(int width, int height, int mineCount, std::uint64_t seed);
+        void addEvent(ReplayAction action, int x, int y, std::int64_t timeMilliseconds);
+        void setResult(const ReplayResult& result) { result_ = result; }
+        // The seed may only be settled by the first click (no-guess and
+        // pooled boards), and so may the origin
+        void setSeed(std::uint64_t seed) { seed_ = seed; }
+        void setOrigin(int x, int y) { origin_ = static_cast<std::int64_t>(y) * width_ + x; }
+
+        int getWidth() const { return width_; }
+        int getHeight() const { return height_; }
+        int getMineCount() const { return mineCount_; }
+        std::uint64_t getSeed() const { return seed_; }
+        bool hasOrigin() const { return origin_ >= 0; }
+        int getOriginX() const { return static_cast<int>(origin_ % width_); }
+        int getOriginY() const { return static_cast<int>(origin_ / width_); }
+        size_t getEventCount() const { return eventCount_; }
+        std::int64_t getLastEventTime() const { return lastTime_; }
+        size_t getEncodedSize() const { return events_.size(); }
+        const ReplayResult& getResult() const { return result_; }
+
+        // Decodes the events in order; fn(const ReplayEvent&)
+        template <typename Fn>
+        void forEachEvent(Fn&& fn) const;
+        std::vector<ReplayEvent> decodeEvents() const;
+
+        bool save(const std::string& path) const;
+        bool load(const std::string& path); // checks every event fits the board
+
+        // Mines, revealed and flagged cells, in row-major order whatever the
+        // cell layout
+        static std::uint64_t hashBoard(const Board& board);
+
+    private:
+        int width_ = 0;
+        int height_ = 0;
+        int mineCount_ = 0;
+        std::uint64_t seed_ = 0;
+        std::int64_t origin_ = -1; // cell, -1 for none
+        std::vector<std::uint8_t> events_;
+        size_t eventCount_ = 0;
+        std::int64_t lastTime_ = 0;
+        std::int64_t lastCell_ = 0;
+        ReplayResult result_;
+
+        bool decode(const std::vector<std::uint8_t>& data, const std::string& path);
+    };
+
+    namespace ReplayCoding {
+        inline void putVarint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+            while (value >= 0x80) {
+                out.push_back(static_cast<std::uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<std::uint8_t>(value));
+        }
+
+        // False when the varint runs past end or over 64 bits
+        inline bool getVarint(const std::uint8_t*& data, const std::uint8_t* end, std::uint64_t& value) {
+            value = 0;
+            for (int shift = 0; shift < 64 && data != end; shift += 7) {
+                std::uint8_t byte = *data++;
+                value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        inline std::uint64_t zigzag(std::int64_t value) {
+            return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+        }
+
+        inline std::int64_t unzigzag(std::uint64_t value) {
+            return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+        }
+    }
+
+    template <typename Fn>
+    void Replay::forEachEvent(Fn&& fn) const {
+        // events_ was written by addEvent() or checked by load()
+        const std::uint8_t* data = events_.data();
+        const std::uint8_t* end = data + events_.size();
+        ReplayEvent event{0, ReplayAction::Reveal, 0, 0};
+        std::int64_t cell = 0;
+        std::uint64_t timeDelta, code;
+
+        for (size_t i = 0; i < eventCount_; ++i) {
+            ReplayCoding::getVarint(data, end, timeDelta);
+            ReplayCoding::getVarint(data, end, code);
+            cell += ReplayCoding::unzigzag(code >> 3);
+            event.timeMilliseconds += static_cast<std::int64_t>(timeDelta);
+            event.action = static_cast<ReplayAction>(code & 7);
+            event.x = static_cast<int>(cell % width_);
+            event.y = static_cast<int>(cell / width_);
+            fn(static_cast<const ReplayEvent&>(event));
+        }
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <string>
+#include "Replay.hpp"
+
+namespace Minesweeper {
+    class GameLogic;
+
+    // Headless playback: feeds a replay's events to GameLogic as fast as
+    // possible (no rendering, no waiting on timestamps) and checks the game
+    // ends the way the replay says. Used to reproduce bug reports and as a
+    // workload for performance runs over recorded games.
+    class ReplayPlayer {
+    public:
+        struct Report {
+            bool ok = false;
+            size_t eventsPlayed = 0;
+            size_t undoCount = 0; // undo and redo events
+            std::string error; // first problem found, empty when ok
+        };
+
+        // The game must be built for the replay's board size and mine count;
+        // it is restarted with the replay's seed. Every event must change
+        // the game (only those are recorded) and the final state, counters
+        // and board hash must match the recorded result. The recorded time
+        // can't be earlier than the last event, and equals it when that
+        // event ended the game. afterEvent, when
+        // set, sees the game after each event (ReplayTimeline uses it).
+        using EventCallback = std::function<void(size_t index, const ReplayEvent& event)>;
+        static Report play(const Replay& replay, GameLogic& game,
+                           const EventCallback& afterEvent = EventCallback());
+    };
+}
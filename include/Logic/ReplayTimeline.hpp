@@ -0,0 +1,87 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Replay.hpp"
+#include "../Game/Config.hpp"
+
+namespace Minesweeper {
+    class GameLogic;
+
+    // Seekable view of a replay, for the replay viewer. build() plays the
+    // replay once through a GameLogic and keeps, next to the events:
+    //  - per event, the cells it changed (read from the MoveJournal), so
+    //    the next position is one small step away;
+    //  - every keyframeInterval events, a keyframe: the revealed and flagged
+    //    planes of the board.
+    // seek() restores the nearest keyframe at or before the target and
+    // applies at most keyframeInterval - 1 steps, whatever the replay length.
+    // The interval grows with the board so keyframes stay within
+    // KEYFRAME_BUDGET_BYTES.
+    class ReplayTimeline {
+    public:
+        static constexpr size_t MIN_KEYFRAME_INTERVAL = 64;
+        static constexpr size_t KEYFRAME_BUDGET_BYTES = size_t(64) << 20;
+
+        // The game must be built for the replay's board; it is played from
+        // the replay's seed and left showing position 0
+        bool build(const Replay& replay, GameLogic& game, std::string& error);
+
+        size_t getEventCount() const { return steps_.size(); }
+        size_t getPosition() const { return position_; } // events applied
+        size_t getKeyframeInterval() const { return keyframeInterval_; }
+        size_t getKeyframeCount() const { return keyframes_.size(); }
+
+        // Game time of event i, and of the end of the game
+        std::int64_t getEventTime(size_t event) const { return steps_[event].time; }
+        std::int64_t getDuration() const { return duration_; }
+        // Number of events that happened at or before the given time
+        size_t positionAt(std::int64_t time) const;
+
+        // Shows the game after the given number of events. Playing forward
+        // by a few events just applies them; anything else starts from a
+        // keyframe.
+        void seek(size_t position);
+        // Same, with the clock showing the given time (between two events)
+        void seekTime(std::int64_t time);
+
+    private:
+        enum class StepKind : std::uint8_t {
+            Reveal,   // cells revealed
+            Hide,     // cells hidden again (undo of a reveal or a chord)
+            Flag,     // flags toggled
+            Keyframe  // too large for the journal: restore keyframes_[first]
+        };
+
+        struct Step {
+            std::int64_t time;
+            std::uint64_t first;      // into cells_ (or keyframes_)
+            std::uint32_t cellCount;
+            StepKind kind;
+            Config::GameState state;  // after the event
+            int clickCount;
+        };
+
+        struct Keyframe {
+            size_t position;
+            std::vector<std::uint64_t> revealed;
+            std::vector<std::uint64_t> flagged;
+        };
+
+        GameLogic* game_ = nullptr;
+        std::vector<Step> steps_;
+        std::vector<std::uint32_t> cells_;
+        std::vector<Keyframe> keyframes_; // by position
+        std::vector<std::uint64_t> scratch_;
+        size_t keyframeInterval_ = MIN_KEYFRAME_INTERVAL;
+        size_t position_ = 0;
+        std::int64_t duration_ = 0;
+
+        void addKeyframe(size_t position);
+        void restoreKeyframe(const Keyframe& keyframe);
+        void applyStep(const Step& step);
+        void moveTo(size_t position);
+        void showPosition(std::int64_t time);
+    };
+}
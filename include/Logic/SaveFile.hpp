@@ -0,0 +1,45 @@
+#pragma once
+#include <cstdint>
+
+namespace Minesweeper {
+    // Saved game format, written and read in one block by GameLogic.
+    //
+    //   offset 0            SaveFileHeader (96 bytes, little-endian)
+    //   offset headerSize   planeCount bit planes of planeWords 64-bit words
+    //
+    // A plane holds one bit per stored cell, in the board's storage order
+    // (tileWidth x tileHeight tiles as in BoardFile.hpp), cell i in bit
+    // i % 64 of word i / 64. Planes come in the order mines, revealed,
+    // flagged. Adjacent counts and openings are not saved, they are
+    // recomputed from the mines on load.
+    namespace SaveFile {
+        constexpr char MAGIC[8] = {'M', 'S', 'S', 'A', 'V', 'E', '\0', '\0'};
+        constexpr std::uint32_t VERSION = 1;
+        constexpr std::uint8_t PLANE_COUNT = 3;
+
+        // flags
+        constexpr std::uint8_t FLAG_INITIALIZED = 0x01; // mines are placed
+    }
+
+    struct SaveFileHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t headerSize;          // offset of the first plane
+        std::uint32_t width;
+        std::uint32_t height;
+        std::uint32_t mineCount;
+        std::uint32_t tileWidth;
+        std::uint32_t tileHeight;
+        std::uint32_t clickCount;
+        std::uint64_t seed;
+        std::uint64_t elapsedMilliseconds; // game timer
+        std::uint64_t planeWords;          // words per plane
+        std::uint64_t checksum;            // FNV-1a over the plane words
+        std::uint8_t gameState;            // Config::GameState
+        std::uint8_t flags;
+        std::uint8_t planeCount;
+        std::uint8_t reserved[21];         // zero
+    };
+
+    static_assert(sizeof(SaveFileHeader) == 96, "SaveFileHeader layout is part of the file format");
+}
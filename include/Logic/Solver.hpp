@@ -0,0 +1,135 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Minesweeper {
+    class Board;
+
+    // Deduction solver working from what the player sees: revealed numbers,
+    // and flags when they are trusted. Each revealed number is a constraint
+    // "need mines among these unknown neighbors"; solve() applies
+    //  - the single-cell rules: need == 0, or need == unknown count;
+    //  - the pair rules between overlapping constraints (subset, superset
+    //    and the bounds on their shared cells);
+    //  - the mine count, once every mine or every safe cell is known;
+    // and returns the cells that are certainly safe or certainly mines.
+    //
+    // Constraints and the frontier (unknown cells next to a number) follow
+    // the board through cellChanged(): only the constraints around a change
+    // are queued again, no move rescans the board. Hiding a cell (undo)
+    // can invalidate earlier deductions: the solver then rebuilds itself
+    // from the board at the next solve().
+    //
+    // Cells are numbered y * width + x, not in the board's storage order.
+    class Solver {
+    public:
+        // Flags are trusted as mines only on request: a misplaced flag would
+        // otherwise turn into wrong "safe" cells
+        explicit Solver(bool trustFlags = false) : trustFlags_(trustFlags) {}
+
+        // Reads the whole board; it must stay alive while attached
+        void attach(const Board& board);
+        bool isAttached() const { return board_ != nullptr; }
+        // Cell revealed, hidden or (un)flagged, by its storage index
+        void cellChanged(size_t storageIndex);
+        // The board changed in ways the solver wasn't told about
+        void invalidate() { stale_ = true; }
+
+        // Deduces everything the rules can; false when the visible board
+        // contradicts itself (only possible with wrong trusted flags)
+        bool solve();
+        // A deduction made outside these rules (EliminationSolver): the
+        // cell becomes known, its numbers are looked at again by solve()
+        void setDeduced(std::uint32_t cell, bool mine);
+
+        bool isKnownSafe(int x, int y) const { return (state_[cellAt(x, y)] & (SAFE | REVEALED)) == SAFE; }
+        bool isKnownMine(int x, int y) const { return (state_[cellAt(x, y)] & MINE) != 0; }
+        // Hidden cells known to be safe (revealed ones are dropped on the way)
+        const std::vector<std::uint32_t>& getSafeCells();
+        // Cells known to be mines, flagged or not
+        const std::vector<std::uint32_t>& getMineCells() const { return mines_; }
+
+        size_t getFrontierSize() const { return frontierSize_; }
+        size_t getUnknownCount() const { return cellCount_ - knownCount_; }
+        size_t getKnownMineCount() const { return knownMines_; }
+        int getMineCount() const { return mineCount_; }
+        bool isUnknown(std::uint32_t cell) const { return !(state_[cell] & (KNOWN | REVEALED)); }
+        bool isMine(std::uint32_t cell) const { return (state_[cell] & MINE) != 0; }
+        
+        // What solve() couldn't settle: fn(cell, need, unknownCells, count)
+        // for every revealed number with unknown neighbors left
+        template <typename Fn>
+        void forEachConstraint(Fn&& fn) const {
+            std::uint32_t cells[8];
+            for (size_t cell = 0; cell < cellCount_; ++cell) {
+                std::uint8_t unknown = unknown_[cell];
+                if (unknown == 0 || !(state_[cell] & REVEALED)) {
+                    continue;
+                }
+                int x = static_cast<int>(cell % width_);
+                int y = static_cast<int>(cell / width_);
+                int count = 0;
+                for (int k = 0; k < 8; ++k) {
+                    if (unknown & (1u << k)) {
+                        cells[count++] = static_cast<std::uint32_t>(cellAt(x + NEIGHBOR_DX[k], y + NEIGHBOR_DY[k]));
+                    }
+                }
+                fn(static_cast<std::uint32_t>(cell), static_cast<int>(need_[cell]), cells, count);
+            }
+        }
+        int getWidth() const { return width_; }
+        int getHeight() const { return height_; }
+
+    private:
+        // Neighbor k; the opposite direction is neighbor 7 - k
+        static constexpr int NEIGHBOR_DX[8] = {-1, 0, 1, -1, 1, -1, 0, 1};
+        static constexpr int NEIGHBOR_DY[8] = {-1, -1, -1, 0, 0, 1, 1, 1};
+        
+        // state_ bits
+        static constexpr std::uint8_t REVEALED = 0x01;
+        static constexpr std::uint8_t SAFE = 0x02;    // revealed, or proven safe
+        static constexpr std::uint8_t MINE = 0x04;    // proven (or trusted flag)
+        static constexpr std::uint8_t FLAGGED = 0x08; // last flag seen on the board
+        static constexpr std::uint8_t QUEUED = 0x10;  // constraint waiting in queue_
+        static constexpr std::uint8_t KNOWN = SAFE | MINE;
+
+        // Window of the pair rules: two constraints share cells only when
+        // their centers are at most 2 apart, so both fit a 7x7 frame
+        static constexpr int FRAME = 7;
+
+        const Board* board_ = nullptr;
+        bool trustFlags_;
+        bool stale_ = true;
+        bool contradiction_ = false;
+        int width_ = 0;
+        int height_ = 0;
+        int mineCount_ = 0;
+        size_t cellCount_ = 0;
+
+        std::vector<std::uint8_t> state_;
+        // Revealed numbers: unknown neighbors (bit k = neighbor k) and the
+        // mines still to place among them
+        std::vector<std::uint8_t> unknown_;
+        std::vector<std::int8_t> need_;
+        // Hidden cells: revealed neighbors, non-zero on the frontier
+        std::vector<std::uint8_t> touching_;
+        std::vector<std::uint32_t> queue_;
+        std::vector<std::uint32_t> safe_;
+        std::vector<std::uint32_t> mines_;
+        size_t knownCount_ = 0;
+        size_t knownMines_ = 0;
+        size_t frontierSize_ = 0;
+
+        size_t cellAt(int x, int y) const { return static_cast<size_t>(y) * width_ + x; }
+        void rebuild();
+        void reveal(std::uint32_t cell);
+        void setKnown(std::uint32_t cell, bool mine);
+        void enqueue(std::uint32_t cell);
+        bool applyCountRule(std::uint32_t cell);
+        bool applyPairRules(std::uint32_t cell);
+        bool applyMineCount();
+        std::uint64_t frameMask(std::uint32_t cell, int offsetX, int offsetY) const;
+        void setFrameKnown(std::uint32_t center, std::uint64_t frame, bool mine);
+    };
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace Minesweeper {
+    // Bounded lock-free queue for one producer thread and one consumer
+    // thread: a ring of Capacity slots, each side owning one index. push()
+    // and pop() never block and never allocate (T's move aside).
+    template <typename T, size_t Capacity>
+    class SpscQueue {
+    public:
+        // Producer side; false when full
+        bool push(T&& value) {
+            size_t tail = tail_.load(std::memory_order_relaxed);
+            size_t next = (tail + 1) % SLOTS;
+            if (next == head_.load(std::memory_order_acquire)) {
+                return false;
+            }
+            slots_[tail] = std::move(value);
+            tail_.store(next, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer side; false when empty
+        bool pop(T& value) {
+            size_t head = head_.load(std::memory_order_relaxed);
+            if (head == tail_.load(std::memory_order_acquire)) {
+                return false;
+            }
+            value = std::move(slots_[head]);
+            head_.store((head + 1) % SLOTS, std::memory_order_release);
+            return true;
+        }
+
+        // Either side; only a hint while the other one is running
+        size_t size() const {
+            size_t head = head_.load(std::memory_order_acquire);
+            size_t tail = tail_.load(std::memory_order_acquire);
+            return (tail + SLOTS - head) % SLOTS;
+        }
+        bool isFull() const { return size() == Capacity; }
+
+    private:
+        static constexpr size_t SLOTS = Capacity + 1; // one always empty: full and empty differ
+
+        std::array<T, SLOTS> slots_;
+        alignas(64) std::atomic<size_t> head_{0}; // next slot to pop
+        alignas(64) std::atomic<size_t> tail_{0}; // next slot to push
+    };
+}
@@ -0,0 +1,105 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "../Game/Config.hpp"
+
+namespace Minesweeper {
+    // Statistics database: every finished game is appended to a log, and a
+    // small index keeps what the menus ask for (games played and won, best
+    // times) so no query ever reads the log.
+    //
+    //   log:   StatsLogHeader, then one StatsRecord per game, never rewritten
+    //   index: StatsIndex, replaced as a whole (temporary file + rename)
+    //
+    // An append writes one record with its own checksum and syncs it before
+    // the index is touched. After a crash the log ends at its last complete,
+    // valid record (a torn one is overwritten by the next append) and an
+    // index behind the log catches up from the records it hasn't seen. A new
+    // log appears with its header (temporary file + rename); one shorter
+    // than a header holds no games and is created again.
+    namespace StatsFile {
+        constexpr char LOG_MAGIC[8] = {'M', 'S', 'S', 'T', 'L', 'O', 'G', '\0'};
+        constexpr char INDEX_MAGIC[8] = {'M', 'S', 'S', 'T', 'I', 'D', 'X', '\0'};
+        constexpr std::uint32_t VERSION = 1;
+        constexpr int DIFFICULTY_COUNT = 4; // Config::Difficulty values
+        constexpr int BEST_COUNT = 10;      // best times kept per difficulty
+    }
+
+    struct StatsLogHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t recordSize;
+    };
+
+    struct StatsRecord {
+        std::uint64_t timestamp;        // end of the game, seconds since 1970
+        std::uint32_t timeMilliseconds;
+        std::uint32_t bbbv;
+        std::uint32_t clicks;
+        std::uint8_t difficulty;        // Config::Difficulty
+        std::uint8_t result;            // Config::GameState, WON or LOST
+        std::uint8_t reserved[6];       // zero
+        std::uint32_t checksum;         // of the bytes above
+    };
+
+    struct StatsBestTime {
+        std::uint32_t timeMilliseconds;
+        std::uint32_t bbbv;
+        std::uint64_t record;           // position in the log
+    };
+
+    // Per difficulty; best[0 .. bestCount) sorted by time, then by record
+    struct StatsDifficulty {
+        std::uint64_t played;
+        std::uint64_t won;
+        std::uint32_t bestCount;
+        std::uint32_t reserved;
+        StatsBestTime best[StatsFile::BEST_COUNT];
+    };
+
+    struct StatsIndex {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t hasLastGame;
+        std::uint64_t logRecords;       // records of the log counted here
+        StatsRecord lastGame;
+        StatsDifficulty difficulties[StatsFile::DIFFICULTY_COUNT];
+        std::uint64_t checksum;         // of the bytes above
+    };
+
+    static_assert(sizeof(StatsLogHeader) == 16, "StatsLogHeader layout is part of the file format");
+    static_assert(sizeof(StatsRecord) == 32, "StatsRecord layout is part of the file format");
+
+    class StatsStore {
+    public:
+        StatsStore(std::string logPath, std::string indexPath);
+
+        // Reads the index and catches up with the log; false when the log
+        // exists but isn't a statistics log
+        bool open();
+
+        // Game over: one record at the end of the log, then the index
+        bool append(Config::Difficulty difficulty, Config::GameState result,
+                    std::int64_t timeMilliseconds, int bbbv, int clicks);
+
+        // Queries, from the index only
+        const StatsDifficulty& getDifficulty(Config::Difficulty difficulty) const;
+        double getWinRate(Config::Difficulty difficulty) const; // 0 to 1
+        bool getLastGame(StatsRecord& record) const;
+        std::uint64_t getRecordCount() const { return index_.logRecords; }
+
+    private:
+        std::string logPath_;
+        std::string indexPath_;
+        StatsIndex index_;
+
+        void resetIndex();
+        bool loadIndex();
+        bool saveIndex();
+        // Adds the log records the index hasn't counted yet; logRecords gets
+        // the number of valid records in the log
+        bool catchUp(std::uint64_t& logRecords);
+        void addToIndex(const StatsRecord& record, std::uint64_t position);
+    };
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "AssetManager.hpp"
+
+namespace Minesweeper {
+    // Fills an AssetManager without blocking the main loop.
+    // A worker thread decodes the font and generates every CPU-side image;
+    // the main thread calls uploadStep() once per frame to move finished
+    // images to the GPU (and render the font-based textures) within a budget.
+    class AssetLoader {
+    public:
+        explicit AssetLoader(std::shared_ptr<AssetManager> assetManager);
+        ~AssetLoader();
+        
+        AssetLoader(const AssetLoader&) = delete;
+        AssetLoader& operator=(const AssetLoader&) = delete;
+        
+        void start();
+        
+        // Main thread only: upload ready work until the budget is spent
+        // (always makes progress on at least one item)
+        void uploadStep(sf::Time budget);
+        
+        bool isFinished() const { return completed_ == total_; }
+        float getProgress() const;
+        
+    private:
+        std::shared_ptr<AssetManager> assetManager_;
+        std::vector<AssetManager::ImageJob> jobs_;
+        std::thread worker_;
+        std::atomic<bool> cancelled_{false};
+        
+        // Worker -> main thread hand-off: only pointers cross under the lock,
+        // the font object itself is never copied between threads
+        std::mutex mutex_;
+        std::deque<std::pair<std::string, sf::Image>> readyImages_;
+        std::unique_ptr<sf::Font> font_; // null when it could not be loaded
+        bool fontReady_ = false;
+        
+        // Main thread progress
+        bool fontUploaded_ = false;
+        int fontTexturesDone_ = 0;
+        int completed_ = 0;
+        int total_ = 0;
+        
+        void workerMain();
+    };
+}
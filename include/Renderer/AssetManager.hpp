@@ -1,43 +1,60 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <functional>
 #include <memory>
 #include <map>
+#include <string>
+#include <vector>
 #include "../Game/Config.hpp"
 
 namespace Minesweeper {
     class AssetManager {
     public:
+        // A CPU-only piece of work producing the image of a named texture
+        struct ImageJob {
+            std::string name;
+            std::function<sf::Image()> generate;
+        };
+        
+        // Textures that need the font are rendered on the main thread
+        static constexpr int FONT_TEXTURE_COUNT = 18; // numbers 1-8, digits 0-9
+        
         AssetManager();
         
-        // Asset loading
+        // Asset loading (synchronous; AssetLoader does the same work in the background)
         bool loadAssets();
+        void ensureLoaded();
+        bool isLoaded() const { return isLoaded_; }
+        void markLoaded() { isLoaded_ = true; }
+        
+        // Building blocks used by loadAssets() and AssetLoader
+        static std::vector<ImageJob> getImageJobs();
+        static bool loadFontFile(sf::Font& font);
+        // Main thread, before anything keeps a reference to getFont()
+        void setFont(std::unique_ptr<sf::Font> font);
+        bool hasFont() const { return hasFont_; }
+        bool uploadTexture(const std::string& name, const sf::Image& image);
+        void generateFontTexture(int index);
         
         // Resource access
         const sf::Texture& getTileTexture(bool hidden, bool flagged, bool revealed, bool hasMine, int adjacentMines);
         const sf::Texture& getFaceTexture(Config::GameState state);
-        const sf::Font& getFont() const { return font_; }
+        const sf::Texture& getTexture(const std::string& name);
+        const sf::Font& getFont() const { return *font_; }
         
         // Get color for numbers
         sf::Color getNumberColor(int number) const;
         
     private:
-        sf::Font font_;
+        std::unique_ptr<sf::Font> font_ = std::make_unique<sf::Font>();
+        bool hasFont_ = false;
+        bool isLoaded_ = false;
         
         // Generated textures
         std::map<std::string, sf::Texture> generatedTextures_;
         
-        void generateTileTextures();
-        void generateFaceTextures();
-        void generateDigitTextures();
-        void loadFont();
-        
-        // Helper methods
-        sf::Texture createHiddenTileTexture();
-        sf::Texture createRevealedTileTexture();
-        sf::Texture createMineTexture();
-        sf::Texture createFlagTexture();
+        // Helper methods (need the font, main thread only)
         sf::Texture createNumberTexture(int number);
-        sf::Texture createFaceTexture(const std::string& faceType);
         sf::Texture createDigitTexture(int digit);
     };
-}
\ No newline at end of file
+}
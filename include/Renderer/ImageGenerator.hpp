@@ -0,0 +1,35 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <string>
+
+namespace Minesweeper {
+    // CPU-side generation of the procedural artwork.
+    // Only touches sf::Image (no OpenGL), so it can run on a worker thread;
+    // the resulting images are uploaded to textures on the main thread.
+    class ImageGenerator {
+    public:
+        // Tiles
+        static sf::Image createHiddenTile(int size);
+        static sf::Image createRevealedTile(int size);
+        static sf::Image createMine(int size);
+        static sf::Image createFlag(int size);
+        
+        // Faces ("happy", "win", "lose")
+        static sf::Image createFace(const std::string& faceType);
+        
+        // Menu backgrounds
+        static sf::Image createMainMenuBackground(int width, int height, unsigned seed);
+        static sf::Image createDifficultyBackground(int width, int height);
+        
+    private:
+        // Raster helpers (alpha blended, clipped to the image)
+        static void blendPixel(sf::Image& image, int x, int y, const sf::Color& color);
+        static void fillRect(sf::Image& image, int x, int y, int width, int height, const sf::Color& color);
+        static void fillCircle(sf::Image& image, float cx, float cy, float radius, const sf::Color& color);
+        static void fillEllipseRing(sf::Image& image, float cx, float cy, float rx, float ry,
+                                    float thickness, const sf::Color& color);
+        static void fillTriangle(sf::Image& image, sf::Vector2f a, sf::Vector2f b, sf::Vector2f c,
+                                 const sf::Color& color);
+        static void drawLine(sf::Image& image, sf::Vector2f from, sf::Vector2f to, const sf::Color& color);
+    };
+}
@@ -4,34 +4,63 @@
 #include "../Game/Config.hpp"
 #include "../Logic/GameLogic.hpp"
 #include "AssetManager.hpp"
+#include "RevealScheduler.hpp"
 
 namespace Minesweeper {
     class Renderer {
     public:
         Renderer(std::shared_ptr<GameLogic> gameLogic, 
                 std::shared_ptr<AssetManager> assetManager);
+        ~Renderer(); // the board stops tracking reveal levels
+        Renderer(const Renderer&) = delete;
+        Renderer& operator=(const Renderer&) = delete;
         
         // Rendering
-        void render(sf::RenderWindow& window);
+        void update(float deltaTime); // reveal animation
+        // Fraction of a simulation step since update(): the next render()
+        // shows the reveal levels due at that time
+        void interpolate(float alpha);
+        void render(sf::RenderTarget& target);
         
         // UI Helpers
+        // Returns (-1, -1) when the point is outside the board
         sf::Vector2i screenToBoardPosition(int screenX, int screenY) const;
+        bool isOnFaceButton(int screenX, int screenY) const;
         
     private:
         std::shared_ptr<GameLogic> gameLogic_;
         std::shared_ptr<AssetManager> assetManager_;
         
-        // Rendering methods
-        void renderBoard(sf::RenderWindow& window);
-        void renderUI(sf::RenderWindow& window);
-        void renderCell(sf::RenderWindow& window, int x, int y);
-        void renderMineCounter(sf::RenderWindow& window);
-        void renderTimer(sf::RenderWindow& window);
-        void renderFaceButton(sf::RenderWindow& window);
-        void renderGameStatus(sf::RenderWindow& window);  // Nouvelle méthode
+        // Board layout: tiles shrink so larger difficulties fit the window
+        int tileSize_ = Config::TILE_SIZE;
+        sf::Vector2f boardOrigin_;
+        
+        RevealScheduler revealScheduler_;
+        float renderLead_ = 0.0f; // seconds past the last update()
+        
+        // Board drawn once into a texture; each frame only the board's dirty
+        // region and the cells the reveal animation released are redrawn
+        sf::RenderTexture boardLayer_;
+        bool boardLayerReady_ = false;
+        bool boardLayerFailed_ = false;
+        std::vector<size_t> releasedCells_; // storage indices
+        
+        void updateLayout();
+        sf::FloatRect getFaceButtonBounds() const;
+        void updateBoardLayer(const BoardView& board);
+        
+        // Rendering methods (the board view is taken once per frame in render())
+        void renderBoard(sf::RenderTarget& target, const BoardView& board);
+        void renderUI(sf::RenderTarget& target, const BoardView& board);
+        void renderCell(sf::RenderTarget& target, const Cell& cell, int x, int y,
+                        const sf::Vector2f& origin, bool gameOver, bool revealPending);
+        void renderMineCounter(sf::RenderTarget& target, const BoardView& board);
+        void renderTimer(sf::RenderTarget& target);
+        void renderFaceButton(sf::RenderTarget& target);
+        void renderGameStatus(sf::RenderTarget& target, const BoardView& board);  // Nouvelle méthode
         
         // Helper methods
-        void drawDigit(sf::RenderWindow& window, int digit, int x, int y);
-        void drawNumber(sf::RenderWindow& window, int number, int x, int y, int digitCount = 3);
+        void drawDigit(sf::RenderTarget& target, int digit, int x, int y);
+        void drawNumber(sf::RenderTarget& target, int number, int x, int y, int digitCount = 3);
     };
 }
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+#include <SFML/System.hpp>
+#include <cstdint>
+#include <vector>
+#include "../Logic/BoardView.hpp"
+
+namespace Minesweeper {
+    // Spreads the display of a reveal cascade over several frames. The board
+    // is already fully updated; cells of the cascade are only drawn hidden
+    // until their BFS level is released, under a per-frame time budget.
+    // The board's trace is read in place (it needs Board::setRevealLevels()),
+    // so a new cascade costs nothing up front: its cells are marked pending
+    // a budget at a time, and nothing of it should be drawn while
+    // isPreparing().
+    class RevealScheduler {
+    public:
+        // Picks up new cascades from the board and releases the next levels.
+        // Released cells are appended to `released` when given. `lead` also
+        // releases the levels due that many seconds later, without moving
+        // the clock (rendering between two simulation steps).
+        void update(const BoardView& board, float deltaTime,
+                    std::vector<size_t>* released = nullptr, float lead = 0.0f);
+        
+        bool isPreparing() const { return preparing_; }
+        bool isAnimating() const { return animating_; }
+        bool isPending(const BoardView& board, int x, int y) const {
+            if (!animating_ && !preparing_) return false;
+            size_t index = board.cellIndex(x, y);
+            return (pending_[index >> 6] >> (index & 63)) & 1;
+        }
+        
+    private:
+        static constexpr float LEVELS_PER_SECOND = 60.0f;
+        static constexpr float MAX_DURATION = 1.5f; // long cascades speed up
+        static constexpr int BUDGET_MICROSECONDS = 1500;
+        static constexpr size_t CELLS_PER_CLOCK_CHECK = 256;
+        
+        std::uint64_t serial_ = 0;
+        std::vector<std::uint64_t> pending_; // one bit per stored cell
+        bool preparing_ = false; // marking the cascade's cells pending
+        bool animating_ = false;
+        
+        size_t markedCell_ = 0; // next trace cell to mark pending
+        size_t nextCell_ = 0;   // next trace cell to release
+        float levelClock_ = 0.0f; // levels due so far
+        float levelsPerSecond_ = LEVELS_PER_SECOND;
+        
+        void start(const BoardView& board, std::vector<size_t>* released);
+    };
+}
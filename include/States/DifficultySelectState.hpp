@@ -11,20 +11,24 @@ namespace Minesweeper {
         
         void handleEvents(sf::RenderWindow& window) override;
         void update(float deltaTime) override;
-        void render(sf::RenderWindow& window) override;
+        void render(sf::RenderTarget& target) override;
         
         void onEnter() override;
         void onExit() override;
         
+        bool isPoolable() const override { return true; }
+        
     private:
         std::unique_ptr<Menu> menu_;
-        sf::Font font_;
-        sf::Texture backgroundTexture_;
+        const sf::Font& font_; // shared, owned by the AssetManager
         sf::Sprite backgroundSprite_;
         
         Config::Difficulty selectedDifficulty_ = Config::Difficulty::INTERMEDIATE;
+        bool noGuess_ = false;     // boards solvable without guessing
+        bool itemsChanged_ = false; // rebuilt in update(), not from an item's own action
         
         void initializeMenu();
+        void addItems();
         void createBackground();
         void startGame(Config::Difficulty difficulty, bool timed);
     };
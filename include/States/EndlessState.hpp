@@ -0,0 +1,43 @@
+#pragma once
+#include "StateWithManager.hpp"
+#include "../Logic/ChunkedBoard.hpp"
+#include "../Renderer/AssetManager.hpp"
+#include <memory>
+
+namespace Minesweeper {
+    // Endless mode: an unbounded ChunkedBoard explored with a scrolling camera
+    class EndlessState : public StateWithManager {
+    public:
+        EndlessState(sf::RenderWindow& window, StateManager& stateManager);
+        
+        void handleEvents(sf::RenderWindow& window) override;
+        void update(float deltaTime) override;
+        void interpolate(float alpha) override;
+        void render(sf::RenderTarget& target) override;
+        
+        void onEnter() override;
+        void onExit() override;
+        
+        bool isPoolable() const override { return true; }
+        
+    private:
+        static constexpr float MINE_DENSITY = 0.18f;
+        static constexpr float CAMERA_SPEED = 12.0f; // cells per second
+        static constexpr int KEEP_RADIUS = 2; // chunks kept around the camera
+        static constexpr float EVICT_INTERVAL = 1.0f; // seconds
+        
+        std::shared_ptr<AssetManager> assetManager_;
+        ChunkedBoard board_;
+        bool gameOver_ = false;
+        
+        // Camera = board coordinates of the top-left corner of the view
+        sf::Vector2f camera_;
+        sf::Vector2f previousCamera_;
+        sf::Vector2f renderCamera_;
+        float evictTimer_ = 0.0f;
+        
+        void startNewGame();
+        sf::Vector2i screenToBoardPosition(int screenX, int screenY) const;
+        void renderUI(sf::RenderTarget& target);
+    };
+}
@@ -8,9 +8,28 @@ namespace Minesweeper {
         
         virtual void handleEvents(sf::RenderWindow& window) = 0;
         virtual void update(float deltaTime) = 0;
-        virtual void render(sf::RenderWindow& window) = 0;
+        virtual void render(sf::RenderTarget& target) = 0;
         
+        // Called before render() with the fraction [0, 1) of a simulation
+        // step elapsed since the last update(), for smoothing animations
+        virtual void interpolate(float /*alpha*/) {}
+        
+        // Called when the state enters/leaves the stack. Pooled states are
+        // reused, so onEnter() must bring them back to a fresh state.
         virtual void onEnter() {}
         virtual void onExit() {}
+        
+        // Called when another state is pushed on top / popped off this one
+        virtual void onPause() {}
+        virtual void onResume() {}
+        
+        // Overlay states (pause menu...) are drawn on top of the state below
+        // them instead of replacing it. They must not clear the render target.
+        virtual bool isOverlay() const { return false; }
+        
+        // Poolable states are kept by the StateManager when they leave the
+        // stack and handed back by the next request for the same type/variant
+        virtual bool isPoolable() const { return false; }
+        virtual int getPoolVariant() const { return 0; }
     };
 }
@@ -10,14 +10,16 @@ namespace Minesweeper {
 
         void handleEvents(sf::RenderWindow& window) override;
         void update(float deltaTime) override;
-        void render(sf::RenderWindow& window) override;
+        void render(sf::RenderTarget& target) override;
 
         void onEnter() override;
         void onExit() override;
 
+        bool isPoolable() const override { return true; }
+
     private:
         std::unique_ptr<Menu> menu_;
-        sf::Font font_;
+        const sf::Font& font_; // shared, owned by the AssetManager
         sf::Text helpText_;
 
         void initializeMenu();
@@ -0,0 +1,29 @@
+#pragma once
+#include "StateWithManager.hpp"
+#include "../Renderer/AssetLoader.hpp"
+#include <memory>
+
+namespace Minesweeper {
+    // First state on the stack: keeps the window responsive while the
+    // AssetLoader fills the shared AssetManager, then opens the main menu.
+    class LoadingState : public StateWithManager {
+    public:
+        LoadingState(sf::RenderWindow& window, StateManager& stateManager);
+        
+        void handleEvents(sf::RenderWindow& window) override;
+        void update(float deltaTime) override;
+        void render(sf::RenderTarget& target) override;
+        
+        void onEnter() override;
+        void onExit() override;
+        
+    private:
+        // GPU upload budget per frame
+        static constexpr float UPLOAD_BUDGET_MS = 4.0f;
+        
+        std::shared_ptr<AssetManager> assetManager_;
+        AssetLoader loader_;
+        sf::RectangleShape barBackground_;
+        sf::RectangleShape barFill_;
+    };
+}
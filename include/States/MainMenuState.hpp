@@ -1,7 +1,9 @@
 #pragma once
 #include "StateWithManager.hpp"
 #include "../UI/Menu.hpp"
+#include "../Game/Config.hpp"
 #include <memory>
+#include <string>
 
 namespace Minesweeper {
     class MainMenuState : public StateWithManager {
@@ -10,18 +12,23 @@ namespace Minesweeper {
         
         void handleEvents(sf::RenderWindow& window) override;
         void update(float deltaTime) override;
-        void render(sf::RenderWindow& window) override;
+        void render(sf::RenderTarget& target) override;
         
         void onEnter() override;
         void onExit() override;
         
+        bool isPoolable() const override { return true; }
+        
     private:
         std::unique_ptr<Menu> menu_;
-        sf::Texture backgroundTexture_;
         sf::Sprite backgroundSprite_;
-        sf::Font font_;
+        const sf::Font& font_; // shared, owned by the AssetManager
+        std::string statsLine_;
         
         void initializeMenu();
         void createBackground();
+        bool findSavedGame(Config::Difficulty& difficulty) const;
+        void resumeSavedGame(Config::Difficulty difficulty);
+        void loadStats();
     };
 }
\ No newline at end of file
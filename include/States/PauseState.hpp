@@ -1,25 +1,35 @@
 #pragma once
 #include "StateWithManager.hpp"
 #include "../UI/Menu.hpp"
+#include "../Game/Config.hpp"
 #include <memory>
 
 namespace Minesweeper {
     class PauseState : public StateWithManager {
     public:
-        PauseState(sf::RenderWindow& window, StateManager& stateManager);
+        PauseState(sf::RenderWindow& window, StateManager& stateManager,
+                   Config::Difficulty difficulty = Config::Difficulty::INTERMEDIATE,
+                   bool noGuess = false);
         
         void handleEvents(sf::RenderWindow& window) override;
         void update(float deltaTime) override;
-        void render(sf::RenderWindow& window) override;
+        void render(sf::RenderTarget& target) override;
         
         void onEnter() override;
         void onExit() override;
         
+        bool isOverlay() const override { return true; }
+        bool isPoolable() const override { return true; }
+        int getPoolVariant() const override; // the game's
+        
     private:
+        Config::Difficulty difficulty_;
+        bool noGuess_;
         std::unique_ptr<Menu> menu_;
-        sf::Font font_;
+        const sf::Font& font_; // shared, owned by the AssetManager
         sf::RectangleShape overlay_;
         
         void initializeMenu();
+        void restartGame();
     };
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include "StateWithManager.hpp"
+#include "../Game/Config.hpp"
 #include "../Logic/GameLogic.hpp"
 #include "../Renderer/Renderer.hpp"
 #include "../Renderer/AssetManager.hpp"
@@ -10,22 +11,46 @@
 namespace Minesweeper {
     class PlayingState : public StateWithManager {
     public:
-        PlayingState(sf::RenderWindow& window, StateManager& stateManager);
+        PlayingState(sf::RenderWindow& window, StateManager& stateManager,
+                     Config::Difficulty difficulty = Config::Difficulty::INTERMEDIATE,
+                     bool noGuess = false);
         
         void handleEvents(sf::RenderWindow& window) override;
         void update(float deltaTime) override;
-        void render(sf::RenderWindow& window) override;
+        void interpolate(float alpha) override;
+        void render(sf::RenderTarget& target) override;
         
         void onEnter() override;
         void onExit() override;
+        void onPause() override;
+        void onResume() override;
+        
+        bool isPoolable() const override { return true; }
+        int getPoolVariant() const override { return poolVariant(difficulty_, noGuess_); }
+        // One pooled instance per difficulty and mode (no-guess or not)
+        static int poolVariant(Config::Difficulty difficulty, bool noGuess) {
+            return static_cast<int>(difficulty) | (noGuess ? NO_GUESS_VARIANT : 0);
+        }
+        
+        // Replaces the new game started by onEnter() with the autosave
+        bool resumeSavedGame();
         
     private:
+        static constexpr int NO_GUESS_VARIANT = 0x100;
+        
+        Config::Difficulty difficulty_;
+        bool noGuess_;
         std::shared_ptr<GameLogic> gameLogic_;
         std::shared_ptr<AssetManager> assetManager_;
         std::shared_ptr<Renderer> renderer_;
         std::shared_ptr<InputHandler> inputHandler_;
         std::shared_ptr<UIManager> uiManager_;
+        Config::GameState lastGameState_ = Config::GameState::PLAYING;
+        bool statsRecorded_ = false; // once per game, even if undone and finished again
         
         void initialize();
+        void autosave();
+        void saveReplay();
+        void recordStats(Config::GameState result);
     };
 }
\ No newline at end of file
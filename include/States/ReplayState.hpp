@@ -0,0 +1,48 @@
+#pragma once
+#include "StateWithManager.hpp"
+#include "../Game/Config.hpp"
+#include "../Logic/GameLogic.hpp"
+#include "../Logic/ReplayTimeline.hpp"
+#include "../Renderer/Renderer.hpp"
+#include <memory>
+#include <string>
+
+namespace Minesweeper {
+    // Replay viewer: plays a recorded game with pause, speed control and a
+    // timeline to scrub. Seeking goes through ReplayTimeline keyframes.
+    class ReplayState : public StateWithManager {
+    public:
+        ReplayState(sf::RenderWindow& window, StateManager& stateManager, const std::string& path);
+        
+        void handleEvents(sf::RenderWindow& window) override;
+        void update(float deltaTime) override;
+        void render(sf::RenderTarget& target) override;
+        
+        void onEnter() override;
+        void onExit() override;
+        
+        // Most recent replay in Config::REPLAY_DIRECTORY, empty when none
+        static std::string findLatestReplay();
+        
+    private:
+        static constexpr float MIN_SPEED = 0.25f;
+        static constexpr float MAX_SPEED = 16.0f;
+        static constexpr std::int64_t SEEK_STEP_MS = 5000;
+        
+        const sf::Font& font_; // shared, owned by the AssetManager
+        std::shared_ptr<GameLogic> gameLogic_;
+        std::shared_ptr<Renderer> renderer_;
+        ReplayTimeline timeline_;
+        std::string error_; // set when the replay can't be shown
+        
+        bool playing_ = true;
+        bool scrubbing_ = false;
+        float speed_ = 1.0f;
+        double time_ = 0.0; // game time shown, in milliseconds
+        sf::FloatRect barBounds_;
+        
+        void seekTo(double time);
+        void seekToMouse(int mouseX);
+        void renderTimeline(sf::RenderTarget& target);
+    };
+}
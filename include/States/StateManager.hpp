@@ -1,7 +1,12 @@
 #pragma once
 #include <memory>
-#include <stack>
+#include <vector>
+#include <map>
+#include <utility>
+#include <typeindex>
 #include "GameState.hpp"
+#include "../Renderer/AssetManager.hpp"
+#include "../Logic/BoardPool.hpp"
 
 namespace Minesweeper {
     class StateManager {
@@ -10,15 +15,61 @@ namespace Minesweeper {
         void popState();
         void changeState(std::unique_ptr<GameState> state);
         
+        // Pooled variants: reuse an idle instance of T for this variant
+        // (e.g. a difficulty) or construct one from args when none is idle
+        template <typename T, typename... Args>
+        void pushState(int variant, Args&&... args) {
+            pushState(acquireState<T>(variant, std::forward<Args>(args)...));
+        }
+        
+        template <typename T, typename... Args>
+        void changeState(int variant, Args&&... args) {
+            // Clear first so the outgoing instances are back in the pool
+            clearStates();
+            pushState(acquireState<T>(variant, std::forward<Args>(args)...));
+        }
+        
         GameState* getCurrentState();
         
         void handleEvents(sf::RenderWindow& window);
         void update(float deltaTime);
-        void render(sf::RenderWindow& window);
+        void render(sf::RenderWindow& window, float alpha = 0.0f);
         
         bool isEmpty() const { return states_.empty(); }
         
+        // Fonts and textures shared by every state (filled by LoadingState)
+        std::shared_ptr<AssetManager> getAssetManager() const { return assetManager_; }
+        // Boards generated in the background, shared by every game
+        std::shared_ptr<BoardPool> getBoardPool() const { return boardPool_; }
+        
     private:
-        std::stack<std::unique_ptr<GameState>> states_;
+        using PoolKey = std::pair<std::type_index, int>;
+        
+        std::vector<std::unique_ptr<GameState>> states_;
+        std::map<PoolKey, std::unique_ptr<GameState>> pool_;
+        std::shared_ptr<AssetManager> assetManager_ = std::make_shared<AssetManager>();
+        std::shared_ptr<BoardPool> boardPool_ = std::make_shared<BoardPool>();
+        
+        // Layers below an overlay are rendered once into this texture when
+        // the overlay is pushed, then blitted every frame until it pops.
+        sf::RenderTexture snapshot_;
+        sf::Sprite snapshotSprite_;
+        bool snapshotValid_ = false;
+        
+        template <typename T, typename... Args>
+        std::unique_ptr<GameState> acquireState(int variant, Args&&... args) {
+            auto it = pool_.find(PoolKey(std::type_index(typeid(T)), variant));
+            if (it != pool_.end()) {
+                std::unique_ptr<GameState> state = std::move(it->second);
+                pool_.erase(it);
+                return state;
+            }
+            return std::make_unique<T>(std::forward<Args>(args)...);
+        }
+        
+        void clearStates();
+        void releaseTop();
+        void captureSnapshot(const sf::Vector2u& size);
+        void renderLayers(sf::RenderTarget& target, size_t top);
     };
 }
@@ -22,7 +22,7 @@ namespace Minesweeper {
         void update(const sf::Vector2i& mousePosition);
         
         // Rendering
-        void draw(sf::RenderWindow& window) const;
+        void draw(sf::RenderTarget& target) const;
         
         // State
         bool isMouseOver() const { return isMouseOver_; }
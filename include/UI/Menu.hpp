@@ -36,6 +36,7 @@ namespace Minesweeper {
         void handleEvent(const sf::Event& event);
         void update();
         void render();
+        void render(sf::RenderTarget& target);
 
         // Utility
         // Return the y-coordinate (in window space) of the bottom of the menu items area
@@ -50,7 +51,7 @@ namespace Minesweeper {
         
     private:
         sf::RenderWindow& window_;
-        sf::Font font_;
+        const sf::Font* font_ = nullptr; // provided by the owning state
         sf::Text title_;
         std::vector<MenuItem> items_;
         
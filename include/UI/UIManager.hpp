@@ -27,7 +27,7 @@ namespace Minesweeper {
         Button newGameButton_;
         
         void setupUI();
-        void renderGameInfo(sf::RenderWindow& window);
+        void renderGameInfo(sf::RenderWindow& window, const BoardView& board);
         void renderFaceButton(sf::RenderWindow& window);
     };
 }
@@ -1,5 +1,6 @@
 #include "Game/Game.hpp"
-#include "States/MainMenuState.hpp"
+#include "States/LoadingState.hpp"
+#include <chrono>
 #include <iostream>
 
 namespace Minesweeper {
@@ -15,24 +16,51 @@ namespace Minesweeper {
     void Game::initializeWindow() {
         window_.create(sf::VideoMode(Config::WINDOW_WIDTH, Config::WINDOW_HEIGHT), 
                       "Minesweeper", sf::Style::Titlebar | sf::Style::Close);
-        window_.setFramerateLimit(60);
+        if (Config::VSYNC_ENABLED) {
+            window_.setVerticalSyncEnabled(true);
+        } else {
+            window_.setFramerateLimit(Config::FRAMERATE_LIMIT);
+        }
     }
 
     void Game::initializeStates() {
-        // Start with main menu - passe les 2 arguments requis
-        auto mainMenuState = std::make_unique<MainMenuState>(window_, stateManager_);
-        stateManager_.pushState(std::move(mainMenuState));
+        // Load assets in the background, the main menu follows
+        stateManager_.pushState(std::make_unique<LoadingState>(window_, stateManager_));
     }
 
     void Game::run() {
-        sf::Clock frameClock;
+        using Clock = std::chrono::steady_clock;
+        
+        // Fixed simulation step, independent of the display rate
+        const Clock::duration step = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / Config::SIMULATION_RATE));
+        const float stepSeconds = 1.0f / Config::SIMULATION_RATE;
+        
+        Clock::time_point previous = Clock::now();
+        Clock::duration accumulator = Clock::duration::zero();
         
         while (window_.isOpen() && !stateManager_.isEmpty()) {
-            float deltaTime = frameClock.restart().asSeconds();
+            Clock::time_point now = Clock::now();
+            accumulator += now - previous;
+            previous = now;
             
             processEvents();
-            update(deltaTime);
-            render();
+            
+            int steps = 0;
+            while (accumulator >= step && steps < Config::MAX_STEPS_PER_FRAME) {
+                update(stepSeconds);
+                accumulator -= step;
+                ++steps;
+            }
+            
+            // Long stall (window drag, breakpoint...): don't try to catch up
+            if (accumulator >= step) {
+                accumulator = Clock::duration::zero();
+            }
+            
+            float alpha = std::chrono::duration<float>(accumulator) /
+                          std::chrono::duration<float>(step);
+            render(alpha);
         }
     }
 
@@ -44,9 +72,9 @@ namespace Minesweeper {
         stateManager_.update(deltaTime);
     }
 
-    void Game::render() {
+    void Game::render(float alpha) {
         window_.clear(sf::Color(Config::BACKGROUND_COLOR));
-        stateManager_.render(window_);
+        stateManager_.render(window_, alpha);
         window_.display();
     }
 }
\ No newline at end of file
@@ -16,43 +16,48 @@ namespace Minesweeper {
             handleKeyboardEvents(event);
         }
         
-        handleMouseEvents(window);
+        handleMouseEvents(gameLogic_->getBoardView());
     }
 
     void InputHandler::reset() {
         // Reset mouse handler state if needed
     }
 
-    void InputHandler::handleMouseEvents(sf::RenderWindow& window) {
+    void InputHandler::handleMouseEvents(const BoardView& board) {
         if (mouseHandler_.isLeftClicked()) {
             sf::Vector2i mousePos = mouseHandler_.getPosition();
             
             // Check if click is in UI area
             if (mousePos.y < Config::UI_HEIGHT) {
                 // Check if face button was clicked
-                float faceX = (Config::WINDOW_WIDTH - 70) / 2.0f;
-                float faceY = (Config::UI_HEIGHT - 70) / 2.0f + 10; // Ajusté selon le renderer
-                
-                if (mousePos.x >= faceX && mousePos.x <= faceX + 70 &&
-                    mousePos.y >= faceY && mousePos.y <= faceY + 70) {
+                if (renderer_->isOnFaceButton(mousePos.x, mousePos.y)) {
                     gameLogic_->startNewGame();
                     return;
                 }
             } else {
                 // Click is on game board
-                sf::Vector2i boardPos = mouseHandler_.getBoardPosition(window);
-                if (boardPos.x >= 0 && boardPos.y >= 0) {
+                sf::Vector2i boardPos = renderer_->screenToBoardPosition(mousePos.x, mousePos.y);
+                if (board.isCellValid(boardPos.x, boardPos.y)) {
                     gameLogic_->handleLeftClick(boardPos.x, boardPos.y);
                 }
             }
         }
         
         if (mouseHandler_.isRightClicked()) {
-            sf::Vector2i boardPos = mouseHandler_.getBoardPosition(window);
-            if (boardPos.x >= 0 && boardPos.y >= 0) {
+            sf::Vector2i mousePos = mouseHandler_.getPosition();
+            sf::Vector2i boardPos = renderer_->screenToBoardPosition(mousePos.x, mousePos.y);
+            if (board.isCellValid(boardPos.x, boardPos.y)) {
                 gameLogic_->handleRightClick(boardPos.x, boardPos.y);
             }
         }
+        
+        if (mouseHandler_.isChordClicked()) {
+            sf::Vector2i mousePos = mouseHandler_.getPosition();
+            sf::Vector2i boardPos = renderer_->screenToBoardPosition(mousePos.x, mousePos.y);
+            if (board.isCellValid(boardPos.x, boardPos.y)) {
+                gameLogic_->handleChord(boardPos.x, boardPos.y);
+            }
+        }
     }
 
     void InputHandler::handleKeyboardEvents(const sf::Event& event) {
@@ -63,6 +68,18 @@ namespace Minesweeper {
                     gameLogic_->startNewGame();
                     break;
                     
+                case sf::Keyboard::Z:
+                    if (event.key.control) {
+                        gameLogic_->undo();
+                    }
+                    break;
+                    
+                case sf::Keyboard::Y:
+                    if (event.key.control) {
+                        gameLogic_->redo();
+                    }
+                    break;
+                    
                 case sf::Keyboard::Escape:
                     // Could implement pause menu here
                     break;
@@ -10,11 +10,19 @@ namespace Minesweeper {
         // Update button states
         bool leftPressed = sf::Mouse::isButtonPressed(sf::Mouse::Left);
         bool rightPressed = sf::Mouse::isButtonPressed(sf::Mouse::Right);
+        bool middlePressed = sf::Mouse::isButtonPressed(sf::Mouse::Middle);
         
         // Detect clicks (pressed this frame but not last frame)
         leftClicked_ = leftPressed && !wasLeftPressed_;
         rightClicked_ = rightPressed && !wasRightPressed_;
         
+        chordClicked_ = (middlePressed && !wasMiddlePressed_) ||
+                        (leftPressed && rightPressed && (leftClicked_ || rightClicked_));
+        if (chordClicked_) {
+            leftClicked_ = false;
+            rightClicked_ = false;
+        }
+        
         // Update continuous press states
         leftPressed_ = leftPressed;
         rightPressed_ = rightPressed;
@@ -22,19 +30,6 @@ namespace Minesweeper {
         // Store previous states
         wasLeftPressed_ = leftPressed;
         wasRightPressed_ = rightPressed;
-    }
-
-    sf::Vector2i MouseHandler::getBoardPosition(const sf::Window& window) const {
-        sf::Vector2i windowPos = mousePosition_;
-        
-        // Adjust for UI area
-        if (windowPos.y < Config::UI_HEIGHT) {
-            return sf::Vector2i(-1, -1); // Clicked in UI area
-        }
-        
-        int boardX = windowPos.x / Config::TILE_SIZE;
-        int boardY = (windowPos.y - Config::UI_HEIGHT) / Config::TILE_SIZE;
-        
-        return sf::Vector2i(boardX, boardY);
+        wasMiddlePressed_ = middlePressed;
     }
 }
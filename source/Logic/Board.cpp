@@ -1,102 +1,438 @@
 #include "../../include/Logic/Board.hpp"
-#include <random>
-#include <queue>
+#include "../../include/Logic/BoardView.hpp"
+#include "../../include/Logic/Bits.hpp"
+#include "../../include/Logic/BoardFile.hpp"
+#include "../../include/Logic/Parallel.hpp"
+#include "../../include/Logic/Random.hpp"
+#include <cstdlib>
+#include <cstring>
 #include <utility>
 #include <iostream>
 
 namespace Minesweeper {
-    Board::Board(int width, int height, int mineCount) 
+    Board::Board(int width, int height, int mineCount, CellLayout layout) 
         : width_(width), height_(height), mineCount_(mineCount) {
-        cells_.resize(height_, std::vector<Cell>(width_));
+        setupLayout(layout);
+        ownedCells_.resize(storageSize_);
+        cells_ = ownedCells_.data();
         reset();
     }
 
+    Board::Board(int width, int height, int mineCount, CellLayout layout,
+                 std::unique_ptr<MappedFile> mapping)
+        : width_(width), height_(height), mineCount_(mineCount), mapping_(std::move(mapping)) {
+        setupLayout(layout);
+        seed_ = Random::makeSeed();
+        cells_ = reinterpret_cast<Cell*>(static_cast<char*>(mapping_->data()) + sizeof(BoardFileHeader));
+        markAllDirty();
+    }
+
+    bool Board::resize(int width, int height, int mineCount) {
+        if (mapping_) {
+            std::cerr << "A memory-mapped board can't be resized" << std::endl;
+            return false;
+        }
+        
+        width_ = width;
+        height_ = height;
+        mineCount_ = mineCount;
+        setupLayout(layout_);
+        ownedCells_.resize(storageSize_); // never gives memory back
+        cells_ = ownedCells_.data();
+        reset(seed_); // the caller starts its next game with a seed of its own
+        return true;
+    }
+
+    size_t Board::storageSizeFor(int width, int height, CellLayout layout) {
+        if (layout == CellLayout::Tiled) {
+            const size_t tile = size_t(1) << LAYOUT_TILE_SHIFT;
+            return (static_cast<size_t>(width) + tile - 1) / tile * tile *
+                   ((static_cast<size_t>(height) + tile - 1) / tile * tile);
+        }
+        return static_cast<size_t>(width) * height;
+    }
+
+    void Board::setupLayout(CellLayout layout) {
+        layout_ = layout;
+        tilesPerRow_ = layout_ == CellLayout::Tiled
+            ? (static_cast<size_t>(width_) + 7) >> LAYOUT_TILE_SHIFT
+            : 0;
+        storageSize_ = storageSizeFor(width_, height_, layout_);
+    }
+
+    void Board::cellPosition(size_t index, int& x, int& y) const {
+        if (layout_ == CellLayout::RowMajor) {
+            x = static_cast<int>(index % width_);
+            y = static_cast<int>(index / width_);
+            return;
+        }
+        size_t tile = index >> (2 * LAYOUT_TILE_SHIFT);
+        int inTile = static_cast<int>(index & 63);
+        x = static_cast<int>(tile % tilesPerRow_) * 8 + (inTile & 7);
+        y = static_cast<int>(tile / tilesPerRow_) * 8 + (inTile >> LAYOUT_TILE_SHIFT);
+    }
+
+    Board::~Board() {
+        if (mapping_) {
+            writeHeader(); // dirty pages are written back by the OS on unmap
+        }
+    }
+
+    std::unique_ptr<Board> Board::createMapped(const std::string& path, int width,
+                                               int height, int mineCount, CellLayout layout) {
+        if (width <= 0 || height <= 0 || mineCount < 0 ||
+            static_cast<size_t>(width) > MAX_CELLS / static_cast<size_t>(height) ||
+            storageSizeFor(width, height, layout) > MAX_CELLS ||
+            static_cast<size_t>(mineCount) > static_cast<size_t>(width) * height) {
+            std::cerr << path << ": " << width << "x" << height << " boards with " << mineCount
+                      << " mines can't be mapped" << std::endl;
+            return nullptr;
+        }
+        
+        auto mapping = std::make_unique<MappedFile>();
+        if (!mapping->create(path, sizeof(BoardFileHeader) + storageSizeFor(width, height, layout))) {
+            return nullptr;
+        }
+        
+        // New file pages read as zeros, which is an empty Cell
+        std::unique_ptr<Board> board(new Board(width, height, mineCount, layout, std::move(mapping)));
+        board->writeHeader();
+        return board;
+    }
+
+    std::unique_ptr<Board> Board::openMapped(const std::string& path) {
+        auto mapping = std::make_unique<MappedFile>();
+        if (!mapping->open(path)) {
+            return nullptr;
+        }
+        
+        if (mapping->size() < sizeof(BoardFileHeader)) {
+            std::cerr << path << ": not a board file" << std::endl;
+            return nullptr;
+        }
+        
+        BoardFileHeader header;
+        std::memcpy(&header, mapping->data(), sizeof(header));
+        
+        if (std::memcmp(header.magic, BoardFile::MAGIC, sizeof(header.magic)) != 0 ||
+            header.version != BoardFile::VERSION ||
+            header.headerSize != sizeof(BoardFileHeader) ||
+            header.bitsPerCell != 8) {
+            std::cerr << path << ": unsupported or corrupted board file" << std::endl;
+            return nullptr;
+        }
+        
+        // Only the layouts Board uses in memory can be mapped in place
+        CellLayout layout;
+        const std::uint32_t tile = 1u << LAYOUT_TILE_SHIFT;
+        if (header.tileWidth == header.width && header.tileHeight == 1) {
+            layout = CellLayout::RowMajor;
+        } else if (header.tileWidth == tile && header.tileHeight == tile) {
+            layout = CellLayout::Tiled;
+        } else {
+            std::cerr << path << ": unsupported tile layout " << header.tileWidth
+                      << "x" << header.tileHeight << std::endl;
+            return nullptr;
+        }
+        
+        // Sizes before anything is computed from them: the cell count and
+        // the counters must fit in int, the cells in the file
+        size_t cells = static_cast<size_t>(header.width) * header.height; // fits in 64 bits
+        if (header.width == 0 || header.height == 0 || header.width > MAX_CELLS / header.height ||
+            header.mineCount > cells || header.flagCount > cells || header.revealedCount > cells) {
+            std::cerr << path << ": corrupted board file header" << std::endl;
+            return nullptr;
+        }
+        size_t storage = storageSizeFor(static_cast<int>(header.width), static_cast<int>(header.height), layout);
+        if (storage > MAX_CELLS || mapping->size() - header.headerSize < storage) {
+            std::cerr << path << ": truncated board file" << std::endl;
+            return nullptr;
+        }
+        
+        std::unique_ptr<Board> board(new Board(static_cast<int>(header.width),
+                                               static_cast<int>(header.height),
+                                               static_cast<int>(header.mineCount),
+                                               layout, std::move(mapping)));
+        board->flagCount_ = static_cast<int>(header.flagCount);
+        board->revealedCount_ = static_cast<int>(header.revealedCount);
+        board->isInitialized_ = (header.flags & BoardFile::FLAG_INITIALIZED) != 0;
+        return board;
+    }
+
+    void Board::writeHeader() {
+        BoardFileHeader header{};
+        std::memcpy(header.magic, BoardFile::MAGIC, sizeof(header.magic));
+        header.version = BoardFile::VERSION;
+        header.headerSize = sizeof(BoardFileHeader);
+        header.width = static_cast<std::uint32_t>(width_);
+        header.height = static_cast<std::uint32_t>(height_);
+        header.mineCount = static_cast<std::uint32_t>(mineCount_);
+        header.flagCount = static_cast<std::uint32_t>(flagCount_);
+        header.revealedCount = static_cast<std::uint32_t>(revealedCount_);
+        if (layout_ == CellLayout::Tiled) {
+            header.tileWidth = 1u << LAYOUT_TILE_SHIFT;
+            header.tileHeight = 1u << LAYOUT_TILE_SHIFT;
+        } else {
+            header.tileWidth = static_cast<std::uint32_t>(width_);
+            header.tileHeight = 1;
+        }
+        header.bitsPerCell = 8;
+        header.flags = isInitialized_ ? BoardFile::FLAG_INITIALIZED : 0;
+        std::memcpy(mapping_->data(), &header, sizeof(header));
+    }
+
+    bool Board::flush() {
+        if (!mapping_) {
+            return false;
+        }
+        writeHeader();
+        return mapping_->flush();
+    }
+
     void Board::reset() {
-        for (auto& row : cells_) {
-            for (auto& cell : row) {
-                cell.reset();
-            }
+        reset(Random::makeSeed());
+    }
+
+    void Board::reset(std::uint64_t seed) {
+        seed_ = seed;
+        originX_ = originY_ = -1;
+        for (size_t i = 0; i < storageSize_; ++i) {
+            cells_[i].reset();
         }
+        flagCount_ = 0;
+        revealedCount_ = 0;
         isInitialized_ = false;
+        lastReveal_.cells.clear();
+        lastReveal_.levelStarts.clear();
+        revealSerial_++;
+        clearOpenings();
+        
+        markAllDirty();
     }
 
-    void Board::initialize(int firstClickX, int firstClickY) {
+    void Board::initialize(int firstClickX, int firstClickY, const std::uint64_t* originMines) {
         if (!isInitialized_) {
-            placeMines(firstClickX, firstClickY);
+            BoardTransform transform;
+            if (hasOrigin() && BoardTransform::find(width_, height_, originX_, originY_,
+                                                    firstClickX, firstClickY, transform)) {
+                std::vector<std::uint64_t> drawn;
+                if (!originMines) {
+                    placeMines(originX_, originY_);
+                    drawn.assign((cellCount() + 63) / 64, 0);
+                    for (int y = 0; y < height_; ++y) {
+                        for (int x = 0; x < width_; ++x) {
+                            Cell& cell = getCell(x, y);
+                            if (cell.hasMine()) {
+                                size_t i = static_cast<size_t>(y) * width_ + x;
+                                drawn[i >> 6] |= std::uint64_t(1) << (i & 63);
+                                cell.setMine(false);
+                            }
+                        }
+                    }
+                    originMines = drawn.data();
+                }
+                placeMovedMines(originMines, transform);
+            } else {
+                placeMines(firstClickX, firstClickY);
+            }
             calculateAdjacentMines();
+            computeOpenings();
             isInitialized_ = true;
         }
     }
 
     Cell& Board::getCell(int x, int y) {
-        return cells_[y][x];
+        return cells_[cellIndex(x, y)];
     }
 
     const Cell& Board::getCell(int x, int y) const {
-        return cells_[y][x];
+        return cells_[cellIndex(x, y)];
+    }
+
+    BoardView Board::view() const {
+        return BoardView(*this);
+    }
+
+    size_t Board::bandCount() const {
+        return (static_cast<size_t>(height_) + GENERATION_BAND_ROWS - 1) / GENERATION_BAND_ROWS;
+    }
+
+    template <typename Fn>
+    void Board::forEachBand(size_t count, Fn&& fn) {
+        if (cellCount() >= PARALLEL_MIN_CELLS) {
+            Parallel::forEach(count, fn);
+        } else {
+            for (size_t i = 0; i < count; ++i) {
+                fn(i);
+            }
+        }
     }
 
+    // The board is cut into bands of GENERATION_BAND_ROWS rows. The mine
+    // count is first split between bands with successive hypergeometric
+    // draws (a multivariate hypergeometric split), then each band picks its
+    // mines with selection sampling from its own random stream. The result is
+    // exactly uniform over all placements and only depends on the seed, not
+    // on the number of threads.
     void Board::placeMines(int safeX, int safeY) {
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_int_distribution<> distWidth(0, width_ - 1);
-        std::uniform_int_distribution<> distHeight(0, height_ - 1);
-        
-        int minesPlaced = 0;
+        size_t bands = bandCount();
         
         // Ensure first click position is safe
-        std::vector<std::pair<int, int>> safeCells;
-        for (int dy = -1; dy <= 1; ++dy) {
-            for (int dx = -1; dx <= 1; ++dx) {
-                int nx = safeX + dx;
-                int ny = safeY + dy;
-                if (isCellValid(nx, ny)) {
-                    safeCells.emplace_back(nx, ny);
-                }
+        auto isSafeCell = [safeX, safeY](int x, int y) {
+            return std::abs(x - safeX) <= 1 && std::abs(y - safeY) <= 1;
+        };
+        
+        std::vector<std::uint64_t> bandCells(bands);
+        std::uint64_t totalCells = 0;
+        for (size_t band = 0; band < bands; ++band) {
+            int firstRow = static_cast<int>(band) * GENERATION_BAND_ROWS;
+            int lastRow = std::min(height_, firstRow + GENERATION_BAND_ROWS);
+            
+            std::uint64_t safeCount = 0;
+            for (int y = std::max(firstRow, safeY - 1); y < std::min(lastRow, safeY + 2); ++y) {
+                safeCount += std::min(width_, safeX + 2) - std::max(0, safeX - 1);
             }
+            
+            bandCells[band] = static_cast<std::uint64_t>(lastRow - firstRow) * width_ - safeCount;
+            totalCells += bandCells[band];
+        }
+        
+        if (static_cast<std::uint64_t>(mineCount_) > totalCells) {
+            std::cerr << "Too many mines (" << mineCount_ << ") for the board, using "
+                      << totalCells << std::endl;
+            mineCount_ = static_cast<int>(totalCells);
         }
         
-        while (minesPlaced < mineCount_) {
-            int x = distWidth(gen);
-            int y = distHeight(gen);
+        std::vector<std::uint64_t> bandMines(bands);
+        Random::Generator splitter(Random::streamSeed(seed_, 0));
+        std::uint64_t minesLeft = static_cast<std::uint64_t>(mineCount_);
+        std::uint64_t cellsLeft = totalCells;
+        for (size_t band = 0; band < bands; ++band) {
+            bandMines[band] = band + 1 == bands
+                ? minesLeft
+                : Random::hypergeometric(splitter, cellsLeft, minesLeft, bandCells[band]);
+            minesLeft -= bandMines[band];
+            cellsLeft -= bandCells[band];
+        }
+        
+        forEachBand(bands, [&](size_t band) {
+            Random::Generator gen(Random::streamSeed(seed_, band + 1));
+            std::uint64_t needed = bandMines[band];
+            std::uint64_t remaining = bandCells[band];
             
-            // Check if this is a safe cell (around first click)
-            bool isSafeCell = false;
-            for (const auto& safe : safeCells) {
-                if (x == safe.first && y == safe.second) {
-                    isSafeCell = true;
+            int firstRow = static_cast<int>(band) * GENERATION_BAND_ROWS;
+            int lastRow = std::min(height_, firstRow + GENERATION_BAND_ROWS);
+            for (int y = firstRow; y < lastRow && needed > 0; ++y) {
+                for (int x = 0; x < width_; ++x) {
+                    if (isSafeCell(x, y)) {
+                        continue;
+                    }
+                    
+                    // Select with probability needed / remaining
+                    if (gen.uniform() * static_cast<double>(remaining) < static_cast<double>(needed)) {
+                        getCell(x, y).setMine(true);
+                        needed--;
+                    }
+                    remaining--;
+                }
+            }
+        });
+    }
+
+    void Board::placeMovedMines(const std::uint64_t* originMines, const BoardTransform& transform) {
+        size_t count = cellCount();
+        for (size_t word = 0; word < (count + 63) / 64; ++word) {
+            for (std::uint64_t bits = originMines[word]; bits != 0; bits &= bits - 1) {
+                size_t i = word * 64 + static_cast<size_t>(Bits::lowestBit(bits));
+                if (i >= count) {
                     break;
                 }
+                int x = static_cast<int>(i % static_cast<size_t>(width_));
+                int y = static_cast<int>(i / static_cast<size_t>(width_));
+                transform.apply(width_, height_, x, y);
+                getCell(x, y).setMine(true);
             }
-            
-            if (!isSafeCell && !cells_[y][x].hasMine()) {
-                cells_[y][x].setMine(true);
-                minesPlaced++;
+        }
+    }
+
+    bool BoardTransform::find(int width, int height, int originX, int originY,
+                              int clickX, int clickY, BoardTransform& transform) {
+        auto zoneSize = [width, height](int x, int y) {
+            return (std::min(width, x + 2) - std::max(0, x - 1)) * (std::min(height, y + 2) - std::max(0, y - 1));
+        };
+        if (zoneSize(originX, originY) != zoneSize(clickX, clickY)) {
+            return false;
+        }
+        
+        // Every symmetry of the board, then the translation that brings the
+        // origin onto the click; it fits when the free cells land on free
+        // cells (as many on both sides)
+        bool found = false;
+        for (int t = 0; t < (width == height ? 2 : 1); ++t) {
+            for (int flips = 0; flips < 4; ++flips) {
+                BoardTransform candidate;
+                candidate.transpose = t != 0;
+                candidate.flipX = (flips & 1) != 0;
+                candidate.flipY = (flips & 2) != 0;
+                int ox = originX, oy = originY;
+                candidate.apply(width, height, ox, oy);
+                candidate.dx = ((clickX - ox) % width + width) % width;
+                candidate.dy = ((clickY - oy) % height + height) % height;
+                
+                bool fits = true;
+                for (int y = std::max(0, originY - 1); fits && y < std::min(height, originY + 2); ++y) {
+                    for (int x = std::max(0, originX - 1); fits && x < std::min(width, originX + 2); ++x) {
+                        int mx = x, my = y;
+                        candidate.apply(width, height, mx, my);
+                        fits = std::abs(mx - clickX) <= 1 && std::abs(my - clickY) <= 1;
+                    }
+                }
+                if (fits && (!found || (candidate.isSymmetry() && !transform.isSymmetry()))) {
+                    transform = candidate;
+                    found = true;
+                }
             }
         }
+        return found;
     }
 
     void Board::calculateAdjacentMines() {
-        static const int dx[] = {-1, 0, 1, -1, 1, -1, 0, 1};
-        static const int dy[] = {-1, -1, -1, 0, 0, 1, 1, 1};
+        // Each band writes its own rows and reads one halo row from each
+        // neighbor band. A cell's mine bit shares its byte with the count, so
+        // even and odd bands run in two passes: a halo row is never being
+        // written while it is read.
+        size_t bands = bandCount();
+        for (size_t parity = 0; parity < 2; ++parity) {
+            forEachBand((bands + 1 - parity) / 2, [this, parity](size_t i) {
+                countBandMines(2 * i + parity);
+            });
+        }
+    }
+
+    void Board::countBandMines(size_t band) {
+        int firstRow = static_cast<int>(band) * GENERATION_BAND_ROWS;
+        int lastRow = std::min(height_, firstRow + GENERATION_BAND_ROWS);
         
-        for (int y = 0; y < height_; ++y) {
+        for (int y = firstRow; y < lastRow; ++y) {
+            int top = std::max(0, y - 1);
+            int bottom = std::min(height_ - 1, y + 1);
+            
             for (int x = 0; x < width_; ++x) {
-                if (cells_[y][x].hasMine()) {
+                if (getCell(x, y).hasMine()) {
                     continue;
                 }
                 
+                int left = std::max(0, x - 1);
+                int right = std::min(width_ - 1, x + 1);
+                
                 int mineCount = 0;
-                for (int i = 0; i < 8; ++i) {
-                    int nx = x + dx[i];
-                    int ny = y + dy[i];
-                    
-                    if (isCellValid(nx, ny) && cells_[ny][nx].hasMine()) {
-                        mineCount++;
+                for (int ny = top; ny <= bottom; ++ny) {
+                    for (int nx = left; nx <= right; ++nx) {
+                        mineCount += getCell(nx, ny).hasMine() ? 1 : 0;
                     }
                 }
                 
-                cells_[y][x].setAdjacentMines(mineCount);
+                getCell(x, y).setAdjacentMines(mineCount);
             }
         }
     }
@@ -106,64 +442,298 @@ namespace Minesweeper {
             return false;
         }
         
-        Cell& cell = cells_[y][x];
+        Cell& cell = getCell(x, y);
         
         if (cell.isRevealed() || cell.isFlagged()) {
             return false;
         }
         
+        return revealSingle(x, y); // true: game over
+    }
+
+    bool Board::revealSingle(int x, int y) {
+        Cell& cell = getCell(x, y);
         cell.reveal();
+        revealedCount_++;
+        dirty_.include(x, y);
         
         if (cell.hasMine()) {
-            return true; // Game over
+            return true;
         }
         
+        countSolvedBBBV(cellIndex(x, y), 1);
+        
         if (cell.getAdjacentMines() == 0) {
-            revealEmptyCells(x, y);
+            std::uint32_t opening = openingsReady_ ? openingOf_[cellIndex(x, y)] : NO_OPENING;
+            if (isOpening(opening) && !openingBlocked_[opening]) {
+                revealOpening(opening, x, y);
+            } else {
+                revealEmptyCells(x, y);
+            }
+            recordCascade();
         }
         
         return false;
     }
 
+    bool Board::chordCell(int x, int y) {
+        if (!isCellValid(x, y) || !isInitialized_) {
+            return false;
+        }
+        
+        const Cell& cell = getCell(x, y);
+        if (!cell.isRevealed() || cell.hasMine() || cell.getAdjacentMines() == 0) {
+            return false;
+        }
+        
+        int minX = std::max(0, x - 1), maxX = std::min(width_ - 1, x + 1);
+        int minY = std::max(0, y - 1), maxY = std::min(height_ - 1, y + 1);
+        
+        int flags = 0;
+        for (int ny = minY; ny <= maxY; ++ny) {
+            for (int nx = minX; nx <= maxX; ++nx) {
+                flags += getCell(nx, ny).isFlagged() ? 1 : 0;
+            }
+        }
+        if (flags != cell.getAdjacentMines()) {
+            return false;
+        }
+        
+        // The neighbors are level 0 of the merged trace; the cascades they
+        // start are merged level by level so they animate side by side
+        // (without levels, one after the other in levels[0])
+        std::vector<std::vector<size_t>> levels(1);
+        bool hitMine = false;
+        
+        for (int ny = minY; ny <= maxY; ++ny) {
+            for (int nx = minX; nx <= maxX; ++nx) {
+                const Cell& neighbor = getCell(nx, ny);
+                if (neighbor.isRevealed() || neighbor.isFlagged()) {
+                    continue; // includes cells revealed by an earlier neighbor's cascade
+                }
+                
+                std::uint64_t serial = revealSerial_;
+                hitMine |= revealSingle(nx, ny);
+                levels[0].push_back(cellIndex(nx, ny));
+                
+                if (revealSerial_ == serial) {
+                    continue;
+                }
+                if (!revealLevels_) {
+                    levels[0].insert(levels[0].end(), lastReveal_.cells.begin() + 1, lastReveal_.cells.end());
+                    continue;
+                }
+                for (size_t level = 1; level < lastReveal_.getLevelCount(); ++level) {
+                    if (levels.size() <= level) {
+                        levels.emplace_back();
+                    }
+                    size_t begin = lastReveal_.levelStarts[level];
+                    size_t end = level + 1 < lastReveal_.getLevelCount() ? lastReveal_.levelStarts[level + 1]
+                                                                          : lastReveal_.cells.size();
+                    levels[level].insert(levels[level].end(),
+                                         lastReveal_.cells.begin() + begin, lastReveal_.cells.begin() + end);
+                }
+            }
+        }
+        
+        if (levels[0].empty()) {
+            return false;
+        }
+        
+        lastReveal_.cells.clear();
+        lastReveal_.levelStarts.clear();
+        for (const std::vector<size_t>& level : levels) {
+            lastReveal_.levelStarts.push_back(lastReveal_.cells.size());
+            lastReveal_.cells.insert(lastReveal_.cells.end(), level.begin(), level.end());
+        }
+        revealSerial_++;
+        
+        return hitMine;
+    }
+
+    // Bookkeeping for the cells a cascade revealed (the trace minus the
+    // clicked cell, which revealSingle already counted)
+    void Board::recordCascade() {
+        for (size_t i = 1; i < lastReveal_.cells.size(); ++i) {
+            int cx, cy;
+            cellPosition(lastReveal_.cells[i], cx, cy);
+            dirty_.include(cx, cy);
+            countSolvedBBBV(lastReveal_.cells[i], 1);
+        }
+    }
+
+    void Board::markAllDirty() {
+        dirty_ = DirtyRegion();
+        dirty_.include(0, 0);
+        dirty_.include(width_ - 1, height_ - 1);
+    }
+
+    DirtyRegion Board::takeDirtyRegion() {
+        DirtyRegion region = dirty_;
+        dirty_ = DirtyRegion();
+        return region;
+    }
+
+    void Board::setCellRevealed(size_t index, bool revealed) {
+        Cell& cell = cells_[index];
+        if (cell.isRevealed() == revealed) {
+            return;
+        }
+        
+        int x, y;
+        cellPosition(index, x, y);
+        cell.setRevealed(revealed);
+        revealedCount_ += revealed ? 1 : -1;
+        countSolvedBBBV(index, revealed ? 1 : -1);
+        dirty_.include(x, y);
+    }
+
+    void Board::toggleCellFlag(size_t index) {
+        int x, y;
+        cellPosition(index, x, y);
+        toggleFlag(x, y);
+    }
+
+    void Board::clearLastReveal() {
+        lastReveal_.cells.clear();
+        lastReveal_.levelStarts.clear();
+        revealSerial_++;
+    }
+
+    // Level-synchronous BFS over the zero cells. Each level is expanded on
+    // one thread, or on all of them when the frontier is large enough to pay
+    // for it. Both paths reveal exactly the same cells.
     void Board::revealEmptyCells(int x, int y) {
-        std::queue<std::pair<int, int>> cellsToCheck;
-        cellsToCheck.emplace(x, y);
+        std::vector<size_t> frontier{cellIndex(x, y)};
+        std::vector<size_t> next;
         
-        static const int dx[] = {-1, 0, 1, -1, 1, -1, 0, 1};
-        static const int dy[] = {-1, -1, -1, 0, 0, 1, 1, 1};
+        lastReveal_.cells.assign(frontier.begin(), frontier.end());
+        lastReveal_.levelStarts.assign(1, 0);
+        revealSerial_++;
         
-        while (!cellsToCheck.empty()) {
-            auto [currentX, currentY] = cellsToCheck.front();
-            cellsToCheck.pop();
-            
-            for (int i = 0; i < 8; ++i) {
-                int nx = currentX + dx[i];
-                int ny = currentY + dy[i];
+        while (!frontier.empty()) {
+            next.clear();
+            if (revealLevels_) {
+                lastReveal_.levelStarts.push_back(lastReveal_.cells.size());
+            }
+            if (frontier.size() >= PARALLEL_MIN_FRONTIER && Parallel::workerCount() > 1) {
+                expandFrontierParallel(frontier, next);
+            } else {
+                expandFrontier(frontier, next);
+            }
+            frontier.swap(next);
+        }
+        
+        // The last level revealed nothing
+        if (lastReveal_.levelStarts.back() == lastReveal_.cells.size()) {
+            lastReveal_.levelStarts.pop_back();
+        }
+    }
+
+    template <typename Fn>
+    void Board::forEachNeighbor(size_t index, Fn&& fn) const {
+        int x, y;
+        cellPosition(index, x, y);
+        
+        for (int ny = std::max(0, y - 1); ny <= std::min(height_ - 1, y + 1); ++ny) {
+            for (int nx = std::max(0, x - 1); nx <= std::min(width_ - 1, x + 1); ++nx) {
+                if (nx != x || ny != y) {
+                    fn(cellIndex(nx, ny));
+                }
+            }
+        }
+    }
+
+    void Board::expandFrontier(const std::vector<size_t>& frontier, std::vector<size_t>& next) {
+        for (size_t index : frontier) {
+            forEachNeighbor(index, [&](size_t neighborIndex) {
+                Cell& neighbor = cells_[neighborIndex];
                 
-                if (isCellValid(nx, ny)) {
-                    Cell& neighbor = cells_[ny][nx];
+                if (!neighbor.isRevealed() && !neighbor.isFlagged() && !neighbor.hasMine()) {
+                    neighbor.reveal();
+                    revealedCount_++;
+                    lastReveal_.cells.push_back(neighborIndex);
                     
-                    if (!neighbor.isRevealed() && !neighbor.isFlagged() && !neighbor.hasMine()) {
-                        neighbor.reveal();
-                        
-                        if (neighbor.getAdjacentMines() == 0) {
-                            cellsToCheck.emplace(nx, ny);
-                        }
+                    if (neighbor.getAdjacentMines() == 0) {
+                        next.push_back(neighborIndex);
                     }
                 }
+            });
+        }
+    }
+
+    void Board::expandFrontierParallel(const std::vector<size_t>& frontier, std::vector<size_t>& next) {
+        size_t words = (storageSize_ + 63) / 64;
+        if (revealClaims_.size() != words) {
+            revealClaims_ = std::vector<std::atomic<std::uint64_t>>(words);
+        }
+        
+        size_t chunks = (frontier.size() + FRONTIER_CHUNK - 1) / FRONTIER_CHUNK;
+        std::vector<std::vector<size_t>> claimed(chunks);
+        
+        // Pass 1: claim the neighbors to reveal. Cells are only read here; a
+        // test-and-set on the claim bitplane makes each cell belong to exactly
+        // one chunk even when several frontier cells share it.
+        Parallel::forEach(chunks, [&](size_t chunk) {
+            size_t end = std::min(frontier.size(), (chunk + 1) * FRONTIER_CHUNK);
+            for (size_t i = chunk * FRONTIER_CHUNK; i < end; ++i) {
+                forEachNeighbor(frontier[i], [&](size_t neighborIndex) {
+                    const Cell& neighbor = cells_[neighborIndex];
+                    if (neighbor.isRevealed() || neighbor.isFlagged() || neighbor.hasMine()) {
+                        return;
+                    }
+                    
+                    std::uint64_t bit = std::uint64_t(1) << (neighborIndex & 63);
+                    if (!(revealClaims_[neighborIndex >> 6].fetch_or(bit, std::memory_order_relaxed) & bit)) {
+                        claimed[chunk].push_back(neighborIndex);
+                    }
+                });
+            }
+        });
+        
+        // Pass 2: reveal the claimed cells (one writer per cell), release
+        // their claim bits and keep the zero cells for the next level
+        std::vector<std::vector<size_t>> zeros(chunks);
+        Parallel::forEach(chunks, [&](size_t chunk) {
+            for (size_t index : claimed[chunk]) {
+                cells_[index].reveal();
+                revealClaims_[index >> 6].fetch_and(~(std::uint64_t(1) << (index & 63)),
+                                                    std::memory_order_relaxed);
+                if (cells_[index].getAdjacentMines() == 0) {
+                    zeros[chunk].push_back(index);
+                }
             }
+        });
+        
+        for (size_t chunk = 0; chunk < chunks; ++chunk) {
+            revealedCount_ += static_cast<int>(claimed[chunk].size());
+            lastReveal_.cells.insert(lastReveal_.cells.end(), claimed[chunk].begin(), claimed[chunk].end());
+            next.insert(next.end(), zeros[chunk].begin(), zeros[chunk].end());
         }
     }
 
     void Board::toggleFlag(int x, int y) {
         if (isCellValid(x, y)) {
-            cells_[y][x].toggleFlag();
+            Cell& cell = getCell(x, y);
+            bool wasFlagged = cell.isFlagged();
+            cell.toggleFlag();
+            flagCount_ += static_cast<int>(cell.isFlagged()) - static_cast<int>(wasFlagged);
+            dirty_.include(x, y);
+            
+            if (cell.isFlagged() && openingsReady_) {
+                std::uint32_t opening = openingOf_[cellIndex(x, y)];
+                if (isOpening(opening)) {
+                    openingBlocked_[opening] = 1;
+                }
+            }
         }
     }
 
     bool Board::checkWin() const {
-        for (const auto& row : cells_) {
-            for (const auto& cell : row) {
+        // Row by row: tiled storage has padding cells past the board edges
+        for (int y = 0; y < height_; ++y) {
+            for (int x = 0; x < width_; ++x) {
+                const Cell& cell = getCell(x, y);
                 if (!cell.hasMine() && !cell.isRevealed()) {
                     return false;
                 }
@@ -178,28 +748,4 @@ namespace Minesweeper {
     bool Board::isCellValid(int x, int y) const {
         return x >= 0 && x < width_ && y >= 0 && y < height_;
     }
-
-    int Board::getFlagCount() const {
-        int count = 0;
-        for (const auto& row : cells_) {
-            for (const auto& cell : row) {
-                if (cell.isFlagged()) {
-                    count++;
-                }
-            }
-        }
-        return count;
-    }
-
-    int Board::getRevealedCount() const {
-        int count = 0;
-        for (const auto& row : cells_) {
-            for (const auto& cell : row) {
-                if (cell.isRevealed()) {
-                    count++;
-                }
-            }
-        }
-        return count;
-    }
 }
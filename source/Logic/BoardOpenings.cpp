@@ -0,0 +1,279 @@
+#include "../../include/Logic/Board.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+namespace Minesweeper {
+    namespace {
+        constexpr std::uint32_t LABELED = 0x80000000u;
+        
+        // Union-find root with path halving
+        std::uint32_t findRoot(std::vector<std::uint32_t>& parent, std::uint32_t i) {
+            while (parent[i] != i) {
+                parent[i] = parent[parent[i]];
+                i = parent[i];
+            }
+            return i;
+        }
+    }
+
+    void Board::clearOpenings() {
+        openingsReady_ = false;
+        openingOf_.clear();
+        openingStarts_.clear();
+        openingCells_.clear();
+        openingBlocked_.clear();
+        openingRevealed_.clear();
+        metrics_ = BoardMetrics();
+        solvedBBBV_ = 0;
+    }
+
+    void Board::computeOpenings() {
+        clearOpenings();
+        if (storageSize_ > OPENINGS_MAX_CELLS) {
+            return;
+        }
+        
+        auto isZero = [this](int x, int y) {
+            const Cell& cell = cells_[cellIndex(x, y)];
+            return !cell.hasMine() && cell.getAdjacentMines() == 0;
+        };
+        
+        // Union pass: each zero cell joins its already visited zero
+        // neighbors. N touches both W and NE's row, so it is enough on its
+        // own; otherwise W (or NW) and NE. openingOf_ holds the parents for now.
+        std::vector<std::uint32_t>& parent = openingOf_;
+        parent.assign(storageSize_, NO_OPENING);
+        
+        auto unite = [&parent](std::uint32_t a, std::uint32_t b) {
+            a = findRoot(parent, a);
+            b = findRoot(parent, b);
+            if (a != b) {
+                parent[std::max(a, b)] = std::min(a, b);
+            }
+        };
+        auto zeroAt = [&](int x, int y) -> std::uint32_t {
+            if (x < 0 || x >= width_ || y < 0) {
+                return NO_OPENING;
+            }
+            std::uint32_t index = static_cast<std::uint32_t>(cellIndex(x, y));
+            return parent[index] != NO_OPENING ? index : NO_OPENING;
+        };
+        
+        for (int y = 0; y < height_; ++y) {
+            for (int x = 0; x < width_; ++x) {
+                if (!isZero(x, y)) {
+                    continue;
+                }
+                
+                std::uint32_t index = static_cast<std::uint32_t>(cellIndex(x, y));
+                parent[index] = index;
+                
+                std::uint32_t north = zeroAt(x, y - 1);
+                if (north != NO_OPENING) {
+                    unite(index, north);
+                    continue;
+                }
+                
+                std::uint32_t west = zeroAt(x - 1, y);
+                if (west == NO_OPENING) {
+                    west = zeroAt(x - 1, y - 1);
+                }
+                if (west != NO_OPENING) {
+                    unite(index, west);
+                }
+                
+                std::uint32_t northEast = zeroAt(x + 1, y - 1);
+                if (northEast != NO_OPENING) {
+                    unite(index, northEast);
+                }
+            }
+        }
+        
+        // Labeling: point every zero cell straight at its root, then number
+        // the sets in scan order. Root slots hold LABELED | number until
+        // every member has been labeled.
+        for (std::uint32_t index = 0; index < parent.size(); ++index) {
+            if (parent[index] != NO_OPENING) {
+                parent[index] = findRoot(parent, index);
+            }
+        }
+        
+        std::vector<std::uint32_t> roots;
+        for (int y = 0; y < height_; ++y) {
+            for (int x = 0; x < width_; ++x) {
+                std::uint32_t index = static_cast<std::uint32_t>(cellIndex(x, y));
+                std::uint32_t& slot = parent[index];
+                if (slot == NO_OPENING || (slot & LABELED)) {
+                    continue; // not a zero cell, or a root labeled through another cell
+                }
+                
+                std::uint32_t root = slot;
+                if (!(parent[root] & LABELED)) {
+                    parent[root] = LABELED | static_cast<std::uint32_t>(roots.size());
+                    roots.push_back(root);
+                }
+                if (index != root) {
+                    slot = parent[root] & ~LABELED;
+                }
+            }
+        }
+        for (std::uint32_t root : roots) {
+            parent[root] &= ~LABELED;
+        }
+        std::uint32_t openingCount = static_cast<std::uint32_t>(roots.size());
+        
+        // Regions: the zero cells of each opening, counted first, then
+        // filled (CSR layout). Numbers next to a zero cell are tagged on the
+        // way; revealOpening() finds them around the zero cells. Numbers left
+        // untagged touch no opening: they are the isolated ones.
+        openingStarts_.assign(openingCount + 1, 0);
+        int safeCells = 0;
+        int borderingNumbers = 0;
+        for (int y = 0; y < height_; ++y) {
+            for (int x = 0; x < width_; ++x) {
+                std::uint32_t index = static_cast<std::uint32_t>(cellIndex(x, y));
+                const Cell& cell = cells_[index];
+                if (cell.hasMine()) {
+                    continue;
+                }
+                safeCells++;
+                if (cell.getAdjacentMines() != 0) {
+                    continue;
+                }
+                
+                openingStarts_[parent[index] + 1]++;
+                for (int ny = std::max(0, y - 1); ny <= std::min(height_ - 1, y + 1); ++ny) {
+                    for (int nx = std::max(0, x - 1); nx <= std::min(width_ - 1, x + 1); ++nx) {
+                        size_t neighbor = cellIndex(nx, ny);
+                        // No mine touches a zero cell: NO_OPENING here is an untagged number
+                        if (parent[neighbor] == NO_OPENING) {
+                            parent[neighbor] = BORDERING_NUMBER;
+                            borderingNumbers++;
+                        }
+                    }
+                }
+            }
+        }
+        for (std::uint32_t i = 0; i < openingCount; ++i) {
+            openingStarts_[i + 1] += openingStarts_[i];
+        }
+        
+        openingCells_.resize(openingStarts_.back());
+        std::vector<std::uint32_t> fill(openingStarts_.begin(), openingStarts_.end() - 1);
+        for (int y = 0; y < height_; ++y) {
+            for (int x = 0; x < width_; ++x) {
+                std::uint32_t index = static_cast<std::uint32_t>(cellIndex(x, y));
+                if (isOpening(parent[index])) {
+                    openingCells_[fill[parent[index]]++] = index;
+                }
+            }
+        }
+        int isolatedNumbers = safeCells - static_cast<int>(openingCells_.size()) - borderingNumbers;
+        
+        openingBlocked_.assign(openingCount, 0);
+        openingRevealed_.assign(openingCount, 0);
+        metrics_.openings = static_cast<int>(openingCount);
+        metrics_.isolatedNumbers = isolatedNumbers;
+        metrics_.bbbv = metrics_.openings + metrics_.isolatedNumbers;
+        openingsReady_ = true;
+    }
+    
+    // Called for every cell revealed (delta 1) or hidden again by an undo
+    // (delta -1). An opening is solved while one of its zero cells is
+    // revealed; a number cell is one 3BV click when it touches no zero cell.
+    void Board::countSolvedBBBV(size_t index, int delta) {
+        if (!openingsReady_ || cells_[index].hasMine()) {
+            return;
+        }
+        
+        std::uint32_t opening = openingOf_[index];
+        if (opening == BORDERING_NUMBER) {
+            return; // solved with its opening
+        }
+        if (opening == NO_OPENING) {
+            solvedBBBV_ += delta; // isolated number
+            return;
+        }
+        
+        bool wasSolved = openingRevealed_[opening] > 0;
+        openingRevealed_[opening] += delta;
+        solvedBBBV_ += static_cast<int>(openingRevealed_[opening] > 0) - static_cast<int>(wasSolved);
+    }
+
+    // Reveals the opening's zero cells and the numbers around them, calling
+    // fn(index, x, y) for each cell it reveals
+    template <typename Fn>
+    void Board::revealOpeningCells(std::uint32_t opening, Fn&& fn) {
+        auto reveal = [&](size_t index, int cx, int cy) {
+            Cell& cell = cells_[index];
+            if (cell.isRevealed() || cell.isFlagged()) {
+                return;
+            }
+            
+            cell.reveal();
+            revealedCount_++;
+            fn(index, cx, cy);
+        };
+        
+        for (std::uint32_t i = openingStarts_[opening]; i < openingStarts_[opening + 1]; ++i) {
+            int cx, cy;
+            cellPosition(openingCells_[i], cx, cy);
+            reveal(openingCells_[i], cx, cy);
+            
+            for (int ny = std::max(0, cy - 1); ny <= std::min(height_ - 1, cy + 1); ++ny) {
+                for (int nx = std::max(0, cx - 1); nx <= std::min(width_ - 1, cx + 1); ++nx) {
+                    size_t neighbor = cellIndex(nx, ny);
+                    if (openingOf_[neighbor] == BORDERING_NUMBER) {
+                        reveal(neighbor, nx, ny);
+                    }
+                }
+            }
+        }
+    }
+
+    // Reveals a whole precomputed region, without searching: the zero cells
+    // and the numbers around them. Same cells as the BFS as long as none of
+    // the opening's zero cells was ever flagged; flagged or already revealed
+    // cells are skipped just like the BFS does.
+    void Board::revealOpening(std::uint32_t opening, int x, int y) {
+        lastReveal_.cells.assign(1, cellIndex(x, y));
+        lastReveal_.levelStarts.assign(1, 0);
+        revealSerial_++;
+        if (!revealLevels_) {
+            revealOpeningCells(opening, [this](size_t index, int, int) {
+                lastReveal_.cells.push_back(index);
+            });
+            return;
+        }
+        
+        // Level = Chebyshev distance to the click, bucketed by counting sort
+        std::vector<std::uint32_t> revealed;
+        std::vector<std::uint32_t> distance;
+        std::vector<size_t> ringSizes(1, 0);
+        
+        revealOpeningCells(opening, [&](size_t index, int cx, int cy) {
+            std::uint32_t d = static_cast<std::uint32_t>(std::max(std::abs(cx - x), std::abs(cy - y)));
+            if (d >= ringSizes.size()) {
+                ringSizes.resize(d + 1, 0);
+            }
+            ringSizes[d]++;
+            revealed.push_back(static_cast<std::uint32_t>(index));
+            distance.push_back(d);
+        });
+        
+        std::vector<size_t> ringStarts(ringSizes.size(), 0);
+        size_t position = lastReveal_.cells.size();
+        for (size_t d = 0; d < ringSizes.size(); ++d) {
+            ringStarts[d] = position;
+            if (ringSizes[d] > 0) {
+                lastReveal_.levelStarts.push_back(position);
+            }
+            position += ringSizes[d];
+        }
+        
+        lastReveal_.cells.resize(position);
+        for (size_t i = 0; i < revealed.size(); ++i) {
+            lastReveal_.cells[ringStarts[distance[i]]++] = revealed[i];
+        }
+    }
+}
@@ -0,0 +1,200 @@
+#include "../../include/Logic/BoardPool.hpp"
+#include "../../include/Logic/Board.hpp"
+#include "../../include/Logic/NoGuessGenerator.hpp"
+#include "../../include/Logic/Random.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace Minesweeper {
+    namespace {
+        constexpr std::chrono::milliseconds IDLE_WAIT(100); // also covers a missed wake-up
+
+        // Canonical first clicks of ordinary boards: inside, on the top
+        // edge, on the left edge, in the corner (the other edges are symmetric)
+        std::vector<std::pair<int, int>> shapeOrigins(int width, int height) {
+            std::vector<std::pair<int, int>> origins = {{0, 0}};
+            if (width >= 3) {
+                origins.push_back({width / 2, 0});
+            }
+            if (height >= 3) {
+                origins.push_back({0, height / 2});
+            }
+            if (width >= 3 && height >= 3) {
+                origins.push_back({width / 2, height / 2});
+            }
+            return origins;
+        }
+
+        // Canonical first clicks of no-guess boards: the first cell of each
+        // orbit of the board's symmetries, in row-major order
+        std::vector<std::pair<int, int>> orbitOrigins(int width, int height) {
+            std::vector<std::pair<int, int>> origins;
+            for (int y = 0; y < height; ++y) {
+                for (int x = 0; x < width; ++x) {
+                    bool first = true;
+                    for (int symmetry = 1; symmetry < 8 && first; ++symmetry) {
+                        BoardTransform transform;
+                        transform.transpose = (symmetry & 4) != 0;
+                        transform.flipX = (symmetry & 1) != 0;
+                        transform.flipY = (symmetry & 2) != 0;
+                        if (transform.transpose && width != height) {
+                            continue;
+                        }
+                        int imageX = x;
+                        int imageY = y;
+                        transform.apply(width, height, imageX, imageY);
+                        first = imageY * width + imageX >= y * width + x;
+                    }
+                    if (first) {
+                        origins.push_back({x, y});
+                    }
+                }
+            }
+            return origins;
+        }
+    }
+
+    BoardPool::BoardPool() {
+        queues_.resize(MAX_QUEUES); // never reallocated under the producer
+    }
+
+    BoardPool::~BoardPool() {
+        stopping_ = true;
+        wakeProducer();
+        if (producer_.joinable()) {
+            producer_.join();
+        }
+    }
+
+    bool BoardPool::addSettings(int width, int height, int mineCount, bool noGuess) {
+        for (const Settings& settings : settings_) {
+            if (settings.width == width && settings.height == height &&
+                settings.mineCount == mineCount && settings.noGuess == noGuess) {
+                return true;
+            }
+        }
+
+        std::vector<std::pair<int, int>> origins = noGuess ? orbitOrigins(width, height)
+                                                           : shapeOrigins(width, height);
+        size_t count = queueCount_.load(std::memory_order_relaxed);
+        if (count + origins.size() > MAX_QUEUES) {
+            std::cerr << "Board pool full, " << width << "x" << height << " boards are generated on the first click"
+                      << std::endl;
+            return false;
+        }
+
+        // Queue of each first click, worked out once so take() is O(1)
+        Settings settings{width, height, mineCount, noGuess, {}};
+        settings.queueOfCell.resize(static_cast<size_t>(width) * height);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                size_t queue = origins.size();
+                for (size_t i = 0; i < origins.size() && queue == origins.size(); ++i) {
+                    BoardTransform transform;
+                    if (BoardTransform::find(width, height, origins[i].first, origins[i].second, x, y, transform) &&
+                        (!noGuess || transform.isSymmetry())) {
+                        queue = i;
+                    }
+                }
+                if (queue == origins.size()) {
+                    std::cerr << "No pooled origin for the first click (" << x << ", " << y << ")" << std::endl;
+                    return false;
+                }
+                settings.queueOfCell[static_cast<size_t>(y) * width + x] = static_cast<std::uint32_t>(count + queue);
+            }
+        }
+
+        for (const auto& origin : origins) {
+            queues_[count] = std::make_unique<Queue>();
+            Queue& queue = *queues_[count];
+            queue.width = width;
+            queue.height = height;
+            queue.mineCount = mineCount;
+            queue.noGuess = noGuess;
+            queue.originX = origin.first;
+            queue.originY = origin.second;
+            count++;
+        }
+        settings_.push_back(std::move(settings));
+        queueCount_.store(count, std::memory_order_release);
+
+        if (!producer_.joinable()) {
+            producer_ = std::thread(&BoardPool::produce, this);
+        }
+        wakeProducer();
+        return true;
+    }
+
+    bool BoardPool::take(int width, int height, int mineCount, bool noGuess, int x, int y,
+                         PooledBoard& board) {
+        for (const Settings& settings : settings_) {
+            if (settings.width == width && settings.height == height &&
+                settings.mineCount == mineCount && settings.noGuess == noGuess) {
+                bool taken = queues_[settings.queueOfCell[static_cast<size_t>(y) * width + x]]->boards.pop(board);
+                wakeProducer();
+                return taken;
+            }
+        }
+        return false;
+    }
+
+    void BoardPool::wakeProducer() {
+        wanted_ = true;
+        wake_.notify_one();
+    }
+
+    // Fills the queues in turn, one board at a time, on a single thread:
+    // the game keeps the other cores
+    void BoardPool::produce() {
+        std::unique_ptr<Board> scratch;
+        while (!stopping_) {
+            bool produced = false;
+            size_t count = queueCount_.load(std::memory_order_acquire);
+            for (size_t i = 0; i < count && !stopping_; ++i) {
+                Queue& queue = *queues_[i];
+                if (queue.boards.isFull()) {
+                    continue;
+                }
+
+                PooledBoard board;
+                board.seed = Random::makeSeed();
+                board.originX = queue.originX;
+                board.originY = queue.originY;
+                // Stopping cuts the search short, so the destructor doesn't
+                // wait for it
+                if (queue.noGuess &&
+                    !NoGuessGenerator::findSeed(queue.width, queue.height, queue.mineCount,
+                                                queue.originX, queue.originY, board.seed, board.seed, 1,
+                                                NoGuessGenerator::BUDGET_MILLISECONDS, &stopping_)) {
+                    continue;
+                }
+
+                if (!scratch) {
+                    scratch = std::make_unique<Board>(queue.width, queue.height, queue.mineCount);
+                } else if (scratch->getWidth() != queue.width || scratch->getHeight() != queue.height ||
+                           scratch->getMineCount() != queue.mineCount) {
+                    scratch->resize(queue.width, queue.height, queue.mineCount);
+                }
+                scratch->reset(board.seed);
+                scratch->initialize(queue.originX, queue.originY);
+
+                board.mines.assign((static_cast<size_t>(queue.width) * queue.height + 63) / 64, 0);
+                for (int y = 0; y < queue.height; ++y) {
+                    for (int x = 0; x < queue.width; ++x) {
+                        if (scratch->getCell(x, y).hasMine()) {
+                            size_t cell = static_cast<size_t>(y) * queue.width + x;
+                            board.mines[cell >> 6] |= std::uint64_t(1) << (cell & 63);
+                        }
+                    }
+                }
+                produced = queue.boards.push(std::move(board)) || produced;
+            }
+
+            if (!produced) {
+                std::unique_lock<std::mutex> lock(wakeMutex_);
+                wake_.wait_for(lock, IDLE_WAIT, [this]() { return stopping_ || wanted_.exchange(false); });
+            }
+        }
+    }
+}
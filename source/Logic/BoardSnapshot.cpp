@@ -0,0 +1,261 @@
+#include "../../include/Logic/Board.hpp"
+#include "../../include/Logic/Bits.hpp"
+#include <cstring>
+#include <iostream>
+
+namespace Minesweeper {
+    namespace {
+        constexpr std::uint64_t LOW_BITS = 0x0101010101010101ull;
+        // Multiplying LOW_BITS-masked bytes by this moves bit 0 of byte i
+        // to bit 56 + i without carries
+        constexpr std::uint64_t GATHER = 0x0102040810204080ull;
+
+        constexpr int bitShift(std::uint8_t bit) {
+            return bit == 1 ? 0 : 1 + bitShift(static_cast<std::uint8_t>(bit >> 1));
+        }
+        constexpr int MINE_SHIFT = bitShift(Cell::MINE_BIT);
+        constexpr int REVEALED_SHIFT = bitShift(Cell::REVEALED_BIT);
+        constexpr int FLAGGED_SHIFT = bitShift(Cell::FLAGGED_BIT);
+
+        // Bit `shift` of 8 consecutive cells, as one byte
+        std::uint64_t gatherBits(std::uint64_t cells, int shift) {
+            return (((cells >> shift) & LOW_BITS) * GATHER) >> 56;
+        }
+
+        // Byte b -> 8 bytes holding bit i of b in bit 0 of byte i
+        struct SpreadTable {
+            std::uint64_t values[256];
+
+            SpreadTable() {
+                for (int b = 0; b < 256; ++b) {
+                    values[b] = 0;
+                    for (int i = 0; i < 8; ++i) {
+                        if ((b >> i) & 1) {
+                            values[b] |= std::uint64_t(1) << (8 * i);
+                        }
+                    }
+                }
+            }
+        };
+
+        const SpreadTable& spreadTable() {
+            static const SpreadTable table;
+            return table;
+        }
+
+        template <typename Fn>
+        void forEachSetBit(const std::uint64_t* plane, size_t words, Fn&& fn) {
+            for (size_t w = 0; w < words; ++w) {
+                for (std::uint64_t word = plane[w]; word != 0; word &= word - 1) {
+                    fn(w * 64 + static_cast<size_t>(Bits::lowestBit(word)));
+                }
+            }
+        }
+    }
+
+    void Board::packPlanes(std::uint64_t* mines, std::uint64_t* revealed, std::uint64_t* flagged) const {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(cells_);
+        size_t words = getPlaneWordCount();
+        size_t fullWords = storageSize_ / 64;
+
+        for (size_t w = 0; w < fullWords; ++w) {
+            std::uint64_t m = 0, r = 0, f = 0;
+            for (int group = 0; group < 8; ++group) {
+                std::uint64_t chunk;
+                std::memcpy(&chunk, bytes + w * 64 + group * 8, sizeof(chunk));
+                m |= gatherBits(chunk, MINE_SHIFT) << (8 * group);
+                r |= gatherBits(chunk, REVEALED_SHIFT) << (8 * group);
+                f |= gatherBits(chunk, FLAGGED_SHIFT) << (8 * group);
+            }
+            mines[w] = m;
+            revealed[w] = r;
+            flagged[w] = f;
+        }
+
+        // Row-major boards end with a partial word
+        for (size_t w = fullWords; w < words; ++w) {
+            mines[w] = revealed[w] = flagged[w] = 0;
+            for (size_t i = w * 64; i < storageSize_; ++i) {
+                std::uint64_t bit = std::uint64_t(1) << (i & 63);
+                mines[w] |= cells_[i].hasMine() ? bit : 0;
+                revealed[w] |= cells_[i].isRevealed() ? bit : 0;
+                flagged[w] |= cells_[i].isFlagged() ? bit : 0;
+            }
+        }
+    }
+
+    // No bit may be set outside the board: past the last cell, or in the
+    // padding of the edge tiles (one tile is one word)
+    bool Board::planeFitsBoard(const std::uint64_t* plane) const {
+        size_t words = getPlaneWordCount();
+
+        if (layout_ == CellLayout::RowMajor) {
+            size_t tail = storageSize_ % 64;
+            return tail == 0 || (plane[words - 1] >> tail) == 0;
+        }
+
+        auto tileMask = [](int columns, int rows) {
+            std::uint64_t row = (std::uint64_t(1) << columns) - 1;
+            std::uint64_t mask = 0;
+            for (int r = 0; r < rows; ++r) {
+                mask |= row << (8 * r);
+            }
+            return mask;
+        };
+
+        size_t tileRows = words / tilesPerRow_;
+        int lastColumns = width_ & 7 ? width_ & 7 : 8;
+        int lastRows = height_ & 7 ? height_ & 7 : 8;
+        auto fits = [&](size_t tx, size_t ty) {
+            int columns = tx + 1 == tilesPerRow_ ? lastColumns : 8;
+            int rows = ty + 1 == tileRows ? lastRows : 8;
+            return (plane[ty * tilesPerRow_ + tx] & ~tileMask(columns, rows)) == 0;
+        };
+
+        for (size_t ty = 0; ty < tileRows; ++ty) {
+            if (!fits(tilesPerRow_ - 1, ty)) {
+                return false;
+            }
+        }
+        for (size_t tx = 0; tx < tilesPerRow_; ++tx) {
+            if (!fits(tx, tileRows - 1)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Revealed and flagged planes, before anything is touched: no bit
+    // outside the board and no flag on a revealed cell
+    bool Board::checkMarkPlanes(const std::uint64_t* revealed, const std::uint64_t* flagged,
+                                int& revealedTotal, int& flagTotal) const {
+        size_t words = getPlaneWordCount();
+        if (!planeFitsBoard(revealed) || !planeFitsBoard(flagged)) {
+            std::cerr << "Saved planes don't fit a " << width_ << "x" << height_ << " board" << std::endl;
+            return false;
+        }
+
+        revealedTotal = 0;
+        flagTotal = 0;
+        for (size_t w = 0; w < words; ++w) {
+            if (revealed[w] & flagged[w]) {
+                std::cerr << "Saved game has flags on revealed cells" << std::endl;
+                return false;
+            }
+            revealedTotal += Bits::popcount64(revealed[w]);
+            flagTotal += Bits::popcount64(flagged[w]);
+        }
+        return true;
+    }
+
+    // Bits go back 8 cells at a time, through the spread table
+    void Board::unpackPlane(const std::uint64_t* plane, int shift) {
+        unsigned char* bytes = reinterpret_cast<unsigned char*>(cells_);
+        const SpreadTable& spread = spreadTable();
+        size_t words = getPlaneWordCount();
+
+        for (size_t w = 0; w < words; ++w) {
+            if (plane[w] == 0) {
+                continue;
+            }
+            for (int group = 0; group < 8; ++group) {
+                unsigned byte = static_cast<unsigned>(plane[w] >> (8 * group)) & 0xFF;
+                if (byte == 0) {
+                    continue;
+                }
+                // planeFitsBoard() guarantees no bit past storageSize_
+                size_t first = w * 64 + group * 8;
+                size_t count = std::min<size_t>(8, storageSize_ - first);
+                std::uint64_t chunk = 0;
+                std::memcpy(&chunk, bytes + first, count);
+                chunk |= spread.values[byte] << shift;
+                std::memcpy(bytes + first, &chunk, count);
+            }
+        }
+    }
+
+    // Revealed and flagged cells go on top of the mines already in place,
+    // then the counters and the solved 3BV follow, in time proportional to
+    // the revealed and flagged cells
+    void Board::applyMarkPlanes(const std::uint64_t* revealed, const std::uint64_t* flagged,
+                                int revealedTotal, int flagTotal) {
+        size_t words = getPlaneWordCount();
+        unpackPlane(revealed, REVEALED_SHIFT);
+        unpackPlane(flagged, FLAGGED_SHIFT);
+        revealedCount_ = revealedTotal;
+        flagCount_ = flagTotal;
+
+        forEachSetBit(revealed, words, [this](size_t index) {
+            countSolvedBBBV(index, 1);
+        });
+        if (openingsReady_) {
+            forEachSetBit(flagged, words, [this](size_t index) {
+                if (isOpening(openingOf_[index])) {
+                    openingBlocked_[openingOf_[index]] = 1;
+                }
+            });
+        }
+
+        clearLastReveal();
+        markAllDirty();
+    }
+
+    bool Board::restorePlanes(const std::uint64_t* mines, const std::uint64_t* revealed,
+                              const std::uint64_t* flagged, bool initialized, std::uint64_t seed) {
+        size_t words = getPlaneWordCount();
+
+        // Validate everything before touching the board
+        int revealedTotal, flagTotal;
+        if (!planeFitsBoard(mines) || !checkMarkPlanes(revealed, flagged, revealedTotal, flagTotal)) {
+            return false;
+        }
+
+        int mineTotal = 0;
+        for (size_t w = 0; w < words; ++w) {
+            mineTotal += Bits::popcount64(mines[w]);
+        }
+        if (!initialized && (mineTotal != 0 || revealedTotal != 0)) {
+            std::cerr << "Saved game has mines or revealed cells before the first click" << std::endl;
+            return false;
+        }
+        if (initialized && mineTotal != mineCount_) {
+            std::cerr << "Saved game has " << mineTotal << " mines, expected " << mineCount_ << std::endl;
+            return false;
+        }
+
+        for (size_t i = 0; i < storageSize_; ++i) {
+            cells_[i].reset();
+        }
+        clearOpenings();
+        seed_ = seed;
+        isInitialized_ = initialized;
+
+        if (initialized) {
+            unpackPlane(mines, MINE_SHIFT);
+            calculateAdjacentMines();
+            computeOpenings();
+        }
+        applyMarkPlanes(revealed, flagged, revealedTotal, flagTotal);
+        return true;
+    }
+
+    bool Board::restoreMarks(const std::uint64_t* revealed, const std::uint64_t* flagged) {
+        int revealedTotal, flagTotal;
+        if (!checkMarkPlanes(revealed, flagged, revealedTotal, flagTotal)) {
+            return false;
+        }
+
+        // Keep the mines, counts and openings
+        unsigned char* bytes = reinterpret_cast<unsigned char*>(cells_);
+        const unsigned char keep = static_cast<unsigned char>(~(Cell::REVEALED_BIT | Cell::FLAGGED_BIT));
+        for (size_t i = 0; i < storageSize_; ++i) {
+            bytes[i] &= keep;
+        }
+        std::fill(openingRevealed_.begin(), openingRevealed_.end(), 0);
+        std::fill(openingBlocked_.begin(), openingBlocked_.end(), 0);
+        solvedBBBV_ = 0;
+
+        applyMarkPlanes(revealed, flagged, revealedTotal, flagTotal);
+        return true;
+    }
+}
@@ -6,21 +6,18 @@ namespace Minesweeper {
     }
 
     void Cell::toggleFlag() {
-        if (!isRevealed_) {
-            isFlagged_ = !isFlagged_;
+        if (!isRevealed()) {
+            setFlagged(!isFlagged());
         }
     }
 
     void Cell::reveal() {
-        if (!isFlagged_) {
-            isRevealed_ = true;
+        if (!isFlagged()) {
+            setRevealed(true);
         }
     }
 
     void Cell::reset() {
-        hasMine_ = false;
-        isRevealed_ = false;
-        isFlagged_ = false;
-        adjacentMines_ = 0;
+        bits_ = 0;
     }
 }
@@ -0,0 +1,192 @@
+#include "../../include/Logic/ChunkedBoard.hpp"
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <utility>
+
+namespace Minesweeper {
+    ChunkedBoard::ChunkedBoard(std::uint64_t seed, float mineDensity)
+        : seed_(seed),
+          mineDensity_(std::clamp(mineDensity, MIN_MINE_DENSITY, MAX_MINE_DENSITY)) {
+        mineThreshold_ = static_cast<std::uint64_t>(std::ldexp(static_cast<double>(mineDensity_), 64));
+    }
+
+    void ChunkedBoard::reset(std::uint64_t seed) {
+        seed_ = seed;
+        chunks_.clear();
+        revealedCount_ = 0;
+        flagCount_ = 0;
+    }
+
+    // splitmix64 finalizer over the seed and both coordinates
+    std::uint64_t ChunkedBoard::hashCell(std::uint64_t seed, int x, int y) {
+        std::uint64_t h = seed ^ (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32
+                                  | static_cast<std::uint32_t>(y));
+        h += 0x9E3779B97F4A7C15ULL;
+        h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+        return h ^ (h >> 31);
+    }
+
+    bool ChunkedBoard::isMine(int x, int y) const {
+        // The 3x3 area around the origin is always safe: the first click
+        // of an endless game is expected there
+        if (x >= -1 && x <= 1 && y >= -1 && y <= 1) {
+            return false;
+        }
+        return hashCell(seed_, x, y) < mineThreshold_;
+    }
+
+    int ChunkedBoard::countAdjacentMines(int x, int y) const {
+        int count = 0;
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                if ((dx != 0 || dy != 0) && isMine(x + dx, y + dy)) {
+                    count++;
+                }
+            }
+        }
+        return count;
+    }
+
+    // Floor division so negative coordinates map to the right chunk
+    int ChunkedBoard::chunkCoord(int v) {
+        return v >= 0 ? v / CHUNK_SIZE : -((-v - 1) / CHUNK_SIZE) - 1;
+    }
+
+    int ChunkedBoard::localCoord(int v) {
+        return v - chunkCoord(v) * CHUNK_SIZE;
+    }
+
+    std::uint64_t ChunkedBoard::chunkKey(int chunkX, int chunkY) {
+        return static_cast<std::uint64_t>(static_cast<std::uint32_t>(chunkX)) << 32
+             | static_cast<std::uint32_t>(chunkY);
+    }
+
+    void ChunkedBoard::generateChunk(Chunk& chunk, int chunkX, int chunkY) const {
+        chunk.cells.resize(CHUNK_SIZE * CHUNK_SIZE);
+        
+        int originX = chunkX * CHUNK_SIZE;
+        int originY = chunkY * CHUNK_SIZE;
+        for (int ly = 0; ly < CHUNK_SIZE; ++ly) {
+            for (int lx = 0; lx < CHUNK_SIZE; ++lx) {
+                Cell& cell = chunk.cells[ly * CHUNK_SIZE + lx];
+                int x = originX + lx;
+                int y = originY + ly;
+                
+                // Neighbors in other chunks come from the hash too, so no
+                // neighbor chunk has to exist
+                cell.setMine(isMine(x, y));
+                if (!cell.hasMine()) {
+                    cell.setAdjacentMines(countAdjacentMines(x, y));
+                }
+            }
+        }
+    }
+
+    ChunkedBoard::Chunk& ChunkedBoard::getChunk(int chunkX, int chunkY) {
+        std::unique_ptr<Chunk>& slot = chunks_[chunkKey(chunkX, chunkY)];
+        if (!slot) {
+            slot = std::make_unique<Chunk>();
+            generateChunk(*slot, chunkX, chunkY);
+        }
+        return *slot;
+    }
+
+    Cell& ChunkedBoard::cellAt(int x, int y, Chunk** owner) {
+        Chunk& chunk = getChunk(chunkCoord(x), chunkCoord(y));
+        if (owner) {
+            *owner = &chunk;
+        }
+        return chunk.cells[localCoord(y) * CHUNK_SIZE + localCoord(x)];
+    }
+
+    const Cell& ChunkedBoard::getCell(int x, int y) {
+        return cellAt(x, y);
+    }
+
+    bool ChunkedBoard::revealCell(int x, int y) {
+        Chunk* chunk = nullptr;
+        Cell& cell = cellAt(x, y, &chunk);
+        
+        if (cell.isRevealed() || cell.isFlagged()) {
+            return false;
+        }
+        
+        cell.reveal();
+        chunk->revealed++;
+        revealedCount_++;
+        
+        if (cell.hasMine()) {
+            return true; // Game over
+        }
+        
+        if (cell.getAdjacentMines() == 0) {
+            revealEmptyCells(x, y);
+        }
+        
+        return false;
+    }
+
+    // Plain sequential BFS on global coordinates. Board's level-parallel
+    // fill works on storage indices of a bounded board, so it doesn't apply;
+    // chunked_test checks both reveal the same cells for the same mines.
+    void ChunkedBoard::revealEmptyCells(int x, int y) {
+        std::queue<std::pair<int, int>> cellsToCheck;
+        cellsToCheck.emplace(x, y);
+        
+        static const int dx[] = {-1, 0, 1, -1, 1, -1, 0, 1};
+        static const int dy[] = {-1, -1, -1, 0, 0, 1, 1, 1};
+        
+        while (!cellsToCheck.empty()) {
+            auto [currentX, currentY] = cellsToCheck.front();
+            cellsToCheck.pop();
+            
+            for (int i = 0; i < 8; ++i) {
+                int nx = currentX + dx[i];
+                int ny = currentY + dy[i];
+                
+                // May cross into a chunk that does not exist yet
+                Chunk* chunk = nullptr;
+                Cell& neighbor = cellAt(nx, ny, &chunk);
+                
+                if (!neighbor.isRevealed() && !neighbor.isFlagged() && !neighbor.hasMine()) {
+                    neighbor.reveal();
+                    chunk->revealed++;
+                    revealedCount_++;
+                    
+                    if (neighbor.getAdjacentMines() == 0) {
+                        cellsToCheck.emplace(nx, ny);
+                    }
+                }
+            }
+        }
+    }
+
+    void ChunkedBoard::toggleFlag(int x, int y) {
+        Chunk* chunk = nullptr;
+        Cell& cell = cellAt(x, y, &chunk);
+        bool wasFlagged = cell.isFlagged();
+        cell.toggleFlag();
+        int delta = static_cast<int>(cell.isFlagged()) - static_cast<int>(wasFlagged);
+        chunk->flagged += delta;
+        flagCount_ += delta;
+    }
+
+    void ChunkedBoard::evictChunks(int x, int y, int keepRadius) {
+        int centerX = chunkCoord(x);
+        int centerY = chunkCoord(y);
+        
+        for (auto it = chunks_.begin(); it != chunks_.end(); ) {
+            int chunkX = static_cast<std::int32_t>(static_cast<std::uint32_t>(it->first >> 32));
+            int chunkY = static_cast<std::int32_t>(static_cast<std::uint32_t>(it->first));
+            int distance = std::max(std::abs(chunkX - centerX), std::abs(chunkY - centerY));
+            
+            if (distance > keepRadius && !it->second->hasPlayerState()) {
+                it = chunks_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
@@ -0,0 +1,263 @@
+#include "../../include/Logic/EliminationSolver.hpp"
+#include "../../include/Logic/Bits.hpp"
+#include "../../include/Logic/Solver.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace Minesweeper {
+    namespace {
+        // Rows sum(plus) - sum(minus) = rhs over 0/1 columns, each row two
+        // bitsets of words_ words. Words outside [low, high) are zero.
+        class LinearSystem {
+        public:
+            explicit LinearSystem(size_t columns)
+                : columns_(columns), words_((columns + 63) / 64),
+                  known_(words_, 0), mine_(words_, 0) {}
+
+            void addRow(const std::uint32_t* columns, size_t count, int rhs) {
+                size_t row = rhs_.size();
+                plus_.resize(plus_.size() + words_, 0);
+                minus_.resize(minus_.size() + words_, 0);
+                rhs_.push_back(rhs);
+                size_t low = words_, high = 0;
+                for (size_t i = 0; i < count; ++i) {
+                    size_t word = columns[i] >> 6;
+                    plus(row)[word] |= std::uint64_t(1) << (columns[i] & 63);
+                    low = std::min(low, word);
+                    high = std::max(high, word + 1);
+                }
+                low_.push_back(static_cast<std::uint32_t>(std::min(low, high)));
+                high_.push_back(static_cast<std::uint32_t>(high));
+            }
+
+            // Reduced row echelon form, as far as coefficients stay in
+            // {-1, 0, +1}
+            void reduce() {
+                size_t rows = rhs_.size();
+                size_t rank = 0;
+                for (size_t column = 0; column < columns_ && rank < rows; ++column) {
+                    size_t word = column >> 6;
+                    std::uint64_t bit = std::uint64_t(1) << (column & 63);
+                    size_t pivot = rank;
+                    while (pivot < rows && !((plus(pivot)[word] | minus(pivot)[word]) & bit)) {
+                        pivot++;
+                    }
+                    if (pivot == rows) {
+                        continue;
+                    }
+                    swapRows(pivot, rank);
+                    if (minus(rank)[word] & bit) {
+                        negate(rank);
+                    }
+                    for (size_t row = 0; row < rows; ++row) {
+                        if (row == rank) {
+                            continue;
+                        }
+                        if (plus(row)[word] & bit) {
+                            combine(row, rank, true);
+                        } else if (minus(row)[word] & bit) {
+                            combine(row, rank, false);
+                        }
+                    }
+                    rank++;
+                }
+            }
+
+            // Bound reasoning on every row, with the columns proven so far
+            // taken out, until a pass proves nothing; false when a row
+            // can't be met
+            bool propagate() {
+                bool changed = true;
+                while (changed) {
+                    changed = false;
+                    for (size_t row = 0; row < rhs_.size(); ++row) {
+                        int plusCount = 0, minusCount = 0;
+                        int rhs = rhs_[row];
+                        const std::uint64_t* p = plus(row);
+                        const std::uint64_t* n = minus(row);
+                        for (size_t k = low_[row]; k < high_[row]; ++k) {
+                            plusCount += Bits::popcount64(p[k] & ~known_[k]);
+                            minusCount += Bits::popcount64(n[k] & ~known_[k]);
+                            rhs -= Bits::popcount64(p[k] & mine_[k]);
+                            rhs += Bits::popcount64(n[k] & mine_[k]);
+                        }
+                        if (rhs > plusCount || rhs < -minusCount) {
+                            return false;
+                        }
+                        if (plusCount + minusCount == 0 || (rhs != plusCount && rhs != -minusCount)) {
+                            continue;
+                        }
+                        // All of plus mines and minus safe, or the reverse
+                        bool plusMines = rhs == plusCount;
+                        for (size_t k = low_[row]; k < high_[row]; ++k) {
+                            std::uint64_t mines = (plusMines ? p[k] : n[k]) & ~known_[k];
+                            known_[k] |= p[k] | n[k];
+                            mine_[k] |= mines;
+                        }
+                        changed = true;
+                    }
+                }
+                return true;
+            }
+
+            bool isKnown(size_t column) const { return (known_[column >> 6] >> (column & 63)) & 1; }
+            bool isMine(size_t column) const { return (mine_[column >> 6] >> (column & 63)) & 1; }
+
+        private:
+            size_t columns_;
+            size_t words_;
+            std::vector<std::uint64_t> plus_;
+            std::vector<std::uint64_t> minus_;
+            std::vector<int> rhs_;
+            std::vector<std::uint32_t> low_;
+            std::vector<std::uint32_t> high_;
+            std::vector<std::uint64_t> known_; // columns proven
+            std::vector<std::uint64_t> mine_;  // and which are mines
+
+            std::uint64_t* plus(size_t row) { return plus_.data() + row * words_; }
+            std::uint64_t* minus(size_t row) { return minus_.data() + row * words_; }
+
+            void swapRows(size_t a, size_t b) {
+                if (a == b) {
+                    return;
+                }
+                std::swap_ranges(plus(a), plus(a) + words_, plus(b));
+                std::swap_ranges(minus(a), minus(a) + words_, minus(b));
+                std::swap(rhs_[a], rhs_[b]);
+                std::swap(low_[a], low_[b]);
+                std::swap(high_[a], high_[b]);
+            }
+
+            void negate(size_t row) {
+                std::swap_ranges(plus(row), plus(row) + words_, minus(row));
+                rhs_[row] = -rhs_[row];
+            }
+
+            // row - pivot (or row + pivot), the pivot's coefficient being +1.
+            // A column at +1 in the row and in what is added would reach 2:
+            // the row is then left as it is.
+            void combine(size_t row, size_t pivot, bool subtract) {
+                std::uint64_t* p = plus(row);
+                std::uint64_t* n = minus(row);
+                const std::uint64_t* add = subtract ? minus(pivot) : plus(pivot);
+                const std::uint64_t* take = subtract ? plus(pivot) : minus(pivot);
+                size_t low = low_[pivot], high = high_[pivot];
+                for (size_t k = low; k < high; ++k) {
+                    if ((p[k] & add[k]) | (n[k] & take[k])) {
+                        return;
+                    }
+                }
+                for (size_t k = low; k < high; ++k) {
+                    std::uint64_t x = p[k] ^ add[k];
+                    std::uint64_t y = n[k] ^ take[k];
+                    p[k] = x & ~y;
+                    n[k] = y & ~x;
+                }
+                rhs_[row] += subtract ? -rhs_[pivot] : rhs_[pivot];
+                low_[row] = std::min(low_[row], low_[pivot]);
+                high_[row] = std::max(high_[row], high_[pivot]);
+            }
+        };
+    }
+
+    bool EliminationSolver::deduce(const Solver& solver, std::vector<std::uint32_t>& safe,
+                                   std::vector<std::uint32_t>& mines) {
+        frontier_.build(solver);
+        const std::vector<Frontier::Component>& components = frontier_.getComponents();
+        int minesLeft = solver.getMineCount() - static_cast<int>(solver.getKnownMineCount());
+
+        // Endgame: one system, the mine count tying everything together
+        if (solver.getUnknownCount() <= MAX_GLOBAL_CELLS) {
+            std::vector<const Frontier::Component*> parts;
+            for (const Frontier::Component& component : components) {
+                parts.push_back(&component);
+            }
+            std::vector<std::uint32_t> interior;
+            size_t cellCount = static_cast<size_t>(solver.getWidth()) * solver.getHeight();
+            for (size_t cell = 0; cell < cellCount; ++cell) {
+                std::uint32_t index = static_cast<std::uint32_t>(cell);
+                if (solver.isUnknown(index) && frontier_.getVariable(index) < 0) {
+                    interior.push_back(index);
+                }
+            }
+            return deduceSystem(parts, interior, minesLeft, safe, mines);
+        }
+
+        const std::vector<std::uint32_t> noInterior;
+        for (const Frontier::Component& component : components) {
+            if (component.variables.size() <= MAX_COMPONENT_CELLS &&
+                !deduceSystem({&component}, noInterior, -1, safe, mines)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Columns: the parts' variables in their order, then the interior
+    // cells; the mine count is a row when minesLeft >= 0
+    bool EliminationSolver::deduceSystem(const std::vector<const Frontier::Component*>& parts,
+                                         const std::vector<std::uint32_t>& interior, int minesLeft,
+                                         std::vector<std::uint32_t>& safe,
+                                         std::vector<std::uint32_t>& mines) const {
+        std::vector<std::uint32_t> cells;
+        std::vector<std::uint32_t> offsets;
+        for (const Frontier::Component* part : parts) {
+            offsets.push_back(static_cast<std::uint32_t>(cells.size()));
+            for (std::uint32_t variable : part->variables) {
+                cells.push_back(frontier_.getCell(variable));
+            }
+        }
+        cells.insert(cells.end(), interior.begin(), interior.end());
+
+        LinearSystem system(cells.size());
+        std::uint32_t columns[8];
+        for (size_t i = 0; i < parts.size(); ++i) {
+            for (std::uint32_t c : parts[i]->constraints) {
+                const Frontier::Constraint& constraint = frontier_.getConstraints()[c];
+                const std::uint32_t* variables = frontier_.getVariables(constraint);
+                for (std::uint32_t j = 0; j < constraint.count; ++j) {
+                    columns[j] = offsets[i] + frontier_.getPosition(variables[j]);
+                }
+                system.addRow(columns, constraint.count, constraint.need);
+            }
+        }
+        if (minesLeft >= 0) {
+            std::vector<std::uint32_t> all(cells.size());
+            for (size_t i = 0; i < all.size(); ++i) {
+                all[i] = static_cast<std::uint32_t>(i);
+            }
+            system.addRow(all.data(), all.size(), minesLeft);
+        }
+
+        system.reduce();
+        if (!system.propagate()) {
+            return false;
+        }
+        for (size_t column = 0; column < cells.size(); ++column) {
+            if (system.isKnown(column)) {
+                (system.isMine(column) ? mines : safe).push_back(cells[column]);
+            }
+        }
+        return true;
+    }
+
+    bool EliminationSolver::solve(Solver& solver) {
+        while (solver.solve()) {
+            safe_.clear();
+            mines_.clear();
+            if (!deduce(solver, safe_, mines_)) {
+                return false;
+            }
+            if (safe_.empty() && mines_.empty()) {
+                return true;
+            }
+            for (std::uint32_t cell : safe_) {
+                solver.setDeduced(cell, false);
+            }
+            for (std::uint32_t cell : mines_) {
+                solver.setDeduced(cell, true);
+            }
+        }
+        return false;
+    }
+}
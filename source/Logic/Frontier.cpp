@@ -0,0 +1,120 @@
+#include "../../include/Logic/Frontier.hpp"
+#include "../../include/Logic/Solver.hpp"
+
+namespace Minesweeper {
+    void Frontier::build(const Solver& solver) {
+        collect(solver);
+        splitComponents();
+    }
+
+    void Frontier::collect(const Solver& solver) {
+        size_t cellCount = static_cast<size_t>(solver.getWidth()) * solver.getHeight();
+        if (variableOf_.size() != cellCount) {
+            variableOf_.assign(cellCount, -1);
+        } else {
+            for (std::uint32_t cell : cells_) {
+                variableOf_[cell] = -1;
+            }
+        }
+        cells_.clear();
+        constraints_.clear();
+        constraintVariables_.clear();
+
+        solver.forEachConstraint([this](std::uint32_t, int need, const std::uint32_t* unknown, int count) {
+            constraints_.push_back({need, static_cast<std::uint32_t>(constraintVariables_.size()),
+                                    static_cast<std::uint32_t>(count)});
+            for (int i = 0; i < count; ++i) {
+                std::int32_t& variable = variableOf_[unknown[i]];
+                if (variable < 0) {
+                    variable = static_cast<std::int32_t>(cells_.size());
+                    cells_.push_back(unknown[i]);
+                }
+                constraintVariables_.push_back(static_cast<std::uint32_t>(variable));
+            }
+        });
+    }
+
+    // Union-find over the variables sharing a constraint, then each
+    // component ordered breadth-first from its least constrained variable,
+    // so constraints close soon after they open
+    void Frontier::splitComponents() {
+        size_t variableCount = cells_.size();
+
+        variableConstraintStarts_.assign(variableCount + 1, 0);
+        for (std::uint32_t variable : constraintVariables_) {
+            variableConstraintStarts_[variable + 1]++;
+        }
+        for (size_t v = 0; v < variableCount; ++v) {
+            variableConstraintStarts_[v + 1] += variableConstraintStarts_[v];
+        }
+        variableConstraints_.resize(constraintVariables_.size());
+        std::vector<std::uint32_t> fill(variableConstraintStarts_.begin(), variableConstraintStarts_.end() - 1);
+        for (size_t c = 0; c < constraints_.size(); ++c) {
+            for (std::uint32_t i = 0; i < constraints_[c].count; ++i) {
+                variableConstraints_[fill[constraintVariables_[constraints_[c].first + i]]++] = static_cast<std::uint32_t>(c);
+            }
+        }
+
+        std::vector<std::uint32_t> parent(variableCount);
+        for (size_t v = 0; v < variableCount; ++v) {
+            parent[v] = static_cast<std::uint32_t>(v);
+        }
+        auto find = [&parent](std::uint32_t v) {
+            while (parent[v] != v) {
+                parent[v] = parent[parent[v]];
+                v = parent[v];
+            }
+            return v;
+        };
+        for (const Constraint& constraint : constraints_) {
+            std::uint32_t root = find(constraintVariables_[constraint.first]);
+            for (std::uint32_t i = 1; i < constraint.count; ++i) {
+                std::uint32_t other = find(constraintVariables_[constraint.first + i]);
+                if (other != root) {
+                    parent[other] = root;
+                }
+            }
+        }
+
+        components_.clear();
+        std::vector<std::int32_t> componentOf(variableCount, -1);
+        std::vector<std::uint32_t> start;
+        for (size_t v = 0; v < variableCount; ++v) {
+            std::uint32_t root = find(static_cast<std::uint32_t>(v));
+            if (componentOf[root] < 0) {
+                componentOf[root] = static_cast<std::int32_t>(components_.size());
+                components_.emplace_back();
+                start.push_back(static_cast<std::uint32_t>(v));
+            }
+            std::uint32_t degree = variableConstraintStarts_[v + 1] - variableConstraintStarts_[v];
+            std::uint32_t& best = start[componentOf[root]];
+            if (degree < variableConstraintStarts_[best + 1] - variableConstraintStarts_[best]) {
+                best = static_cast<std::uint32_t>(v);
+            }
+        }
+        for (size_t c = 0; c < constraints_.size(); ++c) {
+            std::uint32_t root = find(constraintVariables_[constraints_[c].first]);
+            components_[componentOf[root]].constraints.push_back(static_cast<std::uint32_t>(c));
+        }
+
+        positionOf_.assign(variableCount, UINT32_MAX);
+        for (size_t c = 0; c < components_.size(); ++c) {
+            std::vector<std::uint32_t>& order = components_[c].variables;
+            order.push_back(start[c]);
+            positionOf_[start[c]] = 0;
+            for (size_t head = 0; head < order.size(); ++head) {
+                std::uint32_t v = order[head];
+                for (std::uint32_t i = variableConstraintStarts_[v]; i < variableConstraintStarts_[v + 1]; ++i) {
+                    const Constraint& constraint = constraints_[variableConstraints_[i]];
+                    for (std::uint32_t j = 0; j < constraint.count; ++j) {
+                        std::uint32_t w = constraintVariables_[constraint.first + j];
+                        if (positionOf_[w] == UINT32_MAX) {
+                            positionOf_[w] = static_cast<std::uint32_t>(order.size());
+                            order.push_back(w);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,60 @@
+#include "../../include/Logic/GameClock.hpp"
+
+namespace Minesweeper {
+    void GameClock::reset() {
+        accumulated_ = Clock::duration::zero();
+        running_ = false;
+        paused_ = false;
+    }
+
+    void GameClock::start() {
+        reset();
+        startTime_ = Clock::now();
+        running_ = true;
+    }
+
+    void GameClock::stop() {
+        if (isRunning()) {
+            accumulated_ += Clock::now() - startTime_;
+        }
+        running_ = false;
+        paused_ = false;
+    }
+
+    void GameClock::pause() {
+        if (isRunning()) {
+            accumulated_ += Clock::now() - startTime_;
+            paused_ = true;
+        }
+    }
+
+    void GameClock::resume() {
+        if (running_ && paused_) {
+            startTime_ = Clock::now();
+            paused_ = false;
+        }
+    }
+
+    void GameClock::continueAfterStop() {
+        if (!running_) {
+            startTime_ = Clock::now();
+            running_ = true;
+            paused_ = false;
+        }
+    }
+
+    void GameClock::restore(std::int64_t elapsedMilliseconds, bool running) {
+        accumulated_ = std::chrono::duration_cast<Clock::duration>(std::chrono::milliseconds(elapsedMilliseconds));
+        startTime_ = Clock::now();
+        running_ = running;
+        paused_ = false;
+    }
+
+    std::int64_t GameClock::getElapsedMilliseconds() const {
+        Clock::duration elapsed = accumulated_;
+        if (isRunning()) {
+            elapsed += Clock::now() - startTime_;
+        }
+        return std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+    }
+}
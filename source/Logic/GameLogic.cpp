@@ -1,17 +1,77 @@
 #include "../../include/Logic/GameLogic.hpp"
+#include "../../include/Logic/NoGuessGenerator.hpp"
+#include "../../include/Logic/Random.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <iostream>
 
 namespace Minesweeper {
+    namespace {
+        // FNV-1a, one 64-bit word at a time
+        std::uint64_t planeChecksum(const std::uint64_t* words, size_t count) {
+            std::uint64_t hash = 0xCBF29CE484222325ull;
+            for (size_t i = 0; i < count; ++i) {
+                hash = (hash ^ words[i]) * 0x100000001B3ull;
+            }
+            return hash;
+        }
+        
+        bool checkSaveHeader(const SaveFileHeader& header, const std::string& path) {
+            if (std::memcmp(header.magic, SaveFile::MAGIC, sizeof(header.magic)) != 0 ||
+                header.version != SaveFile::VERSION ||
+                header.headerSize != sizeof(SaveFileHeader) ||
+                header.planeCount != SaveFile::PLANE_COUNT ||
+                header.gameState > static_cast<std::uint8_t>(Config::GameState::LOST)) {
+                std::cerr << path << ": unsupported or corrupted save file" << std::endl;
+                return false;
+            }
+            return true;
+        }
+    }
+
     GameLogic::GameLogic() {
         board_ = std::make_shared<Board>();
+        startNewGame();
+    }
+
+    GameLogic::GameLogic(const Config::DifficultySettings& settings, CellLayout layout) {
+        board_ = std::make_shared<Board>(settings.width, settings.height, settings.mines, layout);
+        startNewGame();
+    }
+
+    bool GameLogic::resizeBoard(const Config::DifficultySettings& settings) {
+        if (!board_->resize(settings.width, settings.height, settings.mines)) {
+            return false;
+        }
+        startNewGame();
+        return true;
     }
 
     void GameLogic::startNewGame() {
-        board_->reset();
+        startNewGame(Random::makeSeed());
+    }
+
+    void GameLogic::startNewGame(std::uint64_t seed) {
+        board_->reset(seed);
         gameState_ = Config::GameState::PLAYING;
-        elapsedTime_ = 0.0f;
-        gameTime_ = 0;
+        gameClock_.reset();
         firstClick_ = true;
+        boardFixed_ = false;
+        clickCount_ = 0;
+        journal_.clear();
+        solver_.invalidate();
+        replay_.begin(board_->getWidth(), board_->getHeight(), board_->getMineCount(), board_->getSeed());
+        replayValid_ = true;
+    }
+
+    void GameLogic::startReplayedGame(std::uint64_t seed, int originX, int originY) {
+        startNewGame(seed);
+        if (originX >= 0) {
+            board_->setOrigin(originX, originY);
+            replay_.setOrigin(originX, originY);
+        }
+        boardFixed_ = true;
     }
 
     void GameLogic::handleLeftClick(int x, int y) {
@@ -19,22 +79,51 @@ namespace Minesweeper {
             return;
         }
         
+        const Cell& cell = board_->getCell(x, y);
+        if (cell.isFlagged() || cell.isRevealed()) {
+            return; // before the mines are laid: the replay only sees clicks that count
+        }
+        
         if (firstClick_) {
-            board_->initialize(x, y);
+            PooledBoard pooled;
+            if (!boardFixed_ && boardPool_ &&
+                boardPool_->take(board_->getWidth(), board_->getHeight(), board_->getMineCount(),
+                                 noGuess_, x, y, pooled)) {
+                board_->setSeed(pooled.seed);
+                board_->setOrigin(pooled.originX, pooled.originY);
+                replay_.setSeed(pooled.seed);
+                replay_.setOrigin(pooled.originX, pooled.originY);
+                board_->initialize(x, y, pooled.mines.data());
+            } else {
+                // Nothing pooled: searched now, within the click's budget.
+                // Out of time, the game's own seed gives an ordinary board.
+                std::uint64_t seed;
+                if (noGuess_ && !boardFixed_ &&
+                    NoGuessGenerator::findSeed(board_->getWidth(), board_->getHeight(), board_->getMineCount(),
+                                               x, y, board_->getSeed(), seed)) {
+                    board_->setSeed(seed);
+                    replay_.setSeed(seed);
+                }
+                board_->initialize(x, y);
+            }
+            gameClock_.start();
             firstClick_ = false;
         }
         
-        Cell& cell = board_->getCell(x, y);
+        clickCount_++;
+        std::uint64_t serial = board_->getRevealSerial();
+        int revealed = board_->getRevealedCount();
+        bool hitMine = board_->revealCell(x, y);
         
-        if (!cell.isFlagged()) {
-            bool hitMine = board_->revealCell(x, y);
-            
-            if (hitMine) {
-                gameState_ = Config::GameState::LOST;
-            } else if (board_->checkWin()) {
-                gameState_ = Config::GameState::WON;
-            }
+        if (hitMine) {
+            gameState_ = Config::GameState::LOST;
+            gameClock_.stop();
+        } else if (board_->checkWin()) {
+            gameState_ = Config::GameState::WON;
+            gameClock_.stop();
         }
+        recordMove(MoveJournal::MoveType::Reveal, x, y, serial, revealed);
+        recordReplayEvent(ReplayAction::Reveal, x, y);
     }
 
     void GameLogic::handleRightClick(int x, int y) {
@@ -45,30 +134,331 @@ namespace Minesweeper {
         Cell& cell = board_->getCell(x, y);
         
         if (!cell.isRevealed()) {
+            clickCount_++;
             board_->toggleFlag(x, y);
             
             // Check win condition after flagging
             if (board_->checkWin()) {
                 gameState_ = Config::GameState::WON;
+                gameClock_.stop();
             }
+            recordMove(MoveJournal::MoveType::Flag, x, y, 0, 0);
+            recordReplayEvent(ReplayAction::Flag, x, y);
         }
     }
 
-    bool GameLogic::isGameOver() const {
-        return gameState_ == Config::GameState::LOST;
+    void GameLogic::handleChord(int x, int y) {
+        if (gameState_ != Config::GameState::PLAYING || firstClick_ || !board_->isCellValid(x, y)) {
+            return;
+        }
+        
+        std::uint64_t serial = board_->getRevealSerial();
+        int revealedBefore = board_->getRevealedCount();
+        bool hitMine = board_->chordCell(x, y);
+        if (board_->getRevealedCount() == revealedBefore) {
+            return; // wrong flag count, nothing happened
+        }
+        clickCount_++;
+        
+        // One check for the whole batch
+        if (hitMine) {
+            gameState_ = Config::GameState::LOST;
+            gameClock_.stop();
+        } else if (board_->checkWin()) {
+            gameState_ = Config::GameState::WON;
+            gameClock_.stop();
+        }
+        recordMove(MoveJournal::MoveType::Chord, x, y, serial, revealedBefore);
+        recordReplayEvent(ReplayAction::Chord, x, y);
     }
 
-    bool GameLogic::isGameWon() const {
-        return gameState_ == Config::GameState::WON;
+    // The changed cells are read back from the board: the reveal trace when
+    // a cascade ran (it lists exactly the cells it revealed), else the cell
+    // itself
+    void GameLogic::recordMove(MoveJournal::MoveType type, int x, int y,
+                               std::uint64_t revealSerial, int revealedCount) {
+        const size_t* cells;
+        size_t count;
+        size_t index = board_->cellIndex(x, y);
+        if (type != MoveJournal::MoveType::Flag && board_->getRevealSerial() != revealSerial) {
+            const RevealTrace& trace = board_->getLastReveal();
+            cells = trace.cells.data();
+            count = trace.cells.size();
+        } else if (type == MoveJournal::MoveType::Flag || board_->getRevealedCount() != revealedCount) {
+            cells = &index;
+            count = 1;
+        } else {
+            return;
+        }
+        
+        if (solver_.isAttached()) {
+            for (size_t i = 0; i < count; ++i) {
+                solver_.cellChanged(cells[i]);
+            }
+        }
+        if (board_->getStorageSize() <= UINT32_MAX) { // else indices don't fit the journal
+            journal_.record(type, static_cast<std::uint8_t>(gameState_), cells, count);
+        }
+    }
+
+    bool GameLogic::undo() {
+        const MoveJournal::Move* move = journal_.undo();
+        if (!move) {
+            return false;
+        }
+        
+        if (move->type == MoveJournal::MoveType::Flag) {
+            journal_.forEachCell(*move, [this](std::uint32_t index) { board_->toggleCellFlag(index); });
+        } else {
+            journal_.forEachCell(*move, [this](std::uint32_t index) { board_->setCellRevealed(index, false); });
+        }
+        board_->clearLastReveal();
+        updateSolver(*move);
+        
+        // Every move was played during the game: undoing the last one
+        // brings a lost or won game back to life
+        if (gameState_ != Config::GameState::PLAYING) {
+            gameState_ = Config::GameState::PLAYING;
+            gameClock_.continueAfterStop();
+        }
+        recordReplayEvent(ReplayAction::Undo, 0, 0);
+        return true;
+    }
+
+    bool GameLogic::redo() {
+        const MoveJournal::Move* move = journal_.redo();
+        if (!move) {
+            return false;
+        }
+        
+        if (move->type == MoveJournal::MoveType::Flag) {
+            journal_.forEachCell(*move, [this](std::uint32_t index) { board_->toggleCellFlag(index); });
+        } else {
+            journal_.forEachCell(*move, [this](std::uint32_t index) { board_->setCellRevealed(index, true); });
+        }
+        board_->clearLastReveal();
+        updateSolver(*move);
+        
+        gameState_ = static_cast<Config::GameState>(move->outcome);
+        if (gameState_ != Config::GameState::PLAYING) {
+            gameClock_.stop();
+        }
+        recordReplayEvent(ReplayAction::Redo, 0, 0);
+        return true;
+    }
+
+    bool GameLogic::rewindTo(size_t moveNumber) {
+        while (journal_.getMoveNumber() > moveNumber && undo()) {
+        }
+        while (journal_.getMoveNumber() < moveNumber && redo()) {
+        }
+        return journal_.getMoveNumber() == moveNumber;
     }
 
-    void GameLogic::update(float deltaTime) {
-        if (gameState_ == Config::GameState::PLAYING && !firstClick_) {
-            elapsedTime_ += deltaTime;
-            if (elapsedTime_ >= 1.0f) {
-                gameTime_++;
-                elapsedTime_ -= 1.0f;
+    void GameLogic::updateSolver(const MoveJournal::Move& move) {
+        if (solver_.isAttached()) {
+            journal_.forEachCell(move, [this](std::uint32_t index) { solver_.cellChanged(index); });
+        }
+    }
+
+    Solver& GameLogic::getSolver() {
+        if (!solver_.isAttached()) {
+            solver_.attach(*board_);
+        }
+        return solver_;
+    }
+
+    void GameLogic::recordReplayEvent(ReplayAction action, int x, int y) {
+        if (recordingReplay_) {
+            replay_.addEvent(action, x, y, gameClock_.getElapsedMilliseconds());
+        }
+    }
+
+    void GameLogic::showReplayFrame(Config::GameState state, int clickCount, std::int64_t elapsedMilliseconds) {
+        gameState_ = state;
+        clickCount_ = clickCount;
+        firstClick_ = false;
+        solver_.invalidate(); // the board was set from outside
+        gameClock_.restore(elapsedMilliseconds, false);
+    }
+
+    ReplayResult GameLogic::getReplayResult() const {
+        ReplayResult result;
+        result.gameState = static_cast<std::uint8_t>(gameState_);
+        result.elapsedMilliseconds = static_cast<std::uint64_t>(gameClock_.getElapsedMilliseconds());
+        result.clickCount = static_cast<std::uint32_t>(clickCount_);
+        result.revealedCount = static_cast<std::uint32_t>(board_->getRevealedCount());
+        result.flagCount = static_cast<std::uint32_t>(board_->getFlagCount());
+        result.boardHash = Replay::hashBoard(*board_);
+        return result;
+    }
+
+    bool GameLogic::saveReplay(const std::string& path) {
+        if (!replayValid_) {
+            std::cerr << path << ": this game was loaded from a save, it has no replay" << std::endl;
+            return false;
+        }
+        replay_.setResult(getReplayResult());
+        return replay_.save(path);
+    }
+
+    double GameLogic::getBBBVPerSecond() const {
+        std::int64_t ms = gameClock_.getElapsedMilliseconds();
+        if (ms <= 0) {
+            return 0.0;
+        }
+        return board_->getSolvedBBBV() * 1000.0 / static_cast<double>(ms);
+    }
+
+    double GameLogic::getClickEfficiency() const {
+        if (clickCount_ == 0) {
+            return 0.0;
+        }
+        return static_cast<double>(board_->getSolvedBBBV()) / clickCount_;
+    }
+
+    bool GameLogic::saveGame(const std::string& path) const {
+        const size_t headerWords = sizeof(SaveFileHeader) / sizeof(std::uint64_t);
+        const size_t words = board_->getPlaneWordCount();
+        
+        // Header and planes in one buffer, written in one go
+        std::vector<std::uint64_t> buffer(headerWords + SaveFile::PLANE_COUNT * words);
+        std::uint64_t* planes = buffer.data() + headerWords;
+        board_->packPlanes(planes, planes + words, planes + 2 * words);
+        
+        SaveFileHeader header{};
+        std::memcpy(header.magic, SaveFile::MAGIC, sizeof(header.magic));
+        header.version = SaveFile::VERSION;
+        header.headerSize = sizeof(SaveFileHeader);
+        header.width = static_cast<std::uint32_t>(board_->getWidth());
+        header.height = static_cast<std::uint32_t>(board_->getHeight());
+        header.mineCount = static_cast<std::uint32_t>(board_->getMineCount());
+        if (board_->getLayout() == CellLayout::Tiled) {
+            header.tileWidth = 1u << Board::LAYOUT_TILE_SHIFT;
+            header.tileHeight = 1u << Board::LAYOUT_TILE_SHIFT;
+        } else {
+            header.tileWidth = header.width;
+            header.tileHeight = 1;
+        }
+        header.clickCount = static_cast<std::uint32_t>(clickCount_);
+        header.seed = board_->getSeed();
+        header.elapsedMilliseconds = static_cast<std::uint64_t>(gameClock_.getElapsedMilliseconds());
+        header.planeWords = words;
+        header.checksum = planeChecksum(planes, SaveFile::PLANE_COUNT * words);
+        header.gameState = static_cast<std::uint8_t>(gameState_);
+        header.flags = board_->isInitialized() ? SaveFile::FLAG_INITIALIZED : 0;
+        header.planeCount = SaveFile::PLANE_COUNT;
+        std::memcpy(buffer.data(), &header, sizeof(header));
+        
+        // Written next to the target, then renamed over it: a crash while
+        // saving leaves the previous save intact
+        std::string tempPath = path + ".tmp";
+        {
+            std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(buffer.data()),
+                      static_cast<std::streamsize>(buffer.size() * sizeof(std::uint64_t)));
+            if (!out) {
+                std::cerr << tempPath << ": cannot write save file" << std::endl;
+                return false;
             }
         }
+#ifdef _WIN32
+        std::remove(path.c_str()); // rename() doesn't replace files on Windows
+#endif
+        if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+            std::cerr << path << ": cannot replace save file" << std::endl;
+            std::remove(tempPath.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    bool GameLogic::readSaveHeader(const std::string& path, SaveFileHeader& header) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+            return false; // no save
+        }
+        return checkSaveHeader(header, path);
+    }
+
+    bool GameLogic::loadGame(const std::string& path) {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in) {
+            std::cerr << path << ": cannot open save file" << std::endl;
+            return false;
+        }
+        
+        std::streamoff size = in.tellg();
+        if (size < static_cast<std::streamoff>(sizeof(SaveFileHeader))) {
+            std::cerr << path << ": not a save file" << std::endl;
+            return false;
+        }
+        
+        std::vector<std::uint64_t> buffer((static_cast<size_t>(size) + 7) / 8);
+        in.seekg(0);
+        if (!in.read(reinterpret_cast<char*>(buffer.data()), size)) {
+            std::cerr << path << ": cannot read save file" << std::endl;
+            return false;
+        }
+        
+        SaveFileHeader header;
+        std::memcpy(&header, buffer.data(), sizeof(header));
+        if (!checkSaveHeader(header, path)) {
+            return false;
+        }
+        
+        // Planes are in storage order: the board must match exactly
+        bool tiled = board_->getLayout() == CellLayout::Tiled;
+        std::uint32_t tileWidth = tiled ? 1u << Board::LAYOUT_TILE_SHIFT : header.width;
+        std::uint32_t tileHeight = tiled ? 1u << Board::LAYOUT_TILE_SHIFT : 1;
+        if (header.width != static_cast<std::uint32_t>(board_->getWidth()) ||
+            header.height != static_cast<std::uint32_t>(board_->getHeight()) ||
+            header.mineCount != static_cast<std::uint32_t>(board_->getMineCount()) ||
+            header.tileWidth != tileWidth || header.tileHeight != tileHeight) {
+            std::cerr << path << ": saved for a " << header.width << "x" << header.height
+                      << " board with " << header.mineCount << " mines" << std::endl;
+            return false;
+        }
+        
+        const size_t words = board_->getPlaneWordCount();
+        const size_t headerWords = sizeof(SaveFileHeader) / sizeof(std::uint64_t);
+        if (header.planeWords != words ||
+            static_cast<size_t>(size) != sizeof(SaveFileHeader) + SaveFile::PLANE_COUNT * words * sizeof(std::uint64_t)) {
+            std::cerr << path << ": truncated save file" << std::endl;
+            return false;
+        }
+        
+        const std::uint64_t* planes = buffer.data() + headerWords;
+        if (planeChecksum(planes, SaveFile::PLANE_COUNT * words) != header.checksum) {
+            std::cerr << path << ": corrupted save file (checksum)" << std::endl;
+            return false;
+        }
+        
+        bool initialized = (header.flags & SaveFile::FLAG_INITIALIZED) != 0;
+        if (!board_->restorePlanes(planes, planes + words, planes + 2 * words, initialized, header.seed)) {
+            return false;
+        }
+        
+        gameState_ = static_cast<Config::GameState>(header.gameState);
+        clickCount_ = static_cast<int>(header.clickCount);
+        firstClick_ = !initialized;
+        journal_.clear();
+        solver_.invalidate();
+        replayValid_ = false; // the moves that led here are not saved
+        gameClock_.restore(static_cast<std::int64_t>(header.elapsedMilliseconds),
+                           initialized && gameState_ == Config::GameState::PLAYING);
+        return true;
+    }
+
+    bool GameLogic::isInProgress() const {
+        return !firstClick_ && gameState_ == Config::GameState::PLAYING;
+    }
+
+    bool GameLogic::isGameOver() const {
+        return gameState_ == Config::GameState::LOST;
+    }
+
+    bool GameLogic::isGameWon() const {
+        return gameState_ == Config::GameState::WON;
     }
 }
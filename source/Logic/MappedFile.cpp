@@ -0,0 +1,145 @@
+#include "../../include/Logic/MappedFile.hpp"
+#include <iostream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Minesweeper {
+    MappedFile::~MappedFile() {
+        close();
+    }
+
+    bool MappedFile::open(const std::string& path) {
+        return map(path, 0, false);
+    }
+
+    bool MappedFile::create(const std::string& path, size_t size) {
+        return map(path, size, true);
+    }
+
+#ifdef _WIN32
+    bool MappedFile::map(const std::string& path, size_t size, bool create) {
+        close();
+        
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ,
+                                  nullptr, create ? CREATE_ALWAYS : OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            std::cerr << "Cannot open " << path << " (error " << GetLastError() << ")" << std::endl;
+            return false;
+        }
+        
+        if (!create) {
+            LARGE_INTEGER fileSize;
+            GetFileSizeEx(file, &fileSize);
+            size = static_cast<size_t>(fileSize.QuadPart);
+        }
+        
+        if (size == 0) {
+            std::cerr << "Cannot map empty file " << path << std::endl;
+            CloseHandle(file);
+            return false;
+        }
+        
+        // The mapping extends the file to size when creating it
+        unsigned long long size64 = size;
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE,
+                                            static_cast<DWORD>(size64 >> 32),
+                                            static_cast<DWORD>(size64 & 0xFFFFFFFF), nullptr);
+        void* data = mapping ? MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size) : nullptr;
+        if (!data) {
+            std::cerr << "Cannot map " << path << " (error " << GetLastError() << ")" << std::endl;
+            if (mapping) CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+        
+        file_ = file;
+        mapping_ = mapping;
+        data_ = data;
+        size_ = size;
+        return true;
+    }
+
+    void MappedFile::close() {
+        if (data_) UnmapViewOfFile(data_);
+        if (mapping_) CloseHandle(mapping_);
+        if (file_) CloseHandle(file_);
+        data_ = nullptr;
+        mapping_ = nullptr;
+        file_ = nullptr;
+        size_ = 0;
+    }
+
+    bool MappedFile::flush() {
+        if (!data_) return false;
+        return FlushViewOfFile(data_, 0) && FlushFileBuffers(file_);
+    }
+#else
+    bool MappedFile::map(const std::string& path, size_t size, bool create) {
+        close();
+        
+        int fd = ::open(path.c_str(), create ? (O_RDWR | O_CREAT | O_TRUNC) : O_RDWR, 0644);
+        if (fd < 0) {
+            std::cerr << "Cannot open " << path << std::endl;
+            return false;
+        }
+        
+        if (create) {
+            // Sparse file: untouched pages cost no disk space and read as zeros
+            if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+                std::cerr << "Cannot resize " << path << std::endl;
+                ::close(fd);
+                return false;
+            }
+        } else {
+            struct stat info;
+            if (fstat(fd, &info) != 0) {
+                ::close(fd);
+                return false;
+            }
+            size = static_cast<size_t>(info.st_size);
+        }
+        
+        if (size == 0) {
+            std::cerr << "Cannot map empty file " << path << std::endl;
+            ::close(fd);
+            return false;
+        }
+        
+        void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (data == MAP_FAILED) {
+            std::cerr << "Cannot map " << path << std::endl;
+            ::close(fd);
+            return false;
+        }
+        
+        fd_ = fd;
+        data_ = data;
+        size_ = size;
+        return true;
+    }
+
+    void MappedFile::close() {
+        if (data_) munmap(data_, size_);
+        if (fd_ >= 0) ::close(fd_);
+        data_ = nullptr;
+        size_ = 0;
+        fd_ = -1;
+    }
+
+    bool MappedFile::flush() {
+        if (!data_) return false;
+        return msync(data_, size_, MS_SYNC) == 0;
+    }
+#endif
+}
@@ -0,0 +1,74 @@
+#include "../../include/Logic/MoveJournal.hpp"
+#include <algorithm>
+
+namespace Minesweeper {
+    namespace {
+        std::uint32_t toStored(size_t index) {
+            return static_cast<std::uint32_t>(index);
+        }
+    }
+
+
+    MoveJournal::MoveJournal(size_t cellCapacity)
+        : cells_(std::max<size_t>(1, cellCapacity)) {
+    }
+
+    void MoveJournal::clear() {
+        moves_.clear();
+        cellEnd_ = 0;
+        cursor_ = 0;
+        droppedMoves_ = 0;
+    }
+
+    void MoveJournal::record(MoveType type, std::uint8_t outcome, const size_t* cells, size_t count) {
+        // A new move forgets the undone ones
+        if (cursor_ < moves_.size()) {
+            moves_.resize(cursor_);
+            cellEnd_ = moves_.empty() ? cellEnd_ : moves_.back().firstCell + moves_.back().cellCount;
+        }
+
+        if (count > cells_.size()) {
+            droppedMoves_ += moves_.size() + 1;
+            moves_.clear();
+            cursor_ = 0;
+            return;
+        }
+
+        // Make room by forgetting the oldest moves
+        while (!moves_.empty() && cellEnd_ + count - moves_.front().firstCell > cells_.size()) {
+            moves_.pop_front();
+            droppedMoves_++;
+        }
+
+        Move move{type, outcome, cellEnd_, static_cast<std::uint32_t>(count)};
+        size_t start = static_cast<size_t>(cellEnd_ % cells_.size());
+        size_t head = std::min(count, cells_.size() - start); // up to the end of the ring
+        std::transform(cells, cells + head, cells_.begin() + start, toStored);
+        std::transform(cells + head, cells + count, cells_.begin(), toStored);
+        cellEnd_ += count;
+
+        moves_.push_back(move);
+        cursor_ = moves_.size();
+    }
+
+    const MoveJournal::Move* MoveJournal::getMove(size_t moveNumber) const {
+        if (moveNumber < droppedMoves_ || moveNumber >= getLatestMoveNumber()) {
+            return nullptr;
+        }
+        return &moves_[moveNumber - droppedMoves_];
+    }
+
+    const MoveJournal::Move* MoveJournal::undo() {
+        if (!canUndo()) {
+            return nullptr;
+        }
+        return &moves_[--cursor_];
+    }
+
+    const MoveJournal::Move* MoveJournal::redo() {
+        if (!canRedo()) {
+            return nullptr;
+        }
+        return &moves_[cursor_++];
+    }
+}
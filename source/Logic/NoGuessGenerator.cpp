@@ -0,0 +1,119 @@
+#include "../../include/Logic/NoGuessGenerator.hpp"
+#include "../../include/Logic/Board.hpp"
+#include "../../include/Logic/EliminationSolver.hpp"
+#include "../../include/Logic/Parallel.hpp"
+#include "../../include/Logic/Random.hpp"
+#include "../../include/Logic/Solver.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace Minesweeper {
+    namespace {
+        // Scratch of one thread
+        struct Candidate {
+            std::unique_ptr<Board> board;
+            Solver solver;
+            EliminationSolver elimination;
+        };
+
+        // Candidate 0 is the ordinary board of the base seed
+        std::uint64_t candidateSeed(std::uint64_t baseSeed, size_t index) {
+            return index == 0 ? baseSeed : Random::streamSeed(baseSeed, index);
+        }
+
+        // Reveals one cell, telling the solver what changed
+        void revealFor(Solver& solver, Board& board, std::uint32_t cell) {
+            int x = static_cast<int>(cell % static_cast<std::uint32_t>(board.getWidth()));
+            int y = static_cast<int>(cell / static_cast<std::uint32_t>(board.getWidth()));
+            if (board.getCell(x, y).isRevealed()) {
+                return;
+            }
+            std::uint64_t serial = board.getRevealSerial();
+            board.revealCell(x, y);
+            if (board.getRevealSerial() != serial) {
+                for (size_t index : board.getLastReveal().cells) {
+                    solver.cellChanged(index);
+                }
+            } else {
+                solver.cellChanged(board.cellIndex(x, y));
+            }
+        }
+    }
+
+    bool NoGuessGenerator::isSolvable(Board& board, std::uint64_t seed, int firstX, int firstY,
+                                      Solver& solver, EliminationSolver& elimination) {
+        board.reset(seed);
+        board.initialize(firstX, firstY);
+        if (board.revealCell(firstX, firstY)) {
+            return false;
+        }
+        solver.attach(board);
+
+        std::vector<std::uint32_t> safe;
+        int safeCount = board.getWidth() * board.getHeight() - board.getMineCount();
+        while (board.getRevealedCount() < safeCount) {
+            if (!elimination.solve(solver)) {
+                return false;
+            }
+            safe = solver.getSafeCells(); // revealing changes the list
+            if (safe.empty()) {
+                return false; // a guess would be needed
+            }
+            for (std::uint32_t cell : safe) {
+                revealFor(solver, board, cell);
+            }
+        }
+        return true;
+    }
+
+    bool NoGuessGenerator::findSeed(int width, int height, int mineCount, int firstX, int firstY,
+                                    std::uint64_t baseSeed, std::uint64_t& seed, unsigned maxWorkers,
+                                    double budgetMilliseconds, const std::atomic<bool>* stop) {
+        using Clock = std::chrono::steady_clock;
+        Clock::time_point deadline = Clock::now() +
+            std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(budgetMilliseconds));
+
+        unsigned workers = std::max(1u, maxWorkers);
+        std::vector<Candidate> scratch(workers);
+        for (Candidate& candidate : scratch) {
+            candidate.board = std::make_unique<Board>(width, height, mineCount);
+        }
+
+        // Lowest cleared candidate so far; those after it are skipped
+        std::atomic<size_t> winner{MAX_CANDIDATES};
+        std::atomic<bool> timedOut{false};
+        Parallel::forEachOnWorkers(MAX_CANDIDATES, [&](unsigned worker, size_t i) {
+            if (i > winner.load(std::memory_order_relaxed) || timedOut.load(std::memory_order_relaxed)) {
+                return;
+            }
+            if (Clock::now() > deadline || (stop && stop->load(std::memory_order_relaxed))) {
+                timedOut = true;
+                return;
+            }
+            Candidate& candidate = scratch[worker];
+            if (isSolvable(*candidate.board, candidateSeed(baseSeed, i), firstX, firstY,
+                           candidate.solver, candidate.elimination)) {
+                size_t best = winner.load();
+                while (i < best && !winner.compare_exchange_weak(best, i)) {
+                }
+            }
+        }, workers);
+
+        size_t found = winner.load();
+        if (found == MAX_CANDIDATES) {
+            if (!(stop && stop->load())) {
+                std::cerr << "No board without guessing found " << (timedOut ? "in time" : "among the candidates")
+                          << " (" << width << "x" << height << ", " << mineCount << " mines), using an ordinary one"
+                          << std::endl;
+            }
+            seed = baseSeed;
+            return false;
+        }
+        seed = candidateSeed(baseSeed, found);
+        return true;
+    }
+}
@@ -0,0 +1,116 @@
+#include "../../include/Logic/Parallel.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace Minesweeper {
+    namespace Parallel {
+        namespace {
+            // Threads 1..n of Parallel::forEachOnWorkers(), started on demand
+            // and sleeping between calls; stopped at exit
+            class WorkerPool {
+            public:
+                static WorkerPool& instance() {
+                    static WorkerPool pool;
+                    return pool;
+                }
+                
+                ~WorkerPool() {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        stopping_ = true;
+                    }
+                    wake_.notify_all();
+                    for (std::thread& thread : threads_) {
+                        thread.join();
+                    }
+                }
+                
+                // False when the pool is already running a call
+                bool run(size_t count, unsigned workers, detail::Task task, void* context) {
+                    std::unique_lock<std::mutex> busy(runMutex_, std::try_to_lock);
+                    if (!busy.owns_lock()) {
+                        return false;
+                    }
+                    
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        while (threads_.size() + 1 < workers) {
+                            unsigned worker = static_cast<unsigned>(threads_.size()) + 1;
+                            threads_.emplace_back(&WorkerPool::workerMain, this, worker, generation_);
+                        }
+                        task_ = task;
+                        context_ = context;
+                        count_ = count;
+                        next_ = 0;
+                        helpers_ = workers - 1;
+                        active_ = workers - 1;
+                        generation_++;
+                    }
+                    wake_.notify_all();
+                    
+                    work(0);
+                    
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    done_.wait(lock, [this]() { return active_ == 0; });
+                    return true;
+                }
+                
+            private:
+                std::mutex runMutex_; // held for a whole call
+                std::mutex mutex_;    // the fields below
+                std::condition_variable wake_;
+                std::condition_variable done_;
+                std::vector<std::thread> threads_;
+                bool stopping_ = false;
+                std::uint64_t generation_ = 0; // one per call
+                
+                detail::Task task_ = nullptr;
+                void* context_ = nullptr;
+                size_t count_ = 0;
+                std::atomic<size_t> next_{0};
+                unsigned helpers_ = 0; // threads 1..helpers_ take part in the call
+                unsigned active_ = 0;  // of them, still working
+                
+                void work(unsigned worker) {
+                    for (size_t i = next_++; i < count_; i = next_++) {
+                        task_(context_, worker, i);
+                    }
+                }
+                
+                void workerMain(unsigned worker, std::uint64_t seen) {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    for (;;) {
+                        wake_.wait(lock, [&]() { return stopping_ || generation_ != seen; });
+                        if (stopping_) {
+                            return;
+                        }
+                        seen = generation_;
+                        if (worker > helpers_) {
+                            continue; // a call with fewer workers
+                        }
+                        
+                        lock.unlock();
+                        work(worker);
+                        lock.lock();
+                        if (--active_ == 0) {
+                            done_.notify_one();
+                        }
+                    }
+                }
+            };
+        }
+        
+        namespace detail {
+            void run(size_t count, unsigned workers, Task task, void* context) {
+                if (!WorkerPool::instance().run(count, workers, task, context)) {
+                    for (size_t i = 0; i < count; ++i) {
+                        task(context, 0, i);
+                    }
+                }
+            }
+        }
+    }
+}
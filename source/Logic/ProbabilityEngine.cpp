@@ -0,0 +1,515 @@
+#include "../../include/Logic/ProbabilityEngine.hpp"
+#include "../../include/Logic/Parallel.hpp"
+#include "../../include/Logic/Solver.hpp"
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+namespace Minesweeper {
+    namespace {
+        // Remaining needs of the open constraints, 4 bits each
+        struct CountKey {
+            std::uint64_t words[2] = {0, 0};
+
+            int get(size_t slot) const { return static_cast<int>((words[slot >> 4] >> ((slot & 15) * 4)) & 15); }
+            void set(size_t slot, int value) { words[slot >> 4] |= std::uint64_t(value) << ((slot & 15) * 4); }
+            bool operator==(const CountKey& other) const {
+                return words[0] == other.words[0] && words[1] == other.words[1];
+            }
+        };
+
+        struct CountKeyHash {
+            size_t operator()(const CountKey& key) const {
+                return static_cast<size_t>((key.words[0] ^ (key.words[1] * 0x9E3779B97F4A7C15ull)) * 0xBF58476D1CE4E5B9ull >> 16);
+            }
+        };
+
+        // What assigning variable i does to the open constraints: those
+        // still open after it (outs), and those it completes (closes).
+        // source is the constraint's slot before i, -1 when i opens it.
+        struct CountStep {
+            struct Out {
+                std::int16_t source;
+                std::uint8_t need;
+                std::uint8_t limit;  // unassigned variables left in it
+                bool hasVariable;
+            };
+            struct Close {
+                std::int16_t source;
+                std::uint8_t need;
+            };
+            std::vector<Out> outs;
+            std::vector<Close> closes;
+
+            bool apply(const CountKey& key, int mine, CountKey& next) const {
+                for (const Close& close : closes) {
+                    int need = close.source >= 0 ? key.get(static_cast<size_t>(close.source)) : close.need;
+                    if (need != mine) {
+                        return false;
+                    }
+                }
+                next = CountKey();
+                for (size_t slot = 0; slot < outs.size(); ++slot) {
+                    const Out& out = outs[slot];
+                    int need = (out.source >= 0 ? key.get(static_cast<size_t>(out.source)) : out.need) -
+                               (out.hasVariable ? mine : 0);
+                    if (need < 0 || need > out.limit) {
+                        return false;
+                    }
+                    next.set(slot, need);
+                }
+                return true;
+            }
+        };
+
+        // States of the counting before variable i, with their
+        // configurations so far by number of mines (stride i + 1) and the
+        // state each choice leads to (-1 when it breaks a constraint)
+        struct CountLayer {
+            std::vector<CountKey> keys;
+            std::vector<double> counts;
+            std::vector<std::int32_t> next; // 2 per state: safe, mine
+        };
+
+        // Counts are only ever compared with counts of the same vector:
+        // each one is kept at a largest value of 1 so products of many
+        // components don't overflow
+        void normalize(std::vector<double>& values) {
+            double largest = *std::max_element(values.begin(), values.end());
+            if (largest > 0.0) {
+                for (double& value : values) {
+                    value /= largest;
+                }
+            }
+        }
+
+        std::vector<double> convolve(const std::vector<double>& a, const std::vector<double>& b) {
+            std::vector<double> result(a.size() + b.size() - 1, 0.0);
+            for (size_t i = 0; i < a.size(); ++i) {
+                if (a[i] != 0.0) {
+                    for (size_t j = 0; j < b.size(); ++j) {
+                        result[i + j] += a[i] * b[j];
+                    }
+                }
+            }
+            normalize(result);
+            return result;
+        }
+
+        double logBinomial(double n, double k) {
+            return std::lgamma(n + 1.0) - std::lgamma(k + 1.0) - std::lgamma(n - k + 1.0);
+        }
+    }
+
+    // Forward: configurations of the variables before i, merged by the
+    // needs they leave to the open constraints. Backward: completions of
+    // each state. A variable's mine counts pair the two around it.
+    bool ProbabilityEngine::countComponent(Component& component, Clock::time_point deadline) const {
+        const size_t n = component.part->variables.size();
+        if (n > MAX_COMPONENT_CELLS || Clock::now() > deadline) {
+            return false;
+        }
+
+        // Constraints in counting order: first and last variable, and the
+        // plan of every step
+        const std::vector<Frontier::Constraint>& constraints = frontier_.getConstraints();
+        std::vector<std::uint32_t> firstOf(constraints.size()), lastOf(constraints.size());
+        std::vector<std::uint8_t> remaining(constraints.size());
+        std::vector<std::vector<std::uint32_t>> opening(n), containing(n);
+        for (std::uint32_t c : component.part->constraints) {
+            const Frontier::Constraint& constraint = constraints[c];
+            const std::uint32_t* variables = frontier_.getVariables(constraint);
+            std::uint32_t first = UINT32_MAX, last = 0;
+            for (std::uint32_t i = 0; i < constraint.count; ++i) {
+                std::uint32_t position = frontier_.getPosition(variables[i]);
+                first = std::min(first, position);
+                last = std::max(last, position);
+                containing[position].push_back(c);
+            }
+            firstOf[c] = first;
+            lastOf[c] = last;
+            remaining[c] = static_cast<std::uint8_t>(constraint.count);
+            opening[first].push_back(c);
+        }
+
+        std::vector<CountStep> steps(n);
+        std::vector<std::uint32_t> open, nextOpen;
+        std::vector<std::int16_t> slotOf(constraints.size(), -1);
+        for (size_t i = 0; i < n; ++i) {
+            for (std::uint32_t c : containing[i]) {
+                remaining[c]--;
+            }
+            CountStep& step = steps[i];
+            nextOpen.clear();
+            for (std::uint32_t c : open) {
+                bool has = std::find(containing[i].begin(), containing[i].end(), c) != containing[i].end();
+                if (lastOf[c] == i) {
+                    step.closes.push_back({slotOf[c], 0});
+                } else {
+                    step.outs.push_back({slotOf[c], 0, remaining[c], has});
+                    nextOpen.push_back(c);
+                }
+            }
+            for (std::uint32_t c : opening[i]) {
+                std::uint8_t need = static_cast<std::uint8_t>(std::max(0, constraints[c].need));
+                if (lastOf[c] == i) {
+                    step.closes.push_back({-1, need});
+                } else {
+                    step.outs.push_back({-1, need, remaining[c], true});
+                    nextOpen.push_back(c);
+                }
+            }
+            if (nextOpen.size() > MAX_OPEN_CONSTRAINTS) {
+                return false;
+            }
+            for (std::uint32_t c : open) {
+                slotOf[c] = -1;
+            }
+            open.swap(nextOpen);
+            for (size_t slot = 0; slot < open.size(); ++slot) {
+                slotOf[open[slot]] = static_cast<std::int16_t>(slot);
+            }
+        }
+
+        // Forward
+        std::vector<CountLayer> layers(n + 1);
+        layers[0].keys.push_back(CountKey());
+        layers[0].counts.push_back(1.0);
+        std::unordered_map<CountKey, std::int32_t, CountKeyHash> index;
+        for (size_t i = 0; i < n; ++i) {
+            CountLayer& layer = layers[i];
+            CountLayer& next = layers[i + 1];
+            const size_t stride = i + 1;
+            index.clear();
+            layer.next.assign(layer.keys.size() * 2, -1);
+            for (size_t s = 0; s < layer.keys.size(); ++s) {
+                for (int mine = 0; mine <= 1; ++mine) {
+                    CountKey key;
+                    if (!steps[i].apply(layer.keys[s], mine, key)) {
+                        continue;
+                    }
+                    auto found = index.emplace(key, static_cast<std::int32_t>(next.keys.size()));
+                    if (found.second) {
+                        next.keys.push_back(key);
+                        next.counts.resize(next.counts.size() + stride + 1, 0.0);
+                    }
+                    std::int32_t t = found.first->second;
+                    layer.next[2 * s + mine] = t;
+                    const double* from = &layer.counts[s * stride];
+                    double* to = &next.counts[static_cast<size_t>(t) * (stride + 1) + mine];
+                    for (size_t j = 0; j < stride; ++j) {
+                        to[j] += from[j];
+                    }
+                }
+            }
+            if (next.keys.size() > MAX_STATES || Clock::now() > deadline) {
+                return false;
+            }
+        }
+
+        component.totals.assign(n + 1, 0.0);
+        component.mineCounts.assign(n * (n + 1), 0.0);
+        if (layers[n].keys.empty()) {
+            return true; // no configuration: zero everywhere
+        }
+        std::copy(layers[n].counts.begin(), layers[n].counts.end(), component.totals.begin());
+
+        // Backward, with each variable's mine counts on the way
+        std::vector<double> after(1, 1.0), before; // completions by mines, per state of the layer
+        for (size_t i = n; i-- > 0;) {
+            const CountLayer& layer = layers[i];
+            const size_t stride = i + 1;          // forward counts of layer i
+            const size_t afterStride = n - i;     // completions from layer i + 1
+            const size_t beforeStride = n - i + 1;
+            before.assign(layer.keys.size() * beforeStride, 0.0);
+            double* mineCounts = &component.mineCounts[i * (n + 1)];
+            for (size_t s = 0; s < layer.keys.size(); ++s) {
+                for (int mine = 0; mine <= 1; ++mine) {
+                    std::int32_t t = layer.next[2 * s + mine];
+                    if (t < 0) {
+                        continue;
+                    }
+                    const double* completions = &after[static_cast<size_t>(t) * afterStride];
+                    double* to = &before[s * beforeStride + mine];
+                    for (size_t k = 0; k < afterStride; ++k) {
+                        to[k] += completions[k];
+                    }
+                    if (mine) {
+                        const double* counts = &layer.counts[s * stride];
+                        for (size_t j = 0; j < stride; ++j) {
+                            if (counts[j] != 0.0) {
+                                for (size_t k = 0; k < afterStride; ++k) {
+                                    mineCounts[j + 1 + k] += counts[j] * completions[k];
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+            after.swap(before);
+            if (Clock::now() > deadline) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Without counting: the mean density of the constraints around it
+    double ProbabilityEngine::estimate(std::uint32_t variable) const {
+        double sum = 0.0;
+        const std::uint32_t* begin = frontier_.constraintsBegin(variable);
+        const std::uint32_t* end = frontier_.constraintsEnd(variable);
+        size_t count = static_cast<size_t>(end - begin);
+        for (const std::uint32_t* c = begin; c != end; ++c) {
+            const Frontier::Constraint& constraint = frontier_.getConstraints()[*c];
+            sum += std::min(1.0, std::max(0.0, static_cast<double>(constraint.need) / constraint.count));
+        }
+        return count > 0 ? sum / count : 0.0;
+    }
+
+    // Component totals and mine counts (when asked for) times odds^k,
+    // relative to the largest total; false when the component has no
+    // configuration
+    bool ProbabilityEngine::tilt(const Component& component, double logOdds,
+                                 std::vector<double>& totals, std::vector<double>* mineCounts) {
+        const size_t n = component.part->variables.size();
+        double largest = -INFINITY;
+        for (size_t k = 0; k <= n; ++k) {
+            if (component.totals[k] > 0.0) {
+                largest = std::max(largest, std::log(component.totals[k]) + static_cast<double>(k) * logOdds);
+            }
+        }
+        if (std::isinf(largest)) {
+            return false;
+        }
+
+        auto scaled = [&](double count, size_t k) {
+            return count > 0.0 ? std::exp(std::log(count) + static_cast<double>(k) * logOdds - largest) : 0.0;
+        };
+        totals.resize(n + 1);
+        for (size_t k = 0; k <= n; ++k) {
+            totals[k] = scaled(component.totals[k], k);
+        }
+        if (mineCounts) {
+            mineCounts->resize(n * (n + 1));
+            for (size_t i = 0; i < mineCounts->size(); ++i) {
+                (*mineCounts)[i] = scaled(component.mineCounts[i], i % (n + 1));
+            }
+        }
+        return true;
+    }
+
+    // Odds making the expected number of mines the mines left, with every
+    // configuration of k mines weighing odds^k: the mine count as a density
+    double ProbabilityEngine::findLogOdds(const std::vector<const Component*>& components, double minesLeft,
+                                          double interiorCount) {
+        std::vector<double> totals;
+        auto expectedMines = [&](double logOdds) {
+            double mines = interiorCount / (1.0 + std::exp(-logOdds));
+            for (const Component* component : components) {
+                tilt(*component, logOdds, totals, nullptr);
+                double sum = 0.0, weighted = 0.0;
+                for (size_t k = 0; k < totals.size(); ++k) {
+                    sum += totals[k];
+                    weighted += totals[k] * static_cast<double>(k);
+                }
+                mines += sum > 0.0 ? weighted / sum : 0.0;
+            }
+            return mines;
+        };
+
+        double low = -40.0, high = 40.0;
+        for (int i = 0; i < 60; ++i) {
+            double middle = 0.5 * (low + high);
+            (expectedMines(middle) < minesLeft ? low : high) = middle;
+        }
+        return 0.5 * (low + high);
+    }
+
+    // Every frontier total t is weighted by the ways to put the other
+    // mines in the interior, C(interior, minesLeft - t). Component c sees
+    // the components before it through their combined totals (prefix) and
+    // those after it folded into the weights (after), one at a time.
+    // Tables tilted by the density's odds (and weights divided by them)
+    // peak where the weights do, so nothing underflows.
+    bool ProbabilityEngine::combineExact(const std::vector<const Component*>& components, double minesLeft,
+                                         double interiorCount, double logOdds,
+                                         std::vector<double>& probability, double& interior) {
+        const size_t count = components.size();
+        std::vector<std::vector<double>> totals(count), mineCounts(count);
+        std::vector<std::vector<double>> prefix(count + 1, std::vector<double>(1, 1.0));
+        for (size_t c = 0; c < count; ++c) {
+            if (!tilt(*components[c], logOdds, totals[c], &mineCounts[c])) {
+                return false;
+            }
+            prefix[c + 1] = convolve(prefix[c], totals[c]);
+        }
+
+        const std::vector<double>& frontier = prefix.back();
+        std::vector<double> after(frontier.size(), -INFINITY);
+        double largest = -INFINITY;
+        for (size_t t = 0; t < frontier.size(); ++t) {
+            double rest = minesLeft - static_cast<double>(t);
+            if (rest >= 0.0 && rest <= interiorCount) {
+                after[t] = logBinomial(interiorCount, rest) - static_cast<double>(t) * logOdds;
+                largest = std::max(largest, after[t]);
+            }
+        }
+        if (std::isinf(largest)) {
+            return false; // not enough room for the mines left, or too many
+        }
+        double total = 0.0, interiorMines = 0.0;
+        for (size_t t = 0; t < frontier.size(); ++t) {
+            after[t] = std::isinf(after[t]) ? 0.0 : std::exp(after[t] - largest);
+            total += frontier[t] * after[t];
+            interiorMines += frontier[t] * after[t] * (minesLeft - static_cast<double>(t));
+        }
+        if (!(total > 0.0)) {
+            return false;
+        }
+        interior = interiorCount > 0.0 ? interiorMines / (total * interiorCount) : 0.0;
+
+        std::vector<double> rest, folded;
+        for (size_t c = count; c-- > 0;) {
+            const Component& component = *components[c];
+            const size_t n = component.part->variables.size();
+            rest.assign(n + 1, 0.0);
+            double denominator = 0.0;
+            for (size_t k = 0; k <= n; ++k) {
+                for (size_t j = 0; j < prefix[c].size(); ++j) {
+                    rest[k] += prefix[c][j] * after[k + j];
+                }
+                denominator += totals[c][k] * rest[k];
+            }
+            for (size_t i = 0; i < n; ++i) {
+                double numerator = 0.0;
+                for (size_t k = 0; k <= n; ++k) {
+                    numerator += mineCounts[c][i * (n + 1) + k] * rest[k];
+                }
+                probability[component.part->variables[i]] = denominator > 0.0 ? numerator / denominator : 0.0;
+            }
+
+            folded.assign(prefix[c].size(), 0.0);
+            for (size_t k = 0; k < folded.size(); ++k) {
+                for (size_t m = 0; m <= n; ++m) {
+                    folded[k] += totals[c][m] * after[k + m];
+                }
+            }
+            normalize(folded);
+            after.swap(folded);
+        }
+        return true;
+    }
+
+    // With the mine count as a density the components are independent
+    bool ProbabilityEngine::combineByDensity(const std::vector<const Component*>& components,
+                                             double interiorCount, double logOdds,
+                                             std::vector<double>& probability, double& interior) {
+        std::vector<double> totals, mineCounts;
+        for (const Component* component : components) {
+            if (!tilt(*component, logOdds, totals, &mineCounts)) {
+                return false;
+            }
+            const size_t n = component->part->variables.size();
+            double sum = 0.0;
+            for (double count : totals) {
+                sum += count;
+            }
+            for (size_t i = 0; i < n; ++i) {
+                double mines = 0.0;
+                for (size_t k = 0; k <= n; ++k) {
+                    mines += mineCounts[i * (n + 1) + k];
+                }
+                probability[component->part->variables[i]] = mines / sum;
+            }
+        }
+        interior = interiorCount > 0.0 ? 1.0 / (1.0 + std::exp(-logOdds)) : 0.0;
+        return true;
+    }
+
+    bool ProbabilityEngine::compute(const Solver& solver, ProbabilityMap& map, double budgetMilliseconds) {
+        Clock::time_point deadline = Clock::now() +
+            std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(budgetMilliseconds));
+
+        frontier_.build(solver);
+        const size_t variableCount = frontier_.getVariableCount();
+        components_.clear();
+        for (const Frontier::Component& part : frontier_.getComponents()) {
+            components_.push_back({&part, {}, {}, false});
+        }
+
+        if (components_.size() > 1 && variableCount >= PARALLEL_MIN_CELLS) {
+            Parallel::forEach(components_.size(), [this, deadline](size_t c) {
+                components_[c].exact = countComponent(components_[c], deadline);
+            });
+        } else {
+            for (Component& component : components_) {
+                component.exact = countComponent(component, deadline);
+            }
+        }
+
+        // Estimated components take their expected mines off the count
+        double minesLeft = static_cast<double>(solver.getMineCount()) - static_cast<double>(solver.getKnownMineCount());
+        double interiorCount = static_cast<double>(solver.getUnknownCount() - variableCount);
+        std::vector<double> probability(variableCount, 0.0);
+        std::vector<const Component*> exact;
+        size_t approximated = 0;
+        for (const Component& component : components_) {
+            if (component.exact) {
+                exact.push_back(&component);
+                continue;
+            }
+            approximated++;
+            for (std::uint32_t v : component.part->variables) {
+                probability[v] = estimate(v);
+                minesLeft -= probability[v];
+            }
+        }
+        minesLeft = std::max(0.0, std::round(minesLeft));
+
+        // Exact combination while its cost (frontier size times cells
+        // counted) fits, else the density approximation
+        size_t frontierSize = 1, work = 0;
+        for (const Component* component : exact) {
+            frontierSize += component->part->variables.size();
+        }
+        for (const Component* component : exact) {
+            work += frontierSize * component->part->variables.size();
+        }
+        double interior = 0.0;
+        double logOdds = findLogOdds(exact, minesLeft, interiorCount);
+        bool combinedExactly = work <= MAX_COMBINE_WORK && Clock::now() <= deadline;
+        bool consistent = combinedExactly
+            ? combineExact(exact, minesLeft, interiorCount, logOdds, probability, interior)
+            : combineByDensity(exact, interiorCount, logOdds, probability, interior);
+        if (!consistent) {
+            for (size_t v = 0; v < variableCount; ++v) {
+                probability[v] = estimate(static_cast<std::uint32_t>(v));
+            }
+            interior = interiorCount > 0.0 ? std::min(1.0, minesLeft / interiorCount) : 0.0;
+        }
+
+        map.width = solver.getWidth();
+        map.height = solver.getHeight();
+        map.componentCount = components_.size();
+        map.approximatedCount = consistent ? approximated : components_.size();
+        map.complete = consistent && combinedExactly && approximated == 0;
+        map.interior = static_cast<float>(interior);
+
+        size_t cellCount = static_cast<size_t>(map.width) * map.height;
+        map.mine.resize(cellCount);
+        for (size_t cell = 0; cell < cellCount; ++cell) {
+            std::uint32_t index = static_cast<std::uint32_t>(cell);
+            if (solver.isMine(index)) {
+                map.mine[cell] = 1.0f;
+            } else if (!solver.isUnknown(index)) {
+                map.mine[cell] = 0.0f;
+            } else if (frontier_.getVariable(index) >= 0) {
+                map.mine[cell] = static_cast<float>(probability[static_cast<size_t>(frontier_.getVariable(index))]);
+            } else {
+                map.mine[cell] = map.interior;
+            }
+        }
+        return consistent;
+    }
+}
@@ -0,0 +1,123 @@
+#include "../../include/Logic/Random.hpp"
+#include <algorithm>
+#include <random>
+
+namespace Minesweeper {
+    namespace Random {
+        std::uint64_t mix(std::uint64_t value) {
+            value += 0x9E3779B97F4A7C15ULL;
+            value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+            return value ^ (value >> 31);
+        }
+
+        std::uint64_t streamSeed(std::uint64_t seed, std::uint64_t index) {
+            return mix(mix(seed) ^ mix(index + 1));
+        }
+
+        std::uint64_t makeSeed() {
+            std::random_device rd;
+            return (static_cast<std::uint64_t>(rd()) << 32) ^ rd();
+        }
+
+        Generator::Generator(std::uint64_t seed) {
+            for (auto& word : state_) {
+                seed = mix(seed);
+                word = seed;
+            }
+        }
+
+        std::uint64_t Generator::next() {
+            auto rotl = [](std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); };
+            
+            std::uint64_t result = rotl(state_[1] * 5, 7) * 9;
+            std::uint64_t t = state_[1] << 17;
+            state_[2] ^= state_[0];
+            state_[3] ^= state_[1];
+            state_[1] ^= state_[2];
+            state_[0] ^= state_[3];
+            state_[2] ^= t;
+            state_[3] = rotl(state_[3], 45);
+            return result;
+        }
+
+        double Generator::uniform() {
+            return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0);
+        }
+
+        // Inversion starting at the mode, on weights relative to it: the
+        // mode weighs 1 and the other terms follow from the pmf ratio. A
+        // first walk adds the weights up (down to a negligible tail), the
+        // second walks outwards from the mode, always extending on the
+        // heavier side, until the weights pass u times that total. Only
+        // integer arithmetic and IEEE +, *, / (no lgamma or exp, whose last
+        // bits differ between C libraries), so the draw depends on the
+        // generator alone. Expected cost is O(stddev); population < 2^32.
+        std::uint64_t hypergeometric(Generator& gen, std::uint64_t population,
+                                     std::uint64_t successes, std::uint64_t draws) {
+            const std::uint64_t N = population;
+            const std::uint64_t K = std::min(successes, N);
+            const std::uint64_t n = std::min(draws, N);
+            
+            const std::uint64_t low = n > N - K ? n - (N - K) : 0;
+            const std::uint64_t high = std::min(n, K);
+            if (low == high) {
+                return low;
+            }
+            
+            // pmf(k+1) / pmf(k)
+            auto ratioUp = [&](std::uint64_t k) {
+                return (static_cast<double>(K - k) * static_cast<double>(n - k)) /
+                       (static_cast<double>(k + 1) * static_cast<double>(N - K - n + k + 1));
+            };
+            const double tail = 0x1p-80; // relative to the mode: past every 53-bit u
+            
+            std::uint64_t mode = std::clamp((n + 1) * (K + 1) / (N + 2), low, high);
+            
+            double total = 1.0;
+            double weight = 1.0;
+            for (std::uint64_t k = mode; k < high && weight > tail; ++k) {
+                weight *= ratioUp(k);
+                total += weight;
+            }
+            weight = 1.0;
+            for (std::uint64_t k = mode; k > low && weight > tail; --k) {
+                weight /= ratioUp(k - 1);
+                total += weight;
+            }
+            
+            double target = gen.uniform() * total;
+            double cumulative = 1.0;
+            if (target < cumulative) {
+                return mode;
+            }
+            
+            std::uint64_t up = mode, down = mode;
+            double pUp = 1.0, pDown = 1.0;
+            double nextUp = up < high ? pUp * ratioUp(up) : 0.0;
+            double nextDown = down > low ? pDown / ratioUp(down - 1) : 0.0;
+            
+            while (up < high || down > low) {
+                if (up < high && (down == low || nextUp >= nextDown)) {
+                    ++up;
+                    pUp = nextUp;
+                    cumulative += pUp;
+                    if (target < cumulative) return up;
+                    nextUp = up < high ? pUp * ratioUp(up) : 0.0;
+                } else {
+                    --down;
+                    pDown = nextDown;
+                    cumulative += pDown;
+                    if (target < cumulative) return down;
+                    nextDown = down > low ? pDown / ratioUp(down - 1) : 0.0;
+                }
+                
+                // Both tails are negligible: what is left is rounding error
+                if (nextUp <= tail && nextDown <= tail) {
+                    break;
+                }
+            }
+            return mode;
+        }
+    }
+}
@@ -0,0 +1,231 @@
+#include "../../include/Logic/Replay.hpp"
+#include "../../include/Logic/Board.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace Minesweeper {
+    namespace {
+        void putFixed64(std::vector<std::uint8_t>& out, std::uint64_t value) {
+            for (int i = 0; i < 8; ++i) {
+                out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+            }
+        }
+
+        bool getFixed64(const std::uint8_t*& data, const std::uint8_t* end, std::uint64_t& value) {
+            if (end - data < 8) {
+                return false;
+            }
+            value = 0;
+            for (int i = 0; i < 8; ++i) {
+                value |= static_cast<std::uint64_t>(*data++) << (8 * i);
+            }
+            return true;
+        }
+    }
+
+    void Replay::begin(int width, int height, int mineCount, std::uint64_t seed) {
+        width_ = width;
+        height_ = height;
+        mineCount_ = mineCount;
+        seed_ = seed;
+        origin_ = -1;
+        events_.clear();
+        eventCount_ = 0;
+        lastTime_ = 0;
+        lastCell_ = 0;
+        result_ = ReplayResult();
+    }
+
+    void Replay::addEvent(ReplayAction action, int x, int y, std::int64_t timeMilliseconds) {
+        std::int64_t cell = lastCell_;
+        if (action != ReplayAction::Undo && action != ReplayAction::Redo) {
+            cell = static_cast<std::int64_t>(y) * width_ + x;
+        }
+
+        // The game clock never goes back; clamp anyway so the delta stays unsigned
+        std::int64_t time = std::max(timeMilliseconds, lastTime_);
+        ReplayCoding::putVarint(events_, static_cast<std::uint64_t>(time - lastTime_));
+        ReplayCoding::putVarint(events_, ReplayCoding::zigzag(cell - lastCell_) << 3 |
+                                         static_cast<std::uint64_t>(action));
+        lastTime_ = time;
+        lastCell_ = cell;
+        eventCount_++;
+    }
+
+    std::vector<ReplayEvent> Replay::decodeEvents() const {
+        std::vector<ReplayEvent> events;
+        events.reserve(eventCount_);
+        forEachEvent([&events](const ReplayEvent& event) { events.push_back(event); });
+        return events;
+    }
+
+    bool Replay::save(const std::string& path) const {
+        if (static_cast<std::uint64_t>(width_) * static_cast<std::uint64_t>(height_) > ReplayFile::MAX_CELLS) {
+            std::cerr << path << ": board too large for a replay" << std::endl;
+            return false; // load() would refuse it
+        }
+        std::vector<std::uint8_t> data(ReplayFile::MAGIC, ReplayFile::MAGIC + sizeof(ReplayFile::MAGIC));
+        data.reserve(data.size() + events_.size() + 64);
+
+        ReplayCoding::putVarint(data, ReplayFile::VERSION);
+        ReplayCoding::putVarint(data, static_cast<std::uint64_t>(width_));
+        ReplayCoding::putVarint(data, static_cast<std::uint64_t>(height_));
+        ReplayCoding::putVarint(data, static_cast<std::uint64_t>(mineCount_));
+        putFixed64(data, seed_);
+        ReplayCoding::putVarint(data, static_cast<std::uint64_t>(origin_ + 1));
+        ReplayCoding::putVarint(data, eventCount_);
+        ReplayCoding::putVarint(data, events_.size());
+        data.insert(data.end(), events_.begin(), events_.end());
+
+        ReplayCoding::putVarint(data, result_.gameState);
+        ReplayCoding::putVarint(data, result_.elapsedMilliseconds);
+        ReplayCoding::putVarint(data, result_.clickCount);
+        ReplayCoding::putVarint(data, result_.revealedCount);
+        ReplayCoding::putVarint(data, result_.flagCount);
+        putFixed64(data, result_.boardHash);
+
+        // Same as saved games: never leave a half-written replay behind
+        std::string tempPath = path + ".tmp";
+        {
+            std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+            if (!out || !out.write(reinterpret_cast<const char*>(data.data()),
+                                   static_cast<std::streamsize>(data.size()))) {
+                std::cerr << tempPath << ": cannot write replay" << std::endl;
+                return false;
+            }
+        }
+#ifdef _WIN32
+        std::remove(path.c_str()); // rename() doesn't replace files on Windows
+#endif
+        if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+            std::cerr << path << ": cannot write replay" << std::endl;
+            std::remove(tempPath.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    bool Replay::load(const std::string& path) {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in) {
+            std::cerr << path << ": cannot open replay" << std::endl;
+            return false;
+        }
+
+        std::vector<std::uint8_t> data(static_cast<size_t>(in.tellg()));
+        in.seekg(0);
+        if (!in.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()))) {
+            std::cerr << path << ": cannot read replay" << std::endl;
+            return false;
+        }
+        return decode(data, path);
+    }
+
+    bool Replay::decode(const std::vector<std::uint8_t>& data, const std::string& path) {
+        const std::uint8_t* cursor = data.data();
+        const std::uint8_t* end = cursor + data.size();
+        auto fail = [&path](const char* what) {
+            std::cerr << path << ": " << what << std::endl;
+            return false;
+        };
+
+        if (data.size() < sizeof(ReplayFile::MAGIC) ||
+            std::memcmp(cursor, ReplayFile::MAGIC, sizeof(ReplayFile::MAGIC)) != 0) {
+            return fail("not a replay");
+        }
+        cursor += sizeof(ReplayFile::MAGIC);
+
+        std::uint64_t version, width, height, mines, seed, origin = 0, eventCount, eventBytes;
+        if (!ReplayCoding::getVarint(cursor, end, version) ||
+            version < ReplayFile::MIN_VERSION || version > ReplayFile::VERSION) {
+            return fail("unsupported replay version");
+        }
+        if (!ReplayCoding::getVarint(cursor, end, width) || !ReplayCoding::getVarint(cursor, end, height) ||
+            !ReplayCoding::getVarint(cursor, end, mines) || !getFixed64(cursor, end, seed) ||
+            (version >= 2 && !ReplayCoding::getVarint(cursor, end, origin)) ||
+            !ReplayCoding::getVarint(cursor, end, eventCount) || !ReplayCoding::getVarint(cursor, end, eventBytes)) {
+            return fail("truncated replay");
+        }
+        if (width == 0 || height == 0 || width > ReplayFile::MAX_CELLS || height > ReplayFile::MAX_CELLS / width ||
+            mines >= width * height || origin > width * height) {
+            return fail("invalid board in replay");
+        }
+        if (eventBytes > static_cast<std::uint64_t>(end - cursor) || eventCount > eventBytes / 2) {
+            return fail("truncated replay");
+        }
+
+        // Check the events now: forEachEvent() trusts them
+        const std::uint8_t* events = cursor;
+        const std::uint8_t* eventsEnd = cursor + eventBytes;
+        std::int64_t cell = 0;
+        std::int64_t cellCount = static_cast<std::int64_t>(width * height);
+        std::uint64_t time = 0;
+        for (std::uint64_t i = 0; i < eventCount; ++i) {
+            std::uint64_t timeDelta, code;
+            if (!ReplayCoding::getVarint(cursor, eventsEnd, timeDelta) ||
+                !ReplayCoding::getVarint(cursor, eventsEnd, code)) {
+                return fail("truncated replay events");
+            }
+            if (timeDelta > static_cast<std::uint64_t>(INT64_MAX) - time) {
+                return fail("invalid replay event");
+            }
+            cell += ReplayCoding::unzigzag(code >> 3); // |delta| < 2^61, cannot overflow
+            time += timeDelta;
+            if ((code & 7) > static_cast<std::uint64_t>(ReplayAction::Redo) ||
+                cell < 0 || cell >= cellCount) {
+                return fail("invalid replay event");
+            }
+        }
+        if (cursor != eventsEnd) {
+            return fail("invalid replay events");
+        }
+
+        ReplayResult result;
+        std::uint64_t state, elapsed, clicks, revealed, flags, hash;
+        if (!ReplayCoding::getVarint(cursor, end, state) || !ReplayCoding::getVarint(cursor, end, elapsed) ||
+            !ReplayCoding::getVarint(cursor, end, clicks) || !ReplayCoding::getVarint(cursor, end, revealed) ||
+            !ReplayCoding::getVarint(cursor, end, flags) || !getFixed64(cursor, end, hash) || cursor != end) {
+            return fail("truncated replay result");
+        }
+        if (state > 0xFF || clicks > UINT32_MAX || revealed > UINT32_MAX || flags > UINT32_MAX) {
+            return fail("invalid replay result");
+        }
+        result.gameState = static_cast<std::uint8_t>(state);
+        result.elapsedMilliseconds = elapsed;
+        result.clickCount = static_cast<std::uint32_t>(clicks);
+        result.revealedCount = static_cast<std::uint32_t>(revealed);
+        result.flagCount = static_cast<std::uint32_t>(flags);
+        result.boardHash = hash;
+
+        width_ = static_cast<int>(width);
+        height_ = static_cast<int>(height);
+        mineCount_ = static_cast<int>(mines);
+        seed_ = seed;
+        origin_ = static_cast<std::int64_t>(origin) - 1;
+        events_.assign(events, eventsEnd);
+        eventCount_ = static_cast<size_t>(eventCount);
+        lastTime_ = static_cast<std::int64_t>(time);
+        lastCell_ = cell;
+        result_ = result;
+        return true;
+    }
+
+    // FNV-1a over one byte per cell
+    std::uint64_t Replay::hashBoard(const Board& board) {
+        std::uint64_t hash = 0xCBF29CE484222325ull;
+        for (int y = 0; y < board.getHeight(); ++y) {
+            for (int x = 0; x < board.getWidth(); ++x) {
+                const Cell& cell = board.getCell(x, y);
+                std::uint8_t state = static_cast<std::uint8_t>(
+                    (cell.hasMine() ? Cell::MINE_BIT : 0) |
+                    (cell.isRevealed() ? Cell::REVEALED_BIT : 0) |
+                    (cell.isFlagged() ? Cell::FLAGGED_BIT : 0));
+                hash = (hash ^ state) * 0x100000001B3ull;
+            }
+        }
+        return hash;
+    }
+}
@@ -0,0 +1,106 @@
+#include "../../include/Logic/ReplayPlayer.hpp"
+#include "../../include/Logic/GameLogic.hpp"
+
+namespace Minesweeper {
+    namespace {
+        const char* actionName(ReplayAction action) {
+            switch (action) {
+                case ReplayAction::Reveal: return "reveal";
+                case ReplayAction::Flag: return "flag";
+                case ReplayAction::Chord: return "chord";
+                case ReplayAction::Undo: return "undo";
+                case ReplayAction::Redo: return "redo";
+                default: return "?";
+            }
+        }
+    }
+
+    ReplayPlayer::Report ReplayPlayer::play(const Replay& replay, GameLogic& game,
+                                            const EventCallback& afterEvent) {
+        Report report;
+        const Board& board = *game.getBoard();
+        if (board.getWidth() != replay.getWidth() || board.getHeight() != replay.getHeight() ||
+            board.getMineCount() != replay.getMineCount()) {
+            report.error = "game doesn't match the replay's board";
+            return report;
+        }
+
+        bool recording = game.isRecordingReplay();
+        game.setRecordingReplay(false);
+        if (replay.hasOrigin()) {
+            game.startReplayedGame(replay.getSeed(), replay.getOriginX(), replay.getOriginY());
+        } else {
+            game.startReplayedGame(replay.getSeed());
+        }
+
+        replay.forEachEvent([&](const ReplayEvent& event) {
+            if (!report.error.empty()) {
+                return;
+            }
+
+            // A recorded event always changed the game: count the click or
+            // the move it should have made
+            int clicks = game.getClickCount();
+            bool changed = true;
+            switch (event.action) {
+                case ReplayAction::Reveal:
+                    game.handleLeftClick(event.x, event.y);
+                    break;
+                case ReplayAction::Flag:
+                    game.handleRightClick(event.x, event.y);
+                    break;
+                case ReplayAction::Chord:
+                    game.handleChord(event.x, event.y);
+                    break;
+                case ReplayAction::Undo:
+                    changed = game.undo();
+                    report.undoCount++;
+                    break;
+                case ReplayAction::Redo:
+                    changed = game.redo();
+                    report.undoCount++;
+                    break;
+            }
+            if (event.action != ReplayAction::Undo && event.action != ReplayAction::Redo) {
+                changed = game.getClickCount() != clicks;
+            }
+
+            if (!changed) {
+                report.error = "event " + std::to_string(report.eventsPlayed) + " (" +
+                               actionName(event.action) + " " + std::to_string(event.x) + "," +
+                               std::to_string(event.y) + ") has no effect";
+                return;
+            }
+            if (afterEvent) {
+                afterEvent(report.eventsPlayed, event);
+            }
+            report.eventsPlayed++;
+        });
+        game.setRecordingReplay(recording);
+
+        if (!report.error.empty()) {
+            return report;
+        }
+
+        const ReplayResult& expected = replay.getResult();
+        if (static_cast<std::uint8_t>(game.getGameState()) != expected.gameState) {
+            report.error = "game ends in another state";
+        } else if (static_cast<std::uint32_t>(game.getClickCount()) != expected.clickCount) {
+            report.error = "click count differs";
+        } else if (static_cast<std::uint32_t>(board.getRevealedCount()) != expected.revealedCount ||
+                   static_cast<std::uint32_t>(board.getFlagCount()) != expected.flagCount) {
+            report.error = "revealed or flagged cell count differs";
+        } else if (static_cast<std::uint64_t>(replay.getLastEventTime()) > expected.elapsedMilliseconds) {
+            report.error = "recorded time is shorter than the events";
+        } else if (game.getGameState() != Config::GameState::PLAYING &&
+                   static_cast<std::uint64_t>(replay.getLastEventTime()) != expected.elapsedMilliseconds) {
+            // The clock stops on the event that ends the game
+            report.error = "recorded time doesn't match the last event";
+        } else if (Replay::hashBoard(board) != expected.boardHash) {
+            report.error = "board differs";
+        } else {
+            report.ok = true;
+        }
+        return report;
+    }
+}
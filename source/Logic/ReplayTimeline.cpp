@@ -0,0 +1,162 @@
+#include "../../include/Logic/ReplayTimeline.hpp"
+#include "../../include/Logic/GameLogic.hpp"
+#include "../../include/Logic/ReplayPlayer.hpp"
+#include <algorithm>
+
+namespace Minesweeper {
+    bool ReplayTimeline::build(const Replay& replay, GameLogic& game, std::string& error) {
+        game_ = &game;
+        steps_.clear();
+        cells_.clear();
+        keyframes_.clear();
+        position_ = 0;
+
+        // Keyframes every interval events, within the memory budget
+        const Board& board = *game.getBoard();
+        size_t keyframeBytes = 2 * board.getPlaneWordCount() * sizeof(std::uint64_t);
+        size_t budgetInterval = (replay.getEventCount() * keyframeBytes + KEYFRAME_BUDGET_BYTES - 1) / KEYFRAME_BUDGET_BYTES;
+        keyframeInterval_ = std::max(MIN_KEYFRAME_INTERVAL, budgetInterval);
+        steps_.reserve(replay.getEventCount());
+
+        // The journal tells which cells each event changed: the move it
+        // recorded, undid or redid. A move the journal couldn't keep (or
+        // no move at all) becomes a keyframe.
+        size_t moveNumber = 0;
+        auto afterEvent = [&](size_t index, const ReplayEvent& event) {
+            const MoveJournal& journal = game.getJournal();
+            size_t previous = moveNumber;
+            moveNumber = journal.getMoveNumber();
+
+            const MoveJournal::Move* move = nullptr;
+            bool undone = event.action == ReplayAction::Undo;
+            if (undone ? moveNumber + 1 == previous : moveNumber == previous + 1) {
+                move = journal.getMove(undone ? moveNumber : previous);
+            }
+
+            Step step{event.timeMilliseconds, 0, 0, StepKind::Keyframe, game.getGameState(), game.getClickCount()};
+            if (move) {
+                step.first = cells_.size();
+                step.cellCount = move->cellCount;
+                step.kind = move->type == MoveJournal::MoveType::Flag ? StepKind::Flag
+                          : undone ? StepKind::Hide : StepKind::Reveal;
+                journal.forEachCell(*move, [this](std::uint32_t cell) { cells_.push_back(cell); });
+            } else {
+                addKeyframe(index + 1);
+                step.first = keyframes_.size() - 1;
+            }
+            steps_.push_back(step);
+
+            if ((index + 1) % keyframeInterval_ == 0 && keyframes_.back().position != index + 1) {
+                addKeyframe(index + 1);
+            }
+        };
+
+        // Position 0: nothing revealed or flagged yet
+        keyframes_.push_back(Keyframe{0, std::vector<std::uint64_t>(board.getPlaneWordCount(), 0),
+                                      std::vector<std::uint64_t>(board.getPlaneWordCount(), 0)});
+        ReplayPlayer::Report report = ReplayPlayer::play(replay, game, afterEvent);
+        if (!report.ok) {
+            error = report.error;
+            game_ = nullptr;
+            return false;
+        }
+
+        duration_ = std::max<std::int64_t>(replay.getLastEventTime(),
+                                           static_cast<std::int64_t>(replay.getResult().elapsedMilliseconds));
+        position_ = steps_.size();
+        seek(0);
+        return true;
+    }
+
+    size_t ReplayTimeline::positionAt(std::int64_t time) const {
+        auto after = std::upper_bound(steps_.begin(), steps_.end(), time,
+                                      [](std::int64_t t, const Step& step) { return t < step.time; });
+        return static_cast<size_t>(after - steps_.begin());
+    }
+
+    void ReplayTimeline::seek(size_t position) {
+        position = std::min(position, steps_.size());
+        moveTo(position);
+        showPosition(position == 0 ? 0 : steps_[position - 1].time);
+    }
+
+    void ReplayTimeline::seekTime(std::int64_t time) {
+        time = std::max<std::int64_t>(0, std::min(time, duration_));
+        moveTo(positionAt(time));
+        showPosition(time);
+    }
+
+    void ReplayTimeline::moveTo(size_t position) {
+        if (!game_) {
+            return;
+        }
+
+        // A short way forward: apply the steps. Anywhere else: start from
+        // the last keyframe at or before the target.
+        if (position < position_ || position - position_ >= keyframeInterval_) {
+            auto next = std::upper_bound(keyframes_.begin(), keyframes_.end(), position,
+                                         [](size_t p, const Keyframe& keyframe) { return p < keyframe.position; });
+            const Keyframe& keyframe = *(next - 1); // keyframes_[0] is position 0
+            restoreKeyframe(keyframe);
+            position_ = keyframe.position;
+        }
+
+        while (position_ < position) {
+            applyStep(steps_[position_++]);
+        }
+    }
+
+    // The clock stops with the game: a finished position shows the time of
+    // its last event, or the recorded time at the very end
+    void ReplayTimeline::showPosition(std::int64_t time) {
+        if (position_ == 0) {
+            game_->showReplayFrame(Config::GameState::PLAYING, 0, time);
+            return;
+        }
+
+        const Step& step = steps_[position_ - 1];
+        if (step.state != Config::GameState::PLAYING) {
+            time = position_ == steps_.size() ? duration_ : step.time;
+        }
+        game_->showReplayFrame(step.state, step.clickCount, time);
+    }
+
+    void ReplayTimeline::addKeyframe(size_t position) {
+        const Board& board = *game_->getBoard();
+        size_t words = board.getPlaneWordCount();
+
+        Keyframe keyframe;
+        keyframe.position = position;
+        keyframe.revealed.resize(words);
+        keyframe.flagged.resize(words);
+        scratch_.resize(words); // mines, not kept: they never change
+        board.packPlanes(scratch_.data(), keyframe.revealed.data(), keyframe.flagged.data());
+        keyframes_.push_back(std::move(keyframe));
+    }
+
+    void ReplayTimeline::restoreKeyframe(const Keyframe& keyframe) {
+        game_->getBoard()->restoreMarks(keyframe.revealed.data(), keyframe.flagged.data());
+    }
+
+    void ReplayTimeline::applyStep(const Step& step) {
+        Board& board = *game_->getBoard();
+        const std::uint32_t* cells = cells_.data() + step.first;
+
+        switch (step.kind) {
+            case StepKind::Reveal:
+            case StepKind::Hide:
+                for (std::uint32_t i = 0; i < step.cellCount; ++i) {
+                    board.setCellRevealed(cells[i], step.kind == StepKind::Reveal);
+                }
+                break;
+            case StepKind::Flag:
+                for (std::uint32_t i = 0; i < step.cellCount; ++i) {
+                    board.toggleCellFlag(cells[i]);
+                }
+                break;
+            case StepKind::Keyframe:
+                restoreKeyframe(keyframes_[step.first]);
+                break;
+        }
+    }
+}
@@ -0,0 +1,344 @@
+#include "../../include/Logic/Solver.hpp"
+#include "../../include/Logic/Bits.hpp"
+#include "../../include/Logic/Board.hpp"
+#include <algorithm>
+
+namespace Minesweeper {
+    void Solver::attach(const Board& board) {
+        board_ = &board;
+        rebuild();
+    }
+
+    void Solver::rebuild() {
+        width_ = board_->getWidth();
+        height_ = board_->getHeight();
+        mineCount_ = board_->getMineCount();
+        cellCount_ = static_cast<size_t>(width_) * height_;
+
+        state_.assign(cellCount_, 0);
+        unknown_.assign(cellCount_, 0);
+        need_.assign(cellCount_, 0);
+        touching_.assign(cellCount_, 0);
+        queue_.clear();
+        safe_.clear();
+        mines_.clear();
+        knownCount_ = 0;
+        knownMines_ = 0;
+        frontierSize_ = 0;
+        contradiction_ = false;
+        stale_ = false;
+
+        for (int y = 0; y < height_; ++y) {
+            for (int x = 0; x < width_; ++x) {
+                const Cell& cell = board_->getCell(x, y);
+                std::uint32_t index = static_cast<std::uint32_t>(cellAt(x, y));
+                if (cell.isRevealed()) {
+                    reveal(index);
+                } else if (cell.isFlagged()) {
+                    state_[index] |= FLAGGED;
+                    if (trustFlags_ && !(state_[index] & KNOWN)) {
+                        setKnown(index, true);
+                    }
+                }
+            }
+        }
+    }
+
+    void Solver::cellChanged(size_t storageIndex) {
+        if (stale_ || !board_) {
+            return;
+        }
+
+        int x, y;
+        board_->cellPosition(storageIndex, x, y);
+        std::uint32_t index = static_cast<std::uint32_t>(cellAt(x, y));
+        const Cell& cell = board_->getCell(x, y);
+
+        if ((state_[index] & REVEALED) && !cell.isRevealed()) {
+            stale_ = true; // what it told may have been used anywhere
+            return;
+        }
+        if (!(state_[index] & REVEALED) && cell.isRevealed()) {
+            reveal(index);
+            return;
+        }
+
+        if (cell.isFlagged() != ((state_[index] & FLAGGED) != 0)) {
+            state_[index] ^= FLAGGED;
+            if (trustFlags_) {
+                if (!cell.isFlagged()) {
+                    stale_ = true; // the mine may have been used to deduce more
+                } else if (!(state_[index] & KNOWN)) {
+                    setKnown(index, true);
+                } else if (state_[index] & SAFE) {
+                    contradiction_ = true; // flag on a cell proven safe
+                }
+            }
+        }
+    }
+
+    void Solver::reveal(std::uint32_t cell) {
+        int x = static_cast<int>(cell % width_);
+        int y = static_cast<int>(cell / width_);
+        const Cell& boardCell = board_->getCell(x, y);
+
+        // Lost game: the exploded mine is a known mine, not a number
+        if (boardCell.hasMine()) {
+            if (state_[cell] & SAFE) {
+                contradiction_ = true;
+            } else if (!(state_[cell] & MINE)) {
+                setKnown(cell, true);
+            }
+            return;
+        }
+        if (state_[cell] & MINE) {
+            contradiction_ = true; // deduced from a wrong trusted flag
+            stale_ = true;
+            return;
+        }
+
+        state_[cell] |= REVEALED;
+        if (!(state_[cell] & SAFE)) {
+            setKnown(cell, false);
+        }
+
+        std::uint8_t unknown = 0;
+        int need = boardCell.getAdjacentMines();
+        for (int k = 0; k < 8; ++k) {
+            int nx = x + NEIGHBOR_DX[k];
+            int ny = y + NEIGHBOR_DY[k];
+            if (nx < 0 || nx >= width_ || ny < 0 || ny >= height_) {
+                continue;
+            }
+            size_t neighbor = cellAt(nx, ny);
+            if (state_[neighbor] & REVEALED) {
+                continue;
+            }
+            if (touching_[neighbor]++ == 0 && !(state_[neighbor] & KNOWN)) {
+                frontierSize_++;
+            }
+            if (state_[neighbor] & MINE) {
+                need--;
+            } else if (!(state_[neighbor] & KNOWN)) {
+                unknown |= static_cast<std::uint8_t>(1u << k);
+            }
+        }
+
+        unknown_[cell] = unknown;
+        need_[cell] = static_cast<std::int8_t>(need);
+        if (unknown != 0) {
+            enqueue(cell);
+        } else if (need != 0) {
+            contradiction_ = true;
+        }
+    }
+
+    // The cell leaves the unknowns: the numbers around it lose it, and look
+    // again at what is left
+    void Solver::setKnown(std::uint32_t cell, bool mine) {
+        state_[cell] |= mine ? MINE : SAFE;
+        knownCount_++;
+        if (mine) {
+            knownMines_++;
+            mines_.push_back(cell);
+        } else if (!(state_[cell] & REVEALED)) {
+            safe_.push_back(cell);
+        }
+        if (touching_[cell] > 0) {
+            frontierSize_--;
+        }
+
+        int x = static_cast<int>(cell % width_);
+        int y = static_cast<int>(cell / width_);
+        for (int k = 0; k < 8; ++k) {
+            int nx = x + NEIGHBOR_DX[k];
+            int ny = y + NEIGHBOR_DY[k];
+            if (nx < 0 || nx >= width_ || ny < 0 || ny >= height_) {
+                continue;
+            }
+            std::uint32_t neighbor = static_cast<std::uint32_t>(cellAt(nx, ny));
+            if (state_[neighbor] & REVEALED) {
+                unknown_[neighbor] &= static_cast<std::uint8_t>(~(1u << (7 - k)));
+                if (mine) {
+                    need_[neighbor]--;
+                }
+                enqueue(neighbor);
+            }
+        }
+    }
+
+    void Solver::enqueue(std::uint32_t cell) {
+        if (!(state_[cell] & QUEUED)) {
+            state_[cell] |= QUEUED;
+            queue_.push_back(cell);
+        }
+    }
+
+    bool Solver::solve() {
+        if (!board_) {
+            return false;
+        }
+        if (stale_) {
+            rebuild();
+        }
+
+        do {
+            while (!queue_.empty()) {
+                std::uint32_t cell = queue_.back();
+                queue_.pop_back();
+                state_[cell] &= static_cast<std::uint8_t>(~QUEUED);
+                if (unknown_[cell] == 0) {
+                    contradiction_ = contradiction_ || need_[cell] != 0;
+                    continue;
+                }
+                if (!applyCountRule(cell)) {
+                    applyPairRules(cell);
+                }
+            }
+        } while (!contradiction_ && applyMineCount());
+
+        return !contradiction_;
+    }
+
+    void Solver::setDeduced(std::uint32_t cell, bool mine) {
+        if (stale_ || (state_[cell] & REVEALED)) {
+            contradiction_ = contradiction_ || (!stale_ && mine);
+            return;
+        }
+        if (state_[cell] & KNOWN) {
+            contradiction_ = contradiction_ || ((state_[cell] & MINE) != 0) != mine;
+            return;
+        }
+        setKnown(cell, mine);
+    }
+
+    bool Solver::applyCountRule(std::uint32_t cell) {
+        std::uint8_t unknown = unknown_[cell];
+        int count = Bits::popcount64(unknown);
+        int need = need_[cell];
+        if (need < 0 || need > count) {
+            contradiction_ = true;
+            return true;
+        }
+        if (need != 0 && need != count) {
+            return false;
+        }
+
+        int x = static_cast<int>(cell % width_);
+        int y = static_cast<int>(cell / width_);
+        for (int k = 0; k < 8; ++k) {
+            if (unknown & (1u << k)) {
+                setKnown(static_cast<std::uint32_t>(cellAt(x + NEIGHBOR_DX[k], y + NEIGHBOR_DY[k])), need != 0);
+            }
+        }
+        return true;
+    }
+
+    // A and B share some unknowns. Between min and max of their mines are
+    // in the shared part, the rest of each one's mines are outside it: when
+    // that forces all or none of A's (or B's) own cells, they are known.
+    // Subset and superset rules are the cases where one side has no own cell.
+    bool Solver::applyPairRules(std::uint32_t cell) {
+        int ax = static_cast<int>(cell % width_);
+        int ay = static_cast<int>(cell / width_);
+        std::uint64_t a = frameMask(cell, 0, 0);
+        int needA = need_[cell];
+
+        for (int oy = -2; oy <= 2; ++oy) {
+            int by = ay + oy;
+            if (by < 0 || by >= height_) {
+                continue;
+            }
+            for (int ox = -2; ox <= 2; ++ox) {
+                int bx = ax + ox;
+                if ((ox == 0 && oy == 0) || bx < 0 || bx >= width_) {
+                    continue;
+                }
+                std::uint32_t other = static_cast<std::uint32_t>(cellAt(bx, by));
+                if (!(state_[other] & REVEALED) || unknown_[other] == 0) {
+                    continue;
+                }
+                std::uint64_t b = frameMask(other, ox, oy);
+                std::uint64_t shared = a & b;
+                if (shared == 0) {
+                    continue;
+                }
+
+                std::uint64_t onlyA = a & ~b;
+                std::uint64_t onlyB = b & ~a;
+                int sharedCount = Bits::popcount64(shared);
+                int countA = Bits::popcount64(onlyA);
+                int countB = Bits::popcount64(onlyB);
+                int needB = need_[other];
+                int maxShared = std::min({sharedCount, needA, needB});
+                int minShared = std::max({0, needA - countA, needB - countB});
+
+                std::uint64_t known = 0;
+                bool mine = false;
+                if (onlyB && needB - maxShared == countB) {
+                    known = onlyB, mine = true;
+                } else if (onlyB && needB - minShared == 0) {
+                    known = onlyB;
+                } else if (onlyA && needA - maxShared == countA) {
+                    known = onlyA, mine = true;
+                } else if (onlyA && needA - minShared == 0) {
+                    known = onlyA;
+                }
+                if (known) {
+                    setFrameKnown(cell, known, mine);
+                    enqueue(cell); // more may follow with its other neighbors
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // Global rule: with every mine known the other cells are safe, and the
+    // other way round
+    bool Solver::applyMineCount() {
+        size_t unknownCount = cellCount_ - knownCount_;
+        size_t minesLeft = static_cast<size_t>(mineCount_) - std::min(knownMines_, static_cast<size_t>(mineCount_));
+        if (unknownCount == 0 || (minesLeft != 0 && minesLeft != unknownCount)) {
+            return false;
+        }
+        for (size_t cell = 0; cell < cellCount_; ++cell) {
+            if (!(state_[cell] & (KNOWN | REVEALED))) {
+                setKnown(static_cast<std::uint32_t>(cell), minesLeft != 0);
+            }
+        }
+        return true;
+    }
+
+    // Unknown neighbors of a constraint whose center is at (offsetX,
+    // offsetY) from the middle of the 7x7 frame
+    std::uint64_t Solver::frameMask(std::uint32_t cell, int offsetX, int offsetY) const {
+        std::uint64_t frame = 0;
+        for (std::uint8_t unknown = unknown_[cell]; unknown != 0; unknown &= unknown - 1) {
+            int k = Bits::lowestBit(unknown);
+            int fx = 3 + offsetX + NEIGHBOR_DX[k];
+            int fy = 3 + offsetY + NEIGHBOR_DY[k];
+            frame |= std::uint64_t(1) << (fy * FRAME + fx);
+        }
+        return frame;
+    }
+
+    void Solver::setFrameKnown(std::uint32_t center, std::uint64_t frame, bool mine) {
+        int cx = static_cast<int>(center % width_) - 3;
+        int cy = static_cast<int>(center / width_) - 3;
+        for (; frame != 0; frame &= frame - 1) {
+            int bit = Bits::lowestBit(frame);
+            std::uint32_t cell = static_cast<std::uint32_t>(cellAt(cx + bit % FRAME, cy + bit / FRAME));
+            if (!(state_[cell] & KNOWN)) {
+                setKnown(cell, mine);
+            }
+        }
+    }
+
+    const std::vector<std::uint32_t>& Solver::getSafeCells() {
+        safe_.erase(std::remove_if(safe_.begin(), safe_.end(),
+                                   [this](std::uint32_t cell) { return (state_[cell] & REVEALED) != 0; }),
+                    safe_.end());
+        return safe_;
+    }
+}
@@ -0,0 +1,303 @@
+#include "../../include/Logic/StatsStore.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace Minesweeper {
+    namespace {
+        constexpr size_t RECORD_CHUNK = 4096; // records read at once while catching up
+
+        std::uint32_t recordChecksum(const StatsRecord& record) {
+            const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&record);
+            std::uint32_t hash = 0x811C9DC5u;
+            for (size_t i = 0; i < offsetof(StatsRecord, checksum); ++i) {
+                hash = (hash ^ bytes[i]) * 0x01000193u;
+            }
+            return hash;
+        }
+
+        std::uint64_t indexChecksum(const StatsIndex& index) {
+            const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&index);
+            std::uint64_t hash = 0xCBF29CE484222325ull;
+            for (size_t i = 0; i < offsetof(StatsIndex, checksum); ++i) {
+                hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+            }
+            return hash;
+        }
+
+        bool syncFile(std::FILE* file) {
+            if (std::fflush(file) != 0) {
+                return false;
+            }
+#ifdef _WIN32
+            return _commit(_fileno(file)) == 0;
+#else
+            return fsync(fileno(file)) == 0;
+#endif
+        }
+
+        bool checkLogHeader(const StatsLogHeader& header) {
+            return std::memcmp(header.magic, StatsFile::LOG_MAGIC, sizeof(header.magic)) == 0 &&
+                   header.version == StatsFile::VERSION &&
+                   header.recordSize == sizeof(StatsRecord);
+        }
+
+        // A new log, complete or not at all: the header goes to a temporary
+        // file that replaces the path once synced
+        bool createLog(const std::string& path) {
+            std::string tempPath = path + ".tmp";
+            StatsLogHeader header;
+            std::memcpy(header.magic, StatsFile::LOG_MAGIC, sizeof(header.magic));
+            header.version = StatsFile::VERSION;
+            header.recordSize = sizeof(StatsRecord);
+
+            std::FILE* file = std::fopen(tempPath.c_str(), "wb");
+            bool written = file && std::fwrite(&header, sizeof(header), 1, file) == 1 && syncFile(file);
+            if (file) {
+                std::fclose(file);
+            }
+#ifdef _WIN32
+            if (written) {
+                std::remove(path.c_str()); // rename() doesn't replace files on Windows
+            }
+#endif
+            if (!written || std::rename(tempPath.c_str(), path.c_str()) != 0) {
+                std::cerr << path << ": cannot create statistics log" << std::endl;
+                std::remove(tempPath.c_str());
+                return false;
+            }
+            return true;
+        }
+
+        bool fasterThan(const StatsBestTime& a, const StatsBestTime& b) {
+            return a.timeMilliseconds != b.timeMilliseconds ? a.timeMilliseconds < b.timeMilliseconds
+                                                            : a.record < b.record;
+        }
+    }
+
+    StatsStore::StatsStore(std::string logPath, std::string indexPath)
+        : logPath_(std::move(logPath)), indexPath_(std::move(indexPath)) {
+        resetIndex();
+    }
+
+    bool StatsStore::open() {
+        if (!loadIndex()) {
+            resetIndex();
+        }
+        std::uint64_t logRecords;
+        return catchUp(logRecords);
+    }
+
+    void StatsStore::resetIndex() {
+        std::memset(&index_, 0, sizeof(index_));
+        std::memcpy(index_.magic, StatsFile::INDEX_MAGIC, sizeof(index_.magic));
+        index_.version = StatsFile::VERSION;
+    }
+
+    bool StatsStore::loadIndex() {
+        std::ifstream in(indexPath_, std::ios::binary);
+        StatsIndex index;
+        if (!in.read(reinterpret_cast<char*>(&index), sizeof(index))) {
+            return false; // none yet, or cut short: rebuilt from the log
+        }
+        if (std::memcmp(index.magic, StatsFile::INDEX_MAGIC, sizeof(index.magic)) != 0 ||
+            index.version != StatsFile::VERSION || index.checksum != indexChecksum(index)) {
+            std::cerr << indexPath_ << ": invalid statistics index, rebuilding it" << std::endl;
+            return false;
+        }
+        index_ = index;
+        return true;
+    }
+
+    bool StatsStore::saveIndex() {
+        index_.checksum = indexChecksum(index_);
+
+        std::string tempPath = indexPath_ + ".tmp";
+        {
+            std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+            if (!out || !out.write(reinterpret_cast<const char*>(&index_), sizeof(index_))) {
+                std::cerr << tempPath << ": cannot write statistics index" << std::endl;
+                return false;
+            }
+        }
+#ifdef _WIN32
+        std::remove(indexPath_.c_str()); // rename() doesn't replace files on Windows
+#endif
+        if (std::rename(tempPath.c_str(), indexPath_.c_str()) != 0) {
+            std::cerr << indexPath_ << ": cannot write statistics index" << std::endl;
+            std::remove(tempPath.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    bool StatsStore::catchUp(std::uint64_t& logRecords) {
+        logRecords = 0;
+        std::ifstream in(logPath_, std::ios::binary | std::ios::ate);
+        if (!in) {
+            // No log, no games: an index left alone is stale
+            if (index_.logRecords != 0) {
+                resetIndex();
+                return saveIndex();
+            }
+            return true;
+        }
+
+        std::streamoff size = in.tellg();
+        StatsLogHeader header;
+        if (size < static_cast<std::streamoff>(sizeof(header))) {
+            // Cut short before its header (a crash while it was created by
+            // an older version): no games, the next append rewrites it
+            if (index_.logRecords != 0) {
+                resetIndex();
+                return saveIndex();
+            }
+            return true;
+        }
+        in.seekg(0);
+        if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) || !checkLogHeader(header)) {
+            std::cerr << logPath_ << ": not a statistics log" << std::endl;
+            return false;
+        }
+
+        // An index ahead of the log belongs to another log: count again
+        std::uint64_t available = static_cast<std::uint64_t>(size - sizeof(header)) / sizeof(StatsRecord);
+        bool changed = false;
+        if (index_.logRecords > available) {
+            resetIndex();
+            changed = true;
+        }
+
+        // Up to the first torn or corrupted record, the end of the log
+        std::uint64_t position = index_.logRecords;
+        std::vector<StatsRecord> chunk(RECORD_CHUNK);
+        in.seekg(static_cast<std::streamoff>(sizeof(header) + position * sizeof(StatsRecord)));
+        while (position < available) {
+            size_t count = static_cast<size_t>(std::min<std::uint64_t>(RECORD_CHUNK, available - position));
+            if (!in.read(reinterpret_cast<char*>(chunk.data()), static_cast<std::streamsize>(count * sizeof(StatsRecord)))) {
+                break;
+            }
+            size_t valid = 0;
+            while (valid < count && chunk[valid].checksum == recordChecksum(chunk[valid])) {
+                addToIndex(chunk[valid], position + valid);
+                valid++;
+            }
+            position += valid;
+            changed = changed || valid > 0;
+            if (valid < count) {
+                break;
+            }
+        }
+
+        index_.logRecords = position;
+        logRecords = position;
+        return !changed || saveIndex();
+    }
+
+    void StatsStore::addToIndex(const StatsRecord& record, std::uint64_t position) {
+        int slot = std::min<int>(record.difficulty, StatsFile::DIFFICULTY_COUNT - 1);
+        StatsDifficulty& stats = index_.difficulties[slot];
+        stats.played++;
+
+        if (record.result == static_cast<std::uint8_t>(Config::GameState::WON)) {
+            stats.won++;
+
+            // Insertion into the short sorted list
+            StatsBestTime time{record.timeMilliseconds, record.bbbv, position};
+            StatsBestTime* end = stats.best + stats.bestCount;
+            StatsBestTime* at = std::upper_bound(stats.best, end, time, fasterThan);
+            if (at != stats.best + StatsFile::BEST_COUNT) {
+                if (stats.bestCount < StatsFile::BEST_COUNT) {
+                    stats.bestCount++;
+                    end++;
+                }
+                std::move_backward(at, end - 1, end);
+                *at = time;
+            }
+        }
+
+        index_.lastGame = record;
+        index_.hasLastGame = 1;
+    }
+
+    bool StatsStore::append(Config::Difficulty difficulty, Config::GameState result,
+                            std::int64_t timeMilliseconds, int bbbv, int clicks) {
+        // Another store (or a crash) may have changed the log since open()
+        std::uint64_t position;
+        if (!catchUp(position)) {
+            return false;
+        }
+
+        StatsRecord record;
+        std::memset(&record, 0, sizeof(record));
+        record.timestamp = static_cast<std::uint64_t>(std::time(nullptr));
+        record.timeMilliseconds = static_cast<std::uint32_t>(std::max<std::int64_t>(0, std::min<std::int64_t>(timeMilliseconds, UINT32_MAX)));
+        record.bbbv = static_cast<std::uint32_t>(std::max(0, bbbv));
+        record.clicks = static_cast<std::uint32_t>(std::max(0, clicks));
+        record.difficulty = static_cast<std::uint8_t>(difficulty);
+        record.result = static_cast<std::uint8_t>(result);
+        record.checksum = recordChecksum(record);
+
+        // Right after the last valid record, over any torn one
+        std::FILE* file = std::fopen(logPath_.c_str(), "r+b");
+        if (file && (std::fseek(file, 0, SEEK_END) != 0 ||
+                     std::ftell(file) < static_cast<long>(sizeof(StatsLogHeader)))) {
+            std::fclose(file); // no header: created again, as catchUp() found no games
+            file = nullptr;
+        }
+        if (!file) {
+            if (!createLog(logPath_)) {
+                return false;
+            }
+            file = std::fopen(logPath_.c_str(), "r+b");
+            if (!file) {
+                std::cerr << logPath_ << ": cannot open statistics log" << std::endl;
+                return false;
+            }
+        }
+
+        long offset = static_cast<long>(sizeof(StatsLogHeader) + position * sizeof(StatsRecord));
+        bool written = std::fseek(file, offset, SEEK_SET) == 0 &&
+                       std::fwrite(&record, sizeof(record), 1, file) == 1 &&
+                       syncFile(file);
+        std::fclose(file);
+        if (!written) {
+            std::cerr << logPath_ << ": cannot append to statistics log" << std::endl;
+            return false;
+        }
+
+        // The record is safe: the index can only lag behind from here
+        addToIndex(record, position);
+        index_.logRecords = position + 1;
+        return saveIndex();
+    }
+
+    const StatsDifficulty& StatsStore::getDifficulty(Config::Difficulty difficulty) const {
+        int slot = std::min<int>(static_cast<int>(difficulty), StatsFile::DIFFICULTY_COUNT - 1);
+        return index_.difficulties[slot];
+    }
+
+    double StatsStore::getWinRate(Config::Difficulty difficulty) const {
+        const StatsDifficulty& stats = getDifficulty(difficulty);
+        return stats.played > 0 ? static_cast<double>(stats.won) / static_cast<double>(stats.played) : 0.0;
+    }
+
+    bool StatsStore::getLastGame(StatsRecord& record) const {
+        if (!index_.hasLastGame) {
+            return false;
+        }
+        record = index_.lastGame;
+        return true;
+    }
+}
@@ -0,0 +1,97 @@
+#include "Renderer/AssetLoader.hpp"
+
+namespace Minesweeper {
+    AssetLoader::AssetLoader(std::shared_ptr<AssetManager> assetManager)
+        : assetManager_(assetManager), jobs_(AssetManager::getImageJobs()) {
+        // Font + CPU images + font-based textures
+        total_ = 1 + static_cast<int>(jobs_.size()) + AssetManager::FONT_TEXTURE_COUNT;
+    }
+
+    AssetLoader::~AssetLoader() {
+        cancelled_ = true;
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+    }
+
+    void AssetLoader::start() {
+        if (!worker_.joinable()) {
+            worker_ = std::thread(&AssetLoader::workerMain, this);
+        }
+    }
+
+    void AssetLoader::workerMain() {
+        // Font first: the loading screen and the number textures need it
+        auto font = std::make_unique<sf::Font>();
+        if (!AssetManager::loadFontFile(*font)) {
+            font.reset();
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            font_ = std::move(font);
+            fontReady_ = true;
+        }
+        
+        for (const AssetManager::ImageJob& job : jobs_) {
+            if (cancelled_) {
+                return;
+            }
+            
+            sf::Image image = job.generate();
+            
+            std::lock_guard<std::mutex> lock(mutex_);
+            readyImages_.emplace_back(job.name, std::move(image));
+        }
+    }
+
+    void AssetLoader::uploadStep(sf::Time budget) {
+        sf::Clock clock;
+        
+        while (!isFinished()) {
+            if (!fontUploaded_) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (fontReady_) {
+                    if (font_) {
+                        assetManager_->setFont(std::move(font_));
+                    }
+                    fontUploaded_ = true;
+                    completed_++;
+                }
+            }
+            
+            std::pair<std::string, sf::Image> ready;
+            bool hasImage = false;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!readyImages_.empty()) {
+                    ready = std::move(readyImages_.front());
+                    readyImages_.pop_front();
+                    hasImage = true;
+                }
+            }
+            
+            if (hasImage) {
+                assetManager_->uploadTexture(ready.first, ready.second);
+                completed_++;
+            } else if (fontUploaded_ && fontTexturesDone_ < AssetManager::FONT_TEXTURE_COUNT) {
+                assetManager_->generateFontTexture(fontTexturesDone_++);
+                completed_++;
+            } else {
+                // Nothing ready yet, the worker is still busy
+                break;
+            }
+            
+            if (clock.getElapsedTime() >= budget) {
+                break;
+            }
+        }
+        
+        if (isFinished()) {
+            assetManager_->markLoaded();
+        }
+    }
+
+    float AssetLoader::getProgress() const {
+        return total_ > 0 ? static_cast<float>(completed_) / total_ : 1.0f;
+    }
+}
@@ -0,0 +1,272 @@
+#include "Renderer/ImageGenerator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace Minesweeper {
+    sf::Image ImageGenerator::createHiddenTile(int size) {
+        sf::Image image;
+        image.create(size, size, sf::Color(192, 192, 192));
+        
+        // 3D effect: light top/left borders, dark bottom/right borders
+        fillRect(image, 0, 0, size, 2, sf::Color(255, 255, 255));
+        fillRect(image, 0, 0, 2, size, sf::Color(255, 255, 255));
+        fillRect(image, 0, size - 2, size, 2, sf::Color(128, 128, 128));
+        fillRect(image, size - 2, 0, 2, size, sf::Color(128, 128, 128));
+        
+        // Inner bevel
+        fillRect(image, 2, 2, size - 4, size - 4, sf::Color(192, 192, 192));
+        return image;
+    }
+
+    sf::Image ImageGenerator::createRevealedTile(int size) {
+        sf::Image image;
+        image.create(size, size, sf::Color(220, 220, 220));
+        
+        // Subtle 1px border
+        sf::Color border(180, 180, 180);
+        fillRect(image, 0, 0, size, 1, border);
+        fillRect(image, 0, size - 1, size, 1, border);
+        fillRect(image, 0, 0, 1, size, border);
+        fillRect(image, size - 1, 0, 1, size, border);
+        return image;
+    }
+
+    sf::Image ImageGenerator::createMine(int size) {
+        float center = size / 2.0f;
+        sf::Image image;
+        image.create(size, size, sf::Color(220, 220, 220));
+        
+        // Mine body
+        fillCircle(image, center, center, center - 4, sf::Color::Black);
+        
+        // Spikes
+        for (int i = 0; i < 8; ++i) {
+            float angle = i * 45.0f * 3.14159f / 180.0f;
+            sf::Vector2f from(center + std::cos(angle) * (center - 8), center + std::sin(angle) * (center - 8));
+            sf::Vector2f to(center + std::cos(angle) * (center + 2), center + std::sin(angle) * (center + 2));
+            drawLine(image, from, to, sf::Color::Black);
+        }
+        
+        // Highlight
+        fillCircle(image, center, center, center - 8, sf::Color(100, 100, 100));
+        return image;
+    }
+
+    sf::Image ImageGenerator::createFlag(int size) {
+        int center = size / 2;
+        sf::Image image;
+        image.create(size, size, sf::Color(192, 192, 192));
+        
+        // Pole
+        fillRect(image, center - 1, 4, 2, size - 8, sf::Color::Black);
+        
+        // Red triangle
+        fillTriangle(image,
+                     sf::Vector2f(center + 1.0f, 8.0f),
+                     sf::Vector2f(center + 1.0f, size / 2.0f),
+                     sf::Vector2f(size - 4.0f, center - 4.0f),
+                     sf::Color::Red);
+        return image;
+    }
+
+    sf::Image ImageGenerator::createFace(const std::string& faceType) {
+        sf::Color faceColor = sf::Color::Yellow;
+        if (faceType == "win") {
+            faceColor = sf::Color::Green;
+        } else if (faceType == "lose") {
+            faceColor = sf::Color::Red;
+        }
+        
+        sf::Image image;
+        image.create(60, 60, faceColor);
+        
+        // Face with a 2px outline
+        fillCircle(image, 30.0f, 30.0f, 27.0f, sf::Color::Black);
+        fillCircle(image, 30.0f, 30.0f, 25.0f, sf::Color(255, 255, 200));
+        
+        // Eyes
+        fillCircle(image, 23.0f, 25.0f, 5.0f, sf::Color::Black);
+        fillCircle(image, 43.0f, 25.0f, 5.0f, sf::Color::Black);
+        
+        // Mouth
+        if (faceType == "happy") {
+            fillEllipseRing(image, 30.0f, 34.0f, 12.0f, 6.0f, 2.0f, sf::Color::Black);
+        } else if (faceType == "win") {
+            fillEllipseRing(image, 30.0f, 34.4f, 14.0f, 8.4f, 2.0f, sf::Color::Black);
+        } else if (faceType == "lose") {
+            drawLine(image, sf::Vector2f(18, 40), sf::Vector2f(30, 44), sf::Color::Black);
+            drawLine(image, sf::Vector2f(30, 44), sf::Vector2f(42, 40), sf::Color::Black);
+        }
+        
+        return image;
+    }
+
+    sf::Image ImageGenerator::createMainMenuBackground(int width, int height, unsigned seed) {
+        sf::Image image;
+        image.create(width, height, sf::Color::Black);
+        
+        // Dégradé bleu foncé -> violet
+        for (int y = 0; y < height; ++y) {
+            float t = static_cast<float>(y) / height;
+            sf::Color color(
+                static_cast<sf::Uint8>(30 + t * 40),   // R
+                static_cast<sf::Uint8>(30 + t * 30),   // G
+                static_cast<sf::Uint8>(46 + t * 60)    // B
+            );
+            fillRect(image, 0, y, width, 1, color);
+        }
+        
+        // Mines décoratives
+        std::mt19937 gen(seed);
+        for (int i = 0; i < 15; ++i) {
+            float x = static_cast<float>(gen() % width);
+            float y = static_cast<float>(gen() % height);
+            float radius = 3.0f + static_cast<float>(gen() % 10);
+            sf::Vector2f center(x + radius, y + radius);
+            
+            fillCircle(image, center.x, center.y, radius, sf::Color(255, 255, 255, 30));
+            
+            // "Rayons" pour certaines mines
+            if (i % 3 == 0) {
+                for (int j = 0; j < 8; ++j) {
+                    float angle = j * 45.0f * 3.14159f / 180.0f;
+                    sf::Vector2f end(center.x + std::cos(angle) * (radius * 2),
+                                     center.y + std::sin(angle) * (radius * 2));
+                    drawLine(image, center, end, sf::Color(255, 255, 255, 20));
+                }
+            }
+        }
+        
+        return image;
+    }
+
+    sf::Image ImageGenerator::createDifficultyBackground(int width, int height) {
+        sf::Image image;
+        image.create(width, height, sf::Color::Black);
+        
+        for (int y = 0; y < height; ++y) {
+            float t = static_cast<float>(y) / height;
+            sf::Color color(
+                static_cast<sf::Uint8>(60 + t * 20),
+                static_cast<sf::Uint8>(45 + t * 30),
+                static_cast<sf::Uint8>(80 + t * 40)
+            );
+            fillRect(image, 0, y, width, 1, color);
+        }
+        
+        return image;
+    }
+
+    void ImageGenerator::blendPixel(sf::Image& image, int x, int y, const sf::Color& color) {
+        sf::Vector2u size = image.getSize();
+        if (x < 0 || y < 0 || x >= static_cast<int>(size.x) || y >= static_cast<int>(size.y)) {
+            return;
+        }
+        
+        if (color.a == 255) {
+            image.setPixel(x, y, color);
+            return;
+        }
+        
+        sf::Color dst = image.getPixel(x, y);
+        int a = color.a;
+        dst.r = static_cast<sf::Uint8>((color.r * a + dst.r * (255 - a)) / 255);
+        dst.g = static_cast<sf::Uint8>((color.g * a + dst.g * (255 - a)) / 255);
+        dst.b = static_cast<sf::Uint8>((color.b * a + dst.b * (255 - a)) / 255);
+        dst.a = static_cast<sf::Uint8>(std::min(255, a + dst.a * (255 - a) / 255));
+        image.setPixel(x, y, dst);
+    }
+
+    void ImageGenerator::fillRect(sf::Image& image, int x, int y, int width, int height, const sf::Color& color) {
+        for (int py = y; py < y + height; ++py) {
+            for (int px = x; px < x + width; ++px) {
+                blendPixel(image, px, py, color);
+            }
+        }
+    }
+
+    void ImageGenerator::fillCircle(sf::Image& image, float cx, float cy, float radius, const sf::Color& color) {
+        int minX = static_cast<int>(std::floor(cx - radius));
+        int maxX = static_cast<int>(std::ceil(cx + radius));
+        int minY = static_cast<int>(std::floor(cy - radius));
+        int maxY = static_cast<int>(std::ceil(cy + radius));
+        
+        for (int y = minY; y <= maxY; ++y) {
+            for (int x = minX; x <= maxX; ++x) {
+                // Sample at the pixel center
+                float dx = x + 0.5f - cx;
+                float dy = y + 0.5f - cy;
+                if (dx * dx + dy * dy <= radius * radius) {
+                    blendPixel(image, x, y, color);
+                }
+            }
+        }
+    }
+
+    void ImageGenerator::fillEllipseRing(sf::Image& image, float cx, float cy, float rx, float ry,
+                                         float thickness, const sf::Color& color) {
+        float outerX = rx + thickness;
+        float outerY = ry + thickness;
+        
+        for (int y = static_cast<int>(cy - outerY); y <= static_cast<int>(cy + outerY); ++y) {
+            for (int x = static_cast<int>(cx - outerX); x <= static_cast<int>(cx + outerX); ++x) {
+                float dx = x + 0.5f - cx;
+                float dy = y + 0.5f - cy;
+                float inner = (dx * dx) / (rx * rx) + (dy * dy) / (ry * ry);
+                float outer = (dx * dx) / (outerX * outerX) + (dy * dy) / (outerY * outerY);
+                if (inner >= 1.0f && outer <= 1.0f) {
+                    blendPixel(image, x, y, color);
+                }
+            }
+        }
+    }
+
+    void ImageGenerator::fillTriangle(sf::Image& image, sf::Vector2f a, sf::Vector2f b, sf::Vector2f c,
+                                      const sf::Color& color) {
+        auto edge = [](sf::Vector2f p, sf::Vector2f q, float x, float y) {
+            return (q.x - p.x) * (y - p.y) - (q.y - p.y) * (x - p.x);
+        };
+        
+        float area = edge(a, b, c.x, c.y);
+        if (area == 0.0f) {
+            return;
+        }
+        
+        int minX = static_cast<int>(std::floor(std::min({a.x, b.x, c.x})));
+        int maxX = static_cast<int>(std::ceil(std::max({a.x, b.x, c.x})));
+        int minY = static_cast<int>(std::floor(std::min({a.y, b.y, c.y})));
+        int maxY = static_cast<int>(std::ceil(std::max({a.y, b.y, c.y})));
+        
+        for (int y = minY; y <= maxY; ++y) {
+            for (int x = minX; x <= maxX; ++x) {
+                float px = x + 0.5f;
+                float py = y + 0.5f;
+                float w0 = edge(b, c, px, py) / area;
+                float w1 = edge(c, a, px, py) / area;
+                float w2 = edge(a, b, px, py) / area;
+                if (w0 >= 0.0f && w1 >= 0.0f && w2 >= 0.0f) {
+                    blendPixel(image, x, y, color);
+                }
+            }
+        }
+    }
+
+    void ImageGenerator::drawLine(sf::Image& image, sf::Vector2f from, sf::Vector2f to, const sf::Color& color) {
+        float dx = to.x - from.x;
+        float dy = to.y - from.y;
+        int steps = static_cast<int>(std::ceil(std::max(std::abs(dx), std::abs(dy))));
+        if (steps == 0) {
+            blendPixel(image, static_cast<int>(from.x), static_cast<int>(from.y), color);
+            return;
+        }
+        
+        for (int i = 0; i <= steps; ++i) {
+            float t = static_cast<float>(i) / steps;
+            blendPixel(image,
+                       static_cast<int>(std::floor(from.x + dx * t)),
+                       static_cast<int>(std::floor(from.y + dy * t)),
+                       color);
+        }
+    }
+}
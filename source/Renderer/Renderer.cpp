@@ -1,97 +1,197 @@
 #include "Renderer/Renderer.hpp"
 #include <algorithm>
+#include <cstdio>
 #include <iostream>
 
 namespace Minesweeper {
     Renderer::Renderer(std::shared_ptr<GameLogic> gameLogic,
                       std::shared_ptr<AssetManager> assetManager)
         : gameLogic_(gameLogic), assetManager_(assetManager) {
+        // The reveal animation needs the cascades level by level
+        if (gameLogic_) {
+            gameLogic_->getBoard()->setRevealLevels(true);
+        }
+        updateLayout();
+    }
+
+    Renderer::~Renderer() {
+        if (gameLogic_) {
+            gameLogic_->getBoard()->setRevealLevels(false);
+        }
+    }
+
+    void Renderer::updateLayout() {
+        if (!gameLogic_) return;
+        
+        const BoardView board = gameLogic_->getBoardView();
+        int areaWidth = Config::WINDOW_WIDTH;
+        int areaHeight = Config::WINDOW_HEIGHT - Config::UI_HEIGHT;
+        
+        tileSize_ = std::min({Config::TILE_SIZE,
+                              areaWidth / std::max(1, board.getWidth()),
+                              areaHeight / std::max(1, board.getHeight())});
+        tileSize_ = std::max(1, tileSize_);
+        
+        // Center the board in the area below the UI panel
+        boardOrigin_.x = (areaWidth - board.getWidth() * tileSize_) / 2.0f;
+        boardOrigin_.y = Config::UI_HEIGHT + (areaHeight - board.getHeight() * tileSize_) / 2.0f;
     }
 
-    void Renderer::render(sf::RenderWindow& window) {
-        renderBoard(window);
-        renderUI(window);
+    void Renderer::update(float deltaTime) {
+        if (!gameLogic_) return;
+        
+        revealScheduler_.update(gameLogic_->getBoardView(), deltaTime, &releasedCells_);
+        renderLead_ = 0.0f;
     }
 
-    void Renderer::renderBoard(sf::RenderWindow& window) {
+    void Renderer::interpolate(float alpha) {
+        renderLead_ = alpha / Config::SIMULATION_RATE;
+    }
+
+    void Renderer::render(sf::RenderTarget& target) {
         if (!gameLogic_ || !assetManager_) return;
         
-        auto board = gameLogic_->getBoard();
-        if (!board) return;
+        const BoardView board = gameLogic_->getBoardView();
         
-        for (int y = 0; y < board->getHeight(); ++y) {
-            for (int x = 0; x < board->getWidth(); ++x) {
-                renderCell(window, x, y);
-            }
+        updateBoardLayer(board);
+        if (boardLayerReady_) {
+            sf::Sprite layer(boardLayer_.getTexture());
+            layer.setPosition(boardOrigin_);
+            target.draw(layer);
+        } else {
+            renderBoard(target, board);
         }
+        renderUI(target, board);
     }
 
-    void Renderer::renderCell(sf::RenderWindow& window, int x, int y) {
-        if (!gameLogic_ || !assetManager_) return;
+    void Renderer::updateBoardLayer(const BoardView& board) {
+        // A cascade from this frame's input has to be pending before its
+        // cells are drawn, even when no update step ran since
+        revealScheduler_.update(board, 0.0f, &releasedCells_, renderLead_);
+        
+        // The old drawing stays up (the cascade still hidden) until all of
+        // it is marked pending; the dirty region waits on the board
+        if (revealScheduler_.isPreparing() && boardLayerReady_) {
+            return;
+        }
+        
+        DirtyRegion dirty = gameLogic_->takeDirtyRegion();
+        if (boardLayerFailed_) {
+            releasedCells_.clear();
+            return;
+        }
+        
+        if (!boardLayerReady_) {
+            unsigned width = static_cast<unsigned>(board.getWidth() * tileSize_);
+            unsigned height = static_cast<unsigned>(board.getHeight() * tileSize_);
+            if (!boardLayer_.create(width, height)) {
+                std::cerr << "Board layer unavailable, drawing cells every frame" << std::endl;
+                boardLayerFailed_ = true;
+                releasedCells_.clear();
+                return;
+            }
+            boardLayer_.clear(sf::Color::Transparent);
+            boardLayerReady_ = true;
+            dirty = DirtyRegion();
+            dirty.include(0, 0);
+            dirty.include(board.getWidth() - 1, board.getHeight() - 1);
+        }
+        
+        if (dirty.isEmpty() && releasedCells_.empty()) {
+            return;
+        }
+        
+        // Cells are drawn at board coordinates inside the layer
+        const sf::Vector2f origin(0.0f, 0.0f);
+        bool gameOver = gameLogic_->isGameOver();
+        
+        if (!dirty.isEmpty()) {
+            for (int y = dirty.minY; y <= dirty.maxY; ++y) {
+                BoardView::RowSpan row = board.row(y);
+                for (int x = dirty.minX; x <= dirty.maxX; ++x) {
+                    renderCell(boardLayer_, row[x], x, y, origin, gameOver, revealScheduler_.isPending(board, x, y));
+                }
+            }
+        }
+        for (size_t index : releasedCells_) {
+            int x, y;
+            board.cellPosition(index, x, y);
+            renderCell(boardLayer_, board.getCell(x, y), x, y, origin, gameOver, revealScheduler_.isPending(board, x, y));
+        }
+        releasedCells_.clear();
         
-        auto board = gameLogic_->getBoard();
-        if (!board) return;
+        boardLayer_.display();
+    }
+
+    void Renderer::renderBoard(sf::RenderTarget& target, const BoardView& board) {
+        bool gameOver = gameLogic_->isGameOver();
         
-        const Cell& cell = board->getCell(x, y);
+        for (int y = 0; y < board.getHeight(); ++y) {
+            BoardView::RowSpan row = board.row(y);
+            for (int x = 0; x < row.size(); ++x) {
+                renderCell(target, row[x], x, y, boardOrigin_, gameOver, revealScheduler_.isPending(board, x, y));
+            }
+        }
+    }
+
+    void Renderer::renderCell(sf::RenderTarget& target, const Cell& cell, int x, int y,
+                              const sf::Vector2f& origin, bool gameOver, bool revealPending) {
+        // Cells of a cascade stay hidden until the animation reaches them
+        bool revealed = cell.isRevealed() && !revealPending;
         
         // Get the appropriate texture
         const sf::Texture& texture = assetManager_->getTileTexture(
-            !cell.isRevealed(),
+            !revealed,
             cell.isFlagged(),
-            cell.isRevealed(),
+            revealed,
             cell.hasMine(),
             cell.getAdjacentMines()
         );
         
         // Create sprite
         sf::Sprite sprite(texture);
-        sprite.setPosition(x * Config::TILE_SIZE, 
-                          y * Config::TILE_SIZE + Config::UI_HEIGHT);
+        sf::Vector2f position(origin.x + x * tileSize_,
+                              origin.y + y * tileSize_);
+        sprite.setPosition(position);
         
         // Scale if needed
         sf::Vector2u texSize = texture.getSize();
-        if (texSize.x != Config::TILE_SIZE || texSize.y != Config::TILE_SIZE) {
+        if (texSize.x != static_cast<unsigned>(tileSize_) || texSize.y != static_cast<unsigned>(tileSize_)) {
             sprite.setScale(
-                Config::TILE_SIZE / static_cast<float>(texSize.x),
-                Config::TILE_SIZE / static_cast<float>(texSize.y)
+                tileSize_ / static_cast<float>(texSize.x),
+                tileSize_ / static_cast<float>(texSize.y)
             );
         }
         
-        window.draw(sprite);
+        target.draw(sprite);
         
         // If the cell is revealed and has a mine, draw an explosion effect when game is lost
-        if (cell.isRevealed() && cell.hasMine() && gameLogic_->isGameOver()) {
+        if (cell.isRevealed() && cell.hasMine() && gameOver) {
             // Draw a red circle over the mine to indicate explosion
-            sf::CircleShape explosion(Config::TILE_SIZE / 2);
+            sf::CircleShape explosion(tileSize_ / 2.0f);
             explosion.setFillColor(sf::Color(255, 0, 0, 100)); // Semi-transparent red
-            explosion.setPosition(x * Config::TILE_SIZE, 
-                                 y * Config::TILE_SIZE + Config::UI_HEIGHT);
-            window.draw(explosion);
+            explosion.setPosition(position);
+            target.draw(explosion);
         }
     }
 
-    void Renderer::renderUI(sf::RenderWindow& window) {
+    void Renderer::renderUI(sf::RenderTarget& target, const BoardView& board) {
         // Draw UI background
         sf::RectangleShape uiBackground(sf::Vector2f(Config::WINDOW_WIDTH, Config::UI_HEIGHT));
         uiBackground.setFillColor(sf::Color(Config::UI_BACKGROUND_COLOR));
-        window.draw(uiBackground);
+        target.draw(uiBackground);
         
         // Draw UI elements
-        renderMineCounter(window);
-        renderTimer(window);
-        renderFaceButton(window);
+        renderMineCounter(target, board);
+        renderTimer(target);
+        renderFaceButton(target);
         
         // Draw game status text
-        renderGameStatus(window);
+        renderGameStatus(target, board);
     }
 
-    void Renderer::renderMineCounter(sf::RenderWindow& window) {
-        if (!gameLogic_ || !assetManager_) return;
-        
-        auto board = gameLogic_->getBoard();
-        if (!board) return;
-        
-        int minesLeft = board->getMineCount() - board->getFlagCount();
+    void Renderer::renderMineCounter(sf::RenderTarget& target, const BoardView& board) {
+        int minesLeft = board.getMineCount() - board.getFlagCount();
         minesLeft = std::max(0, minesLeft); // Ensure non-negative
         
         // Create a background panel for the counter
@@ -100,7 +200,7 @@ namespace Minesweeper {
         counterBackground.setPosition(30, 30); // Ajusté la position verticale
         counterBackground.setOutlineThickness(2);
         counterBackground.setOutlineColor(sf::Color::White);
-        window.draw(counterBackground);
+        target.draw(counterBackground);
         
         // Draw counter using text
         sf::Text counterText;
@@ -117,7 +217,7 @@ namespace Minesweeper {
             25 + (50 - textBounds.height) / 2 - textBounds.top
         );
         
-        window.draw(counterText);
+        target.draw(counterText);
         
         // Draw label above counter
         sf::Text labelText;
@@ -126,12 +226,10 @@ namespace Minesweeper {
         labelText.setCharacterSize(16);
         labelText.setFillColor(sf::Color::White);
         labelText.setPosition(30, 5);
-        window.draw(labelText);
+        target.draw(labelText);
     }
 
-    void Renderer::renderTimer(sf::RenderWindow& window) {
-        if (!gameLogic_ || !assetManager_) return;
-        
+    void Renderer::renderTimer(sf::RenderTarget& target) {
         int gameTime = gameLogic_->getGameTime();
         
         // Create a background panel for the timer
@@ -140,7 +238,7 @@ namespace Minesweeper {
         timerBackground.setPosition(Config::WINDOW_WIDTH - 170, 30); // Ajusté la position
         timerBackground.setOutlineThickness(2);
         timerBackground.setOutlineColor(sf::Color::White);
-        window.draw(timerBackground);
+        target.draw(timerBackground);
         
         // Draw timer using text
         sf::Text timerText;
@@ -157,7 +255,7 @@ namespace Minesweeper {
             25 + (50 - textBounds.height) / 2 - textBounds.top
         );
         
-        window.draw(timerText);
+        target.draw(timerText);
         
         // Draw label above timer
         sf::Text labelText;
@@ -166,28 +264,26 @@ namespace Minesweeper {
         labelText.setCharacterSize(16);
         labelText.setFillColor(sf::Color::White);
         labelText.setPosition(Config::WINDOW_WIDTH - 170, 5);
-        window.draw(labelText);
+        target.draw(labelText);
     }
 
-    void Renderer::renderFaceButton(sf::RenderWindow& window) {
-        if (!gameLogic_ || !assetManager_) return;
-        
+    void Renderer::renderFaceButton(sf::RenderTarget& target) {
         Config::GameState state = gameLogic_->getGameState();
         const sf::Texture& faceTexture = assetManager_->getFaceTexture(state);
         
         sf::Sprite faceSprite(faceTexture);
         
-        // Center the face button - position ajustée
-        float x = (Config::WINDOW_WIDTH - 70) / 2.0f;
-        float y = (Config::UI_HEIGHT - 70) / 2.0f + 10; // Décalé vers le bas
+        sf::FloatRect bounds = getFaceButtonBounds();
+        float x = bounds.left;
+        float y = bounds.top;
         
         // Draw button background
-        sf::RectangleShape buttonBackground(sf::Vector2f(70, 70)); // Bouton plus grand
+        sf::RectangleShape buttonBackground(sf::Vector2f(bounds.width, bounds.height));
         buttonBackground.setFillColor(sf::Color(50, 50, 70));
         buttonBackground.setPosition(x, y);
         buttonBackground.setOutlineThickness(3); // Bordure plus épaisse
         buttonBackground.setOutlineColor(sf::Color::White);
-        window.draw(buttonBackground);
+        target.draw(buttonBackground);
         
         // Position and draw face sprite
         faceSprite.setPosition(x + 10, y + 10); // Marge interne
@@ -198,12 +294,10 @@ namespace Minesweeper {
             faceSprite.setScale(50.0f / texSize.x, 50.0f / texSize.y);
         }
         
-        window.draw(faceSprite);
+        target.draw(faceSprite);
     }
 
-    void Renderer::renderGameStatus(sf::RenderWindow& window) {
-        if (!gameLogic_ || !assetManager_) return;
-        
+    void Renderer::renderGameStatus(sf::RenderTarget& target, const BoardView& board) {
         Config::GameState state = gameLogic_->getGameState();
         std::string statusText;
         sf::Color statusColor = sf::Color::White;
@@ -254,7 +348,7 @@ namespace Minesweeper {
             6.0f // Slight vertical offset
         );
 
-        window.draw(statusDisplay);
+        target.draw(statusDisplay);
         
         // Draw instructions at the bottom of UI area
         sf::Text instructions;
@@ -275,54 +369,95 @@ namespace Minesweeper {
             Config::UI_HEIGHT - 25 // Position ajustée
         );
         
-        window.draw(instructions);
+        target.draw(instructions);
         
         // Draw additional game info
         if (state == Config::GameState::PLAYING) {
-            auto board = gameLogic_->getBoard();
-            if (board) {
-                int revealed = board->getRevealedCount();
-                int totalCells = board->getWidth() * board->getHeight();
-                int mines = board->getMineCount();
-                
-                std::string infoText = "Progress: " + std::to_string(revealed) + "/" + 
-                                      std::to_string(totalCells - mines) + " safe cells";
-                
-                sf::Text gameInfo;
-                gameInfo.setFont(assetManager_->getFont());
-                gameInfo.setString(infoText);
-                gameInfo.setCharacterSize(14);
-                gameInfo.setFillColor(sf::Color(180, 180, 220));
-                
-                sf::FloatRect infoBounds = gameInfo.getLocalBounds();
-                // Position the progress text below the face button to avoid overlap
-                float faceTop = (Config::UI_HEIGHT - 70.0f) / 2.0f + 10.0f; // matches renderFaceButton layout
-                float faceBottom = faceTop + 70.0f;
-                float infoY = faceBottom + 6.0f; // small gap under the face button
-
-                // If computed position is too low, clamp it to a reasonable area inside the UI
-                if (infoY + infoBounds.height > static_cast<float>(Config::UI_HEIGHT) - 6.0f) {
-                    infoY = static_cast<float>(Config::UI_HEIGHT) - infoBounds.height - 6.0f;
-                }
+            int revealed = board.getRevealedCount();
+            int totalCells = board.getWidth() * board.getHeight();
+            int mines = board.getMineCount();
+            
+            std::string infoText = "Progress: " + std::to_string(revealed) + "/" + 
+                                  std::to_string(totalCells - mines) + " safe cells";
+            
+            sf::Text gameInfo;
+            gameInfo.setFont(assetManager_->getFont());
+            gameInfo.setString(infoText);
+            gameInfo.setCharacterSize(14);
+            gameInfo.setFillColor(sf::Color(180, 180, 220));
+            
+            sf::FloatRect infoBounds = gameInfo.getLocalBounds();
+            // Position the progress text below the face button to avoid overlap
+            float faceTop = (Config::UI_HEIGHT - 70.0f) / 2.0f + 10.0f; // matches renderFaceButton layout
+            float faceBottom = faceTop + 70.0f;
+            float infoY = faceBottom + 6.0f; // small gap under the face button
 
-                gameInfo.setPosition(
-                    (Config::WINDOW_WIDTH - infoBounds.width) / 2.0f - infoBounds.left,
-                    infoY
-                );
-                
-                window.draw(gameInfo);
+            // If computed position is too low, clamp it to a reasonable area inside the UI
+            if (infoY + infoBounds.height > static_cast<float>(Config::UI_HEIGHT) - 6.0f) {
+                infoY = static_cast<float>(Config::UI_HEIGHT) - infoBounds.height - 6.0f;
             }
+
+            gameInfo.setPosition(
+                (Config::WINDOW_WIDTH - infoBounds.width) / 2.0f - infoBounds.left,
+                infoY
+            );
+            
+            target.draw(gameInfo);
+        }
+        
+        // 3BV stats under the side panels, kept on the final screen too
+        const BoardMetrics& metrics = board.getMetrics();
+        if (metrics.bbbv > 0) {
+            char rates[48];
+            std::snprintf(rates, sizeof(rates), "3BV/s %.2f | Eff %d%%",
+                          gameLogic_->getBBBVPerSecond(),
+                          static_cast<int>(gameLogic_->getClickEfficiency() * 100.0 + 0.5));
+            
+            sf::Text bbbvText;
+            bbbvText.setFont(assetManager_->getFont());
+            bbbvText.setString("3BV " + std::to_string(board.getSolvedBBBV()) + "/" +
+                               std::to_string(metrics.bbbv));
+            bbbvText.setCharacterSize(14);
+            bbbvText.setFillColor(sf::Color(180, 180, 220));
+            bbbvText.setPosition(30, 88); // under the mine counter
+            target.draw(bbbvText);
+            
+            sf::Text rateText;
+            rateText.setFont(assetManager_->getFont());
+            rateText.setString(rates);
+            rateText.setCharacterSize(14);
+            rateText.setFillColor(sf::Color(180, 180, 220));
+            sf::FloatRect rateBounds = rateText.getLocalBounds();
+            rateText.setPosition(Config::WINDOW_WIDTH - 30 - rateBounds.width - rateBounds.left, 88); // under the timer
+            target.draw(rateText);
         }
     }
 
+    sf::FloatRect Renderer::getFaceButtonBounds() const {
+        // Center the face button - position ajustée, décalé vers le bas
+        return sf::FloatRect((Config::WINDOW_WIDTH - 70) / 2.0f, (Config::UI_HEIGHT - 70) / 2.0f + 10, 70, 70);
+    }
+
+    bool Renderer::isOnFaceButton(int screenX, int screenY) const {
+        sf::FloatRect bounds = getFaceButtonBounds();
+        return screenX >= bounds.left && screenX <= bounds.left + bounds.width &&
+               screenY >= bounds.top && screenY <= bounds.top + bounds.height;
+    }
+
     sf::Vector2i Renderer::screenToBoardPosition(int screenX, int screenY) const {
-        int boardX = screenX / Config::TILE_SIZE;
-        int boardY = (screenY - Config::UI_HEIGHT) / Config::TILE_SIZE;
+        float localX = screenX - boardOrigin_.x;
+        float localY = screenY - boardOrigin_.y;
+        if (localX < 0 || localY < 0) {
+            return sf::Vector2i(-1, -1);
+        }
+        
+        int boardX = static_cast<int>(localX) / tileSize_;
+        int boardY = static_cast<int>(localY) / tileSize_;
         
         return sf::Vector2i(boardX, boardY);
     }
 
-    void Renderer::drawDigit(sf::RenderWindow& window, int digit, int x, int y) {
+    void Renderer::drawDigit(sf::RenderTarget& target, int digit, int x, int y) {
         if (!assetManager_) return;
         
         // Since we're not using digit textures anymore, use text instead
@@ -333,10 +468,10 @@ namespace Minesweeper {
         digitText.setFillColor(sf::Color::Red);
         digitText.setPosition(x, y);
         
-        window.draw(digitText);
+        target.draw(digitText);
     }
 
-    void Renderer::drawNumber(sf::RenderWindow& window, int number, int x, int y, int digitCount) {
+    void Renderer::drawNumber(sf::RenderTarget& target, int number, int x, int y, int digitCount) {
         number = std::max(0, std::min(999, number));
         
         std::string numberStr = std::to_string(number);
@@ -346,7 +481,7 @@ namespace Minesweeper {
         
         for (size_t i = 0; i < numberStr.length(); ++i) {
             int digit = numberStr[i] - '0';
-            drawDigit(window, digit, x + static_cast<int>(i) * 24, y);
+            drawDigit(target, digit, x + static_cast<int>(i) * 24, y);
         }
     }
 }
\ No newline at end of file
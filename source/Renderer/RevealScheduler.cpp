@@ -0,0 +1,86 @@
+#include "Renderer/RevealScheduler.hpp"
+#include "Logic/Bits.hpp"
+#include <algorithm>
+
+namespace Minesweeper {
+    void RevealScheduler::start(const BoardView& board, std::vector<size_t>* released) {
+        // The previous trace is gone: cells still hidden from it show up at
+        // once, found in the bitplane (a word per 64 cells)
+        size_t words = (board.getStorageSize() + 63) / 64;
+        if ((animating_ || preparing_) && pending_.size() == words) {
+            for (size_t word = 0; word < words; ++word) {
+                for (std::uint64_t bits = pending_[word]; bits != 0 && released; bits &= bits - 1) {
+                    released->push_back(word * 64 + static_cast<size_t>(Bits::lowestBit(bits)));
+                }
+                pending_[word] = 0;
+            }
+        } else if (pending_.size() != words) {
+            pending_.assign(words, 0);
+        }
+        
+        // The clicked cell (level 0) shows up right away
+        const RevealTrace& trace = board.getLastReveal();
+        size_t firstHidden = trace.getLevelCount() > 1 ? trace.levelStarts[1] : trace.cells.size();
+        markedCell_ = firstHidden;
+        nextCell_ = firstHidden;
+        levelClock_ = 1.0f;
+        levelsPerSecond_ = std::max(LEVELS_PER_SECOND, trace.getLevelCount() / MAX_DURATION);
+        preparing_ = nextCell_ < trace.cells.size();
+        animating_ = false;
+    }
+
+    void RevealScheduler::update(const BoardView& board, float deltaTime,
+                                 std::vector<size_t>* released, float lead) {
+        if (board.getRevealSerial() != serial_) {
+            serial_ = board.getRevealSerial();
+            start(board, released);
+        }
+        
+        if (!preparing_ && !animating_) {
+            return;
+        }
+        
+        const RevealTrace& trace = board.getLastReveal();
+        sf::Clock budget;
+        
+        // Mark the cascade pending first; the levels start once it is done
+        while (preparing_) {
+            size_t end = std::min(trace.cells.size(), markedCell_ + CELLS_PER_CLOCK_CHECK);
+            for (; markedCell_ < end; ++markedCell_) {
+                size_t index = trace.cells[markedCell_];
+                pending_[index >> 6] |= std::uint64_t(1) << (index & 63);
+            }
+            if (markedCell_ >= trace.cells.size()) {
+                preparing_ = false;
+                animating_ = true;
+            } else if (budget.getElapsedTime().asMicroseconds() >= BUDGET_MICROSECONDS) {
+                return;
+            }
+        }
+        
+        levelClock_ += deltaTime * levelsPerSecond_;
+        size_t dueLevels = std::min(trace.getLevelCount(),
+                                    static_cast<size_t>(levelClock_ + lead * levelsPerSecond_));
+        size_t dueCells = dueLevels < trace.getLevelCount() ? trace.levelStarts[dueLevels] : trace.cells.size();
+        
+        // Release in BFS order until the due level or the frame budget
+        while (nextCell_ < dueCells) {
+            size_t end = std::min(dueCells, nextCell_ + CELLS_PER_CLOCK_CHECK);
+            if (released) {
+                released->insert(released->end(), trace.cells.begin() + nextCell_, trace.cells.begin() + end);
+            }
+            for (; nextCell_ < end; ++nextCell_) {
+                size_t index = trace.cells[nextCell_];
+                pending_[index >> 6] &= ~(std::uint64_t(1) << (index & 63));
+            }
+            
+            if (budget.getElapsedTime().asMicroseconds() >= BUDGET_MICROSECONDS) {
+                break;
+            }
+        }
+        
+        if (nextCell_ >= trace.cells.size()) {
+            animating_ = false;
+        }
+    }
+}
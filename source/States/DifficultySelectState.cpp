@@ -1,44 +1,22 @@
 #include "States/DifficultySelectState.hpp"
 #include "States/PlayingState.hpp"
+#include "States/EndlessState.hpp"
 #include "Game/Config.hpp"
 #include <iostream>
-#include <cstdlib>
-#include <ctime>
 
 namespace Minesweeper {
     DifficultySelectState::DifficultySelectState(sf::RenderWindow& window, StateManager& stateManager) 
-        : StateWithManager(window, stateManager) {
+        : StateWithManager(window, stateManager),
+          font_(stateManager.getAssetManager()->getFont()) {
         
-        std::srand(static_cast<unsigned>(std::time(nullptr)));
-        
-        if (!font_.loadFromFile("assets/fonts/arial.ttf")) {
-            std::cerr << "Failed to load font in DifficultySelectState" << std::endl;
-            font_.loadFromFile("/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf");
-        }
+        stateManager_.getAssetManager()->ensureLoaded();
         
         createBackground();
         initializeMenu();
     }
     
     void DifficultySelectState::createBackground() {
-        sf::Image gradient;
-        gradient.create(Config::WINDOW_WIDTH, Config::WINDOW_HEIGHT, sf::Color::Transparent);
-        
-        for (int y = 0; y < Config::WINDOW_HEIGHT; ++y) {
-            float t = static_cast<float>(y) / Config::WINDOW_HEIGHT;
-            sf::Color color(
-                static_cast<sf::Uint8>(60 + t * 20),
-                static_cast<sf::Uint8>(45 + t * 30),
-                static_cast<sf::Uint8>(80 + t * 40)
-            );
-            
-            for (int x = 0; x < Config::WINDOW_WIDTH; ++x) {
-                gradient.setPixel(x, y, color);
-            }
-        }
-        
-        backgroundTexture_.loadFromImage(gradient);
-        backgroundSprite_.setTexture(backgroundTexture_);
+        backgroundSprite_.setTexture(stateManager_.getAssetManager()->getTexture("difficulty_background"), true);
     }
     
     void DifficultySelectState::initializeMenu() {
@@ -51,7 +29,10 @@ namespace Minesweeper {
         menu_->setPosition(Config::WINDOW_WIDTH / 2.0f, 140);
         menu_->setSpacing(40);
         
-        // Menu items
+        addItems();
+    }
+    
+    void DifficultySelectState::addItems() {
         menu_->addItem("DEBUTANT (9x9 - 10 mines)", [this]() {
             startGame(Config::Difficulty::BEGINNER, false);
         });
@@ -64,15 +45,26 @@ namespace Minesweeper {
             startGame(Config::Difficulty::EXPERT, false);
         });
         
+        menu_->addItem(noGuess_ ? "SANS DEVINER : OUI" : "SANS DEVINER : NON", [this]() {
+            noGuess_ = !noGuess_;
+            itemsChanged_ = true;
+        });
+        
+        menu_->addItem("MODE INFINI", [this]() {
+            stateManager_.changeState<EndlessState>(0, window_, stateManager_);
+        });
+        
         menu_->addItem("RETOUR AU MENU", [this]() {
             stateManager_.popState();
         });
     }
     
     void DifficultySelectState::startGame(Config::Difficulty difficulty, bool timed) {
-        // Créer une nouvelle partie - CORRECTION : passer stateManager_
-        auto playingState = std::make_unique<PlayingState>(window_, stateManager_);
-        stateManager_.changeState(std::move(playingState));
+        selectedDifficulty_ = difficulty;
+        
+        // Une instance de PlayingState est gardée par difficulté et par mode
+        stateManager_.changeState<PlayingState>(PlayingState::poolVariant(difficulty, noGuess_),
+                                                window_, stateManager_, difficulty, noGuess_);
     }
     
     void DifficultySelectState::handleEvents(sf::RenderWindow& window) {
@@ -94,13 +86,20 @@ namespace Minesweeper {
     }
     
     void DifficultySelectState::update(float deltaTime) {
+        if (itemsChanged_) {
+            int selected = menu_->getSelectedIndex();
+            menu_->clearItems();
+            addItems();
+            menu_->selectItem(selected);
+            itemsChanged_ = false;
+        }
         menu_->update();
     }
     
-    void DifficultySelectState::render(sf::RenderWindow& window) {
-        window.clear(sf::Color(Config::MENU_BACKGROUND_COLOR));
-        window.draw(backgroundSprite_);
-        menu_->render();
+    void DifficultySelectState::render(sf::RenderTarget& target) {
+        target.clear(sf::Color(Config::MENU_BACKGROUND_COLOR));
+        target.draw(backgroundSprite_);
+        menu_->render(target);
         
         // Info de difficulté
         auto settings = Config::getDifficultySettings(selectedDifficulty_);
@@ -109,7 +108,8 @@ namespace Minesweeper {
         infoText.setFont(font_);
         infoText.setString("Grille: " + std::to_string(settings.width) + "x" + 
                           std::to_string(settings.height) + 
-                          " | Mines: " + std::to_string(settings.mines));
+                          " | Mines: " + std::to_string(settings.mines) +
+                          (noGuess_ ? " | Sans deviner" : ""));
         
         infoText.setCharacterSize(18);
         infoText.setFillColor(sf::Color::Yellow);
@@ -117,7 +117,7 @@ namespace Minesweeper {
         
         sf::FloatRect bounds = infoText.getLocalBounds();
         infoText.setPosition((Config::WINDOW_WIDTH - bounds.width) / 2, 80);
-        window.draw(infoText);
+        target.draw(infoText);
         
         // Contrôles
         sf::Text controlsText;
@@ -126,10 +126,12 @@ namespace Minesweeper {
         controlsText.setCharacterSize(12);
         controlsText.setFillColor(sf::Color(200, 200, 200, 150));
         controlsText.setPosition(10, Config::WINDOW_HEIGHT - 25);
-        window.draw(controlsText);
+        target.draw(controlsText);
     }
     
     void DifficultySelectState::onEnter() {
+        menu_->selectItem(0);
+        
         std::cout << "Entering Difficulty Selection" << std::endl;
     }
     
@@ -0,0 +1,174 @@
+#include "States/EndlessState.hpp"
+#include "States/MainMenuState.hpp"
+#include "Game/Config.hpp"
+#include <cmath>
+#include <iostream>
+#include <random>
+
+namespace Minesweeper {
+    namespace {
+        constexpr int VIEW_WIDTH = Config::WINDOW_WIDTH;
+        constexpr int VIEW_HEIGHT = Config::WINDOW_HEIGHT - Config::UI_HEIGHT;
+    }
+
+    EndlessState::EndlessState(sf::RenderWindow& window, StateManager& stateManager)
+        : StateWithManager(window, stateManager),
+          assetManager_(stateManager.getAssetManager()),
+          board_(0, MINE_DENSITY) {
+        assetManager_->ensureLoaded();
+    }
+    
+    void EndlessState::startNewGame() {
+        std::random_device rd;
+        board_.reset((static_cast<std::uint64_t>(rd()) << 32) | rd());
+        gameOver_ = false;
+        
+        // Center the view on the safe area around the origin
+        camera_ = sf::Vector2f(-VIEW_WIDTH / (2.0f * Config::TILE_SIZE),
+                               -VIEW_HEIGHT / (2.0f * Config::TILE_SIZE));
+        previousCamera_ = camera_;
+        renderCamera_ = camera_;
+        evictTimer_ = 0.0f;
+    }
+    
+    sf::Vector2i EndlessState::screenToBoardPosition(int screenX, int screenY) const {
+        float x = renderCamera_.x + screenX / static_cast<float>(Config::TILE_SIZE);
+        float y = renderCamera_.y + (screenY - Config::UI_HEIGHT) / static_cast<float>(Config::TILE_SIZE);
+        return sf::Vector2i(static_cast<int>(std::floor(x)), static_cast<int>(std::floor(y)));
+    }
+    
+    void EndlessState::handleEvents(sf::RenderWindow& window) {
+        sf::Event event;
+        while (window.pollEvent(event)) {
+            if (event.type == sf::Event::Closed) {
+                window.close();
+            }
+            else if (event.type == sf::Event::KeyPressed) {
+                if (event.key.code == sf::Keyboard::Escape) {
+                    // This state may be gone: nothing may run after the change
+                    stateManager_.changeState<MainMenuState>(0, window_, stateManager_);
+                    return;
+                }
+                else if (event.key.code == sf::Keyboard::R) {
+                    startNewGame();
+                }
+            }
+            else if (event.type == sf::Event::MouseButtonPressed && !gameOver_ &&
+                     event.mouseButton.y >= Config::UI_HEIGHT) {
+                sf::Vector2i cell = screenToBoardPosition(event.mouseButton.x, event.mouseButton.y);
+                
+                if (event.mouseButton.button == sf::Mouse::Left) {
+                    gameOver_ = board_.revealCell(cell.x, cell.y);
+                } else if (event.mouseButton.button == sf::Mouse::Right) {
+                    board_.toggleFlag(cell.x, cell.y);
+                }
+            }
+        }
+    }
+    
+    void EndlessState::update(float deltaTime) {
+        previousCamera_ = camera_;
+        
+        // Camera movement (arrows / WASD)
+        sf::Vector2f direction;
+        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left) || sf::Keyboard::isKeyPressed(sf::Keyboard::A)) direction.x -= 1;
+        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Right) || sf::Keyboard::isKeyPressed(sf::Keyboard::D)) direction.x += 1;
+        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Up) || sf::Keyboard::isKeyPressed(sf::Keyboard::W)) direction.y -= 1;
+        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Down) || sf::Keyboard::isKeyPressed(sf::Keyboard::S)) direction.y += 1;
+        camera_ += direction * (CAMERA_SPEED * deltaTime);
+        
+        // Forget the chunks that were only looked at
+        evictTimer_ += deltaTime;
+        if (evictTimer_ >= EVICT_INTERVAL) {
+            evictTimer_ = 0.0f;
+            int centerX = static_cast<int>(std::floor(camera_.x)) + VIEW_WIDTH / (2 * Config::TILE_SIZE);
+            int centerY = static_cast<int>(std::floor(camera_.y)) + VIEW_HEIGHT / (2 * Config::TILE_SIZE);
+            board_.evictChunks(centerX, centerY, KEEP_RADIUS);
+        }
+    }
+    
+    void EndlessState::interpolate(float alpha) {
+        renderCamera_ = previousCamera_ + (camera_ - previousCamera_) * alpha;
+    }
+    
+    void EndlessState::render(sf::RenderTarget& target) {
+        target.clear(sf::Color(Config::BACKGROUND_COLOR));
+        
+        const float tile = static_cast<float>(Config::TILE_SIZE);
+        int firstX = static_cast<int>(std::floor(renderCamera_.x));
+        int firstY = static_cast<int>(std::floor(renderCamera_.y));
+        float offsetX = (renderCamera_.x - firstX) * tile;
+        float offsetY = (renderCamera_.y - firstY) * tile;
+        
+        sf::Sprite sprite;
+        for (int y = 0; y * tile - offsetY < VIEW_HEIGHT; ++y) {
+            for (int x = 0; x * tile - offsetX < VIEW_WIDTH; ++x) {
+                const Cell& cell = board_.getCell(firstX + x, firstY + y);
+                
+                // Reveal every mine once the game is lost
+                bool showMine = gameOver_ && cell.hasMine() && !cell.isFlagged();
+                sprite.setTexture(assetManager_->getTileTexture(
+                    !cell.isRevealed() && !showMine,
+                    cell.isFlagged(),
+                    cell.isRevealed() || showMine,
+                    cell.hasMine(),
+                    cell.getAdjacentMines()), true);
+                
+                sf::Vector2u texSize = sprite.getTexture()->getSize();
+                sprite.setScale(tile / texSize.x, tile / texSize.y);
+                sprite.setPosition(x * tile - offsetX, Config::UI_HEIGHT + y * tile - offsetY);
+                target.draw(sprite);
+            }
+        }
+        
+        renderUI(target);
+    }
+    
+    void EndlessState::renderUI(sf::RenderTarget& target) {
+        sf::RectangleShape uiBackground(sf::Vector2f(Config::WINDOW_WIDTH, Config::UI_HEIGHT));
+        uiBackground.setFillColor(sf::Color(Config::UI_BACKGROUND_COLOR));
+        target.draw(uiBackground);
+        
+        sf::Text title;
+        title.setFont(assetManager_->getFont());
+        title.setString("MODE INFINI");
+        title.setCharacterSize(28);
+        title.setStyle(sf::Text::Bold);
+        title.setFillColor(sf::Color::White);
+        title.setPosition(30, 20);
+        target.draw(title);
+        
+        sf::Text stats;
+        stats.setFont(assetManager_->getFont());
+        stats.setString("Cases revelees: " + std::to_string(board_.getRevealedCount()) +
+                        "\nDrapeaux: " + std::to_string(board_.getFlagCount()) +
+                        "\nPosition: " + std::to_string(static_cast<int>(std::floor(camera_.x))) +
+                        ", " + std::to_string(static_cast<int>(std::floor(camera_.y))));
+        stats.setCharacterSize(16);
+        stats.setFillColor(sf::Color(200, 200, 200));
+        stats.setPosition(30, 65);
+        target.draw(stats);
+        
+        sf::Text status;
+        status.setFont(assetManager_->getFont());
+        if (gameOver_) {
+            status.setString("PERDU ! R pour recommencer");
+            status.setFillColor(sf::Color::Red);
+        } else {
+            status.setString("Fleches/WASD : Deplacer | ECHAP : Menu");
+            status.setFillColor(sf::Color(150, 150, 180));
+        }
+        status.setCharacterSize(14);
+        status.setPosition(30, Config::UI_HEIGHT - 30);
+        target.draw(status);
+    }
+    
+    void EndlessState::onEnter() {
+        startNewGame();
+        std::cout << "Entering Endless State" << std::endl;
+    }
+    
+    void EndlessState::onExit() {
+        std::cout << "Exiting Endless State" << std::endl;
+    }
+}
@@ -5,19 +5,15 @@
 
 namespace Minesweeper {
     HelpState::HelpState(sf::RenderWindow& window, StateManager& stateManager)
-        : StateWithManager(window, stateManager) {
-        if (!font_.loadFromFile("assets/fonts/arial.ttf")) {
-            std::cerr << "Failed to load font in HelpState" << std::endl;
-            font_.loadFromFile("/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf");
-        }
-
+        : StateWithManager(window, stateManager),
+          font_(stateManager.getAssetManager()->getFont()) {
         createHelpText();
         initializeMenu();
     }
 
     void HelpState::createHelpText() {
         helpText_.setFont(font_);
-        helpText_.setString("But:\nTrouver toutes les mines \nUtilisez le clic gauche pour rEvEler une case, \nle clic droit pour marquer une mine.\n\nConseils:\n- Commencez par rEvEler les coins.\n- Utilisez les chiffres pour dEduire \noU se trouvent les mines.\n- Faites attention aux drapeaux.\n");
+        helpText_.setString("But:\nTrouver toutes les mines \nUtilisez le clic gauche pour rEvEler une case, \nle clic droit pour marquer une mine.\nClic du milieu (ou gauche + droit) sur un chiffre: \nrEvEle ses voisins si ses drapeaux sont posEs.\nCtrl+Z / Ctrl+Y: annuler / rEtablir un coup.\n\nConseils:\n- Commencez par rEvEler les coins.\n- Utilisez les chiffres pour dEduire \noU se trouvent les mines.\n- Faites attention aux drapeaux.\n");
         helpText_.setCharacterSize(18);
         helpText_.setFillColor(sf::Color(220,220,220));
     }
@@ -55,15 +51,15 @@ namespace Minesweeper {
         menu_->update();
     }
 
-    void HelpState::render(sf::RenderWindow& window) {
-        window.clear(sf::Color(Config::MENU_BACKGROUND_COLOR));
-        menu_->render();
+    void HelpState::render(sf::RenderTarget& target) {
+        target.clear(sf::Color(Config::MENU_BACKGROUND_COLOR));
+        menu_->render(target);
 
         // Draw help text below title
         sf::FloatRect tb = helpText_.getLocalBounds();
         helpText_.setOrigin(tb.left, tb.top);
         helpText_.setPosition(60, 220);
-        window.draw(helpText_);
+        target.draw(helpText_);
     }
 
     void HelpState::onEnter() {
@@ -0,0 +1,76 @@
+#include "States/LoadingState.hpp"
+#include "States/MainMenuState.hpp"
+#include "Game/Config.hpp"
+#include <iostream>
+
+namespace Minesweeper {
+    LoadingState::LoadingState(sf::RenderWindow& window, StateManager& stateManager)
+        : StateWithManager(window, stateManager),
+          assetManager_(stateManager.getAssetManager()),
+          loader_(assetManager_) {
+        
+        // Shapes only: nothing here may wait for an asset
+        sf::Vector2f barSize(Config::WINDOW_WIDTH - 120.0f, 16.0f);
+        sf::Vector2f barPosition(60.0f, Config::WINDOW_HEIGHT / 2.0f);
+        
+        barBackground_.setSize(barSize);
+        barBackground_.setPosition(barPosition);
+        barBackground_.setFillColor(sf::Color(50, 50, 70));
+        barBackground_.setOutlineThickness(2);
+        barBackground_.setOutlineColor(sf::Color(100, 100, 150));
+        
+        barFill_.setSize(sf::Vector2f(0.0f, barSize.y));
+        barFill_.setPosition(barPosition);
+        barFill_.setFillColor(sf::Color(255, 215, 0));
+    }
+    
+    void LoadingState::handleEvents(sf::RenderWindow& window) {
+        sf::Event event;
+        while (window.pollEvent(event)) {
+            if (event.type == sf::Event::Closed) {
+                window.close();
+            }
+        }
+    }
+    
+    void LoadingState::update(float /*deltaTime*/) {
+        loader_.uploadStep(sf::milliseconds(static_cast<int>(UPLOAD_BUDGET_MS)));
+        
+        sf::Vector2f barSize = barBackground_.getSize();
+        barFill_.setSize(sf::Vector2f(barSize.x * loader_.getProgress(), barSize.y));
+        
+        if (loader_.isFinished()) {
+            // This state is destroyed here: nothing may run after the change
+            stateManager_.changeState<MainMenuState>(0, window_, stateManager_);
+        }
+    }
+    
+    void LoadingState::render(sf::RenderTarget& target) {
+        target.clear(sf::Color(Config::MENU_BACKGROUND_COLOR));
+        target.draw(barBackground_);
+        target.draw(barFill_);
+        
+        // The font arrives first, use it as soon as it is there
+        if (assetManager_->hasFont()) {
+            sf::Text loadingText;
+            loadingText.setFont(assetManager_->getFont());
+            loadingText.setString("CHARGEMENT...");
+            loadingText.setCharacterSize(24);
+            loadingText.setFillColor(sf::Color::White);
+            
+            sf::FloatRect bounds = loadingText.getLocalBounds();
+            loadingText.setPosition((Config::WINDOW_WIDTH - bounds.width) / 2,
+                                    Config::WINDOW_HEIGHT / 2.0f - 50);
+            target.draw(loadingText);
+        }
+    }
+    
+    void LoadingState::onEnter() {
+        std::cout << "Loading assets..." << std::endl;
+        loader_.start();
+    }
+    
+    void LoadingState::onExit() {
+        std::cout << "Assets loaded" << std::endl;
+    }
+}
@@ -2,96 +2,30 @@
 #include "States/DifficultySelectState.hpp"
 #include "States/PlayingState.hpp"
 #include "States/HelpState.hpp"
+#include "States/ReplayState.hpp"
 #include "Game/Config.hpp"
+#include "Logic/GameLogic.hpp"
+#include "Logic/StatsStore.hpp"
 #include <iostream>
-#include <cstdlib>
-#include <ctime>
 #include <cmath>
+#include <cstdio>
 
 namespace Minesweeper {
     MainMenuState::MainMenuState(sf::RenderWindow& window, StateManager& stateManager) 
-        : StateWithManager(window, stateManager) {
+        : StateWithManager(window, stateManager),
+          font_(stateManager.getAssetManager()->getFont()) {
         
-        // Initialiser le générateur aléatoire
-        std::srand(static_cast<unsigned>(std::time(nullptr)));
-        
-        // Load font
-        if (!font_.loadFromFile("assets/fonts/arial.ttf")) {
-            std::cerr << "Failed to load font in MainMenuState" << std::endl;
-            // Créer une police par défaut si échec
-            font_.loadFromFile("/usr/share/fonts/truetype/liberation/LiberationSans-Regular.ttf");
-        }
+        // Normally already done by LoadingState
+        stateManager_.getAssetManager()->ensureLoaded();
         
         createBackground();
         initializeMenu();
+        loadStats();
     }
     
     void MainMenuState::createBackground() {
-        // Créer un fond avec dégradé
-        sf::Image gradient;
-        gradient.create(Config::WINDOW_WIDTH, Config::WINDOW_HEIGHT, sf::Color::Transparent);
-        
-        // Créer un dégradé bleu foncé -> violet
-        for (int y = 0; y < Config::WINDOW_HEIGHT; ++y) {
-            float t = static_cast<float>(y) / Config::WINDOW_HEIGHT;
-            sf::Color color(
-                static_cast<sf::Uint8>(30 + t * 40),   // R
-                static_cast<sf::Uint8>(30 + t * 30),   // G
-                static_cast<sf::Uint8>(46 + t * 60)    // B
-            );
-            
-            for (int x = 0; x < Config::WINDOW_WIDTH; ++x) {
-                gradient.setPixel(x, y, color);
-            }
-        }
-        
-        backgroundTexture_.loadFromImage(gradient);
-        backgroundSprite_.setTexture(backgroundTexture_);
-        
-        // Ajouter des motifs de mines en arrière-plan
-        sf::RenderTexture patternTexture;
-        patternTexture.create(Config::WINDOW_WIDTH, Config::WINDOW_HEIGHT);
-        patternTexture.clear(sf::Color::Transparent);
-        
-        // Dessiner des mines décoratives
-        for (int i = 0; i < 15; ++i) {
-            float x = static_cast<float>(std::rand() % Config::WINDOW_WIDTH);
-            float y = static_cast<float>(std::rand() % Config::WINDOW_HEIGHT);
-            float radius = 3.0f + static_cast<float>(std::rand() % 10);
-            
-            sf::CircleShape minePattern(radius);
-            minePattern.setPosition(x, y);
-            minePattern.setFillColor(sf::Color(255, 255, 255, 30));
-            patternTexture.draw(minePattern);
-            
-            // Ajouter des "rayons" pour certaines mines
-            if (i % 3 == 0) {
-                for (int j = 0; j < 8; ++j) {
-                    float angle = j * 45.0f * 3.14159f / 180.0f;
-                    float x2 = x + radius + cos(angle) * (radius * 2);
-                    float y2 = y + radius + sin(angle) * (radius * 2);
-                    
-                    sf::Vertex line[] = {
-                        sf::Vertex(sf::Vector2f(x + radius, y + radius), sf::Color(255, 255, 255, 20)),
-                        sf::Vertex(sf::Vector2f(x2, y2), sf::Color(255, 255, 255, 20))
-                    };
-                    patternTexture.draw(line, 2, sf::Lines);
-                }
-            }
-        }
-        
-        patternTexture.display();
-        sf::Sprite patternSprite(patternTexture.getTexture());
-        
-        // Combiner avec le fond
-        sf::RenderTexture finalTexture;
-        finalTexture.create(Config::WINDOW_WIDTH, Config::WINDOW_HEIGHT);
-        finalTexture.draw(backgroundSprite_);
-        finalTexture.draw(patternSprite);
-        finalTexture.display();
-        
-        backgroundTexture_ = finalTexture.getTexture();
-        backgroundSprite_.setTexture(backgroundTexture_);
+        // Dégradé et motifs de mines générés par ImageGenerator au chargement
+        backgroundSprite_.setTexture(stateManager_.getAssetManager()->getTexture("menu_background"), true);
     }
     
     void MainMenuState::initializeMenu() {
@@ -103,16 +37,22 @@ namespace Minesweeper {
         menu_->setSpacing(55);
         
         // Items du menu
+        Config::Difficulty savedDifficulty;
+        if (findSavedGame(savedDifficulty)) {
+            menu_->addItem("CONTINUER", [this, savedDifficulty]() {
+                resumeSavedGame(savedDifficulty);
+            });
+        }
+        
         menu_->addItem("NOUVELLE PARTIE", [this]() {
             // Aller à la sélection de difficulté
-            auto difficultyState = std::make_unique<DifficultySelectState>(window_, stateManager_);
-            stateManager_.pushState(std::move(difficultyState));
+            stateManager_.pushState<DifficultySelectState>(0, window_, stateManager_);
         });
         
         menu_->addItem("PARTIE RAPIDE", [this]() {
             // Démarrer directement une partie intermédiaire
-            auto playingState = std::make_unique<PlayingState>(window_, stateManager_);
-            stateManager_.changeState(std::move(playingState));
+            stateManager_.changeState<PlayingState>(static_cast<int>(Config::Difficulty::INTERMEDIATE),
+                                                    window_, stateManager_, Config::Difficulty::INTERMEDIATE);
         });
         
         menu_->addItem("OPTIONS", [this]() {
@@ -120,9 +60,15 @@ namespace Minesweeper {
             // À implémenter plus tard
         });
         
+        std::string replayPath = ReplayState::findLatestReplay();
+        if (!replayPath.empty()) {
+            menu_->addItem("REVOIR LA DERNIERE PARTIE", [this, replayPath]() {
+                stateManager_.pushState<ReplayState>(0, window_, stateManager_, replayPath);
+            });
+        }
+        
         menu_->addItem("COMMENT JOUER", [this]() {
-            auto help = std::make_unique<HelpState>(window_, stateManager_);
-            stateManager_.pushState(std::move(help));
+            stateManager_.pushState<HelpState>(0, window_, stateManager_);
         });
         
         menu_->addItem("QUITTER", [this]() {
@@ -130,6 +76,37 @@ namespace Minesweeper {
         });
     }
     
+    // The autosave only fits the PlayingState of its own difficulty
+    bool MainMenuState::findSavedGame(Config::Difficulty& difficulty) const {
+        SaveFileHeader header;
+        if (!GameLogic::readSaveHeader(Config::AUTOSAVE_PATH, header)) {
+            return false;
+        }
+        
+        for (Config::Difficulty candidate : {Config::Difficulty::BEGINNER,
+                                             Config::Difficulty::INTERMEDIATE,
+                                             Config::Difficulty::EXPERT}) {
+            auto settings = Config::getDifficultySettings(candidate);
+            if (header.width == static_cast<std::uint32_t>(settings.width) &&
+                header.height == static_cast<std::uint32_t>(settings.height) &&
+                header.mineCount == static_cast<std::uint32_t>(settings.mines)) {
+                difficulty = candidate;
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    void MainMenuState::resumeSavedGame(Config::Difficulty difficulty) {
+        stateManager_.changeState<PlayingState>(static_cast<int>(difficulty),
+                                                window_, stateManager_, difficulty);
+        
+        auto* playing = static_cast<PlayingState*>(stateManager_.getCurrentState());
+        if (!playing->resumeSavedGame()) {
+            std::cerr << "Sauvegarde illisible, nouvelle partie" << std::endl;
+        }
+    }
+    
     void MainMenuState::handleEvents(sf::RenderWindow& window) {
         sf::Event event;
         while (window.pollEvent(event)) {
@@ -160,10 +137,10 @@ namespace Minesweeper {
             static_cast<sf::Uint8>(200 + 55 * pulse)));
     }
     
-    void MainMenuState::render(sf::RenderWindow& window) {
-        window.clear(sf::Color(Config::MENU_BACKGROUND_COLOR));
-        window.draw(backgroundSprite_);
-        menu_->render();
+    void MainMenuState::render(sf::RenderTarget& target) {
+        target.clear(sf::Color(Config::MENU_BACKGROUND_COLOR));
+        target.draw(backgroundSprite_);
+        menu_->render(target);
         
         // Informations de version
         sf::Text versionText;
@@ -173,7 +150,7 @@ namespace Minesweeper {
         versionText.setFillColor(sf::Color(180, 180, 220, 180));
         versionText.setStyle(sf::Text::Italic);
         versionText.setPosition(10, Config::WINDOW_HEIGHT - 25);
-        window.draw(versionText);
+        target.draw(versionText);
         
         // Contrôles
         sf::Text controlsText;
@@ -185,7 +162,7 @@ namespace Minesweeper {
         sf::FloatRect bounds = controlsText.getLocalBounds();
         controlsText.setPosition((Config::WINDOW_WIDTH - bounds.width) / 2, 
                                 Config::WINDOW_HEIGHT - 45);
-        window.draw(controlsText);
+        target.draw(controlsText);
         
         // Crédits
         sf::Text creditsText;
@@ -198,18 +175,23 @@ namespace Minesweeper {
         sf::FloatRect creditsBounds = creditsText.getLocalBounds();
         creditsText.setPosition((Config::WINDOW_WIDTH - creditsBounds.width) / 2, 
                                Config::WINDOW_HEIGHT - 80);
-        window.draw(creditsText);
+        target.draw(creditsText);
         
         // Afficher les statistiques du dernier jeu (si disponibles)
         sf::Text statsText;
         statsText.setFont(font_);
-        statsText.setString("Derniere partie: 16x16 - 40 mines - Meilleur temps: --:--");
+        statsText.setString(statsLine_);
         statsText.setCharacterSize(12);
-        statsText.setPosition(Config::WINDOW_WIDTH - 320, 10);
-        window.draw(statsText);
+        statsText.setPosition(Config::WINDOW_WIDTH - statsText.getLocalBounds().width - 10, 10);
+        target.draw(statsText);
     }
     
     void MainMenuState::onEnter() {
+        // Pooled instance: the autosave may have appeared or gone since
+        initializeMenu();
+        loadStats();
+        menu_->selectItem(0);
+        
         std::cout << "=== ENTREE MENU PRINCIPAL ===" << std::endl;
         std::cout << "Sélectionnez une option avec les flèches ou WASD" << std::endl;
         std::cout << "Appuyez sur ENTREE pour valider" << std::endl;
@@ -219,4 +201,37 @@ namespace Minesweeper {
     void MainMenuState::onExit() {
         std::cout << "=== SORTIE MENU PRINCIPAL ===" << std::endl;
     }
+    
+    // Ligne des statistiques: dernière partie, puis record et victoires de
+    // sa difficulté, lus dans l'index (le journal n'est relu que s'il a grandi)
+    void MainMenuState::loadStats() {
+        StatsStore stats(Config::STATS_LOG_PATH, Config::STATS_INDEX_PATH);
+        StatsRecord last;
+        if (!stats.open() || !stats.getLastGame(last)) {
+            statsLine_ = "Aucune partie terminee";
+            return;
+        }
+        
+        Config::Difficulty difficulty = static_cast<Config::Difficulty>(last.difficulty);
+        Config::DifficultySettings settings = Config::getDifficultySettings(difficulty);
+        const StatsDifficulty& summary = stats.getDifficulty(difficulty);
+        
+        char best[16] = "--:--";
+        if (summary.bestCount > 0) {
+            std::uint32_t tenths = summary.best[0].timeMilliseconds / 100;
+            std::snprintf(best, sizeof(best), "%02u:%02u.%u",
+                          tenths / 600, tenths / 10 % 60, tenths % 10);
+        }
+        
+        char line[128];
+        std::snprintf(line, sizeof(line),
+                      "Derniere partie: %dx%d - %d mines - %s\nMeilleur temps: %s - Victoires: %llu/%llu (%d%%)",
+                      settings.width, settings.height, settings.mines,
+                      last.result == static_cast<std::uint8_t>(Config::GameState::WON) ? "gagnee" : "perdue",
+                      best,
+                      static_cast<unsigned long long>(summary.won),
+                      static_cast<unsigned long long>(summary.played),
+                      static_cast<int>(stats.getWinRate(difficulty) * 100.0 + 0.5));
+        statsLine_ = line;
+    }
 }
\ No newline at end of file
@@ -1,19 +1,17 @@
 #include "States/PauseState.hpp"
 #include "States/MainMenuState.hpp"
 #include "States/PlayingState.hpp"
+#include "States/DifficultySelectState.hpp"
 #include "States/StateManager.hpp"
 #include "Game/Config.hpp"
 #include <iostream>
 #include <cmath>
 
 namespace Minesweeper {
-    PauseState::PauseState(sf::RenderWindow& window, StateManager& stateManager) 
-        : StateWithManager(window, stateManager) {  // CORRECTION ICI
-        
-        if (!font_.loadFromFile("assets/fonts/arial.ttf")) {
-            std::cerr << "Failed to load font in PauseState" << std::endl;
-            font_.loadFromFile("/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf");
-        }
+    PauseState::PauseState(sf::RenderWindow& window, StateManager& stateManager,
+                           Config::Difficulty difficulty, bool noGuess) 
+        : StateWithManager(window, stateManager), difficulty_(difficulty), noGuess_(noGuess),
+          font_(stateManager.getAssetManager()->getFont()) {
         
         overlay_.setSize(sf::Vector2f(Config::WINDOW_WIDTH, Config::WINDOW_HEIGHT));
         overlay_.setFillColor(sf::Color(0, 0, 0, 180));
@@ -41,9 +39,7 @@ namespace Minesweeper {
         });
         
         menu_->addItem("RECOMMENCER", [this]() {
-            // Créer une nouvelle partie avec les mêmes paramètres
-            auto playingState = std::make_unique<PlayingState>(window_, stateManager_);
-            stateManager_.changeState(std::move(playingState));
+            restartGame();
         });
         
         menu_->addItem("OPTIONS", [this]() {
@@ -52,20 +48,29 @@ namespace Minesweeper {
         });
         
         menu_->addItem("CHANGER DE DIFFICULTE", [this]() {
-            std::cout << "Changement de difficulté depuis la pause" << std::endl;
-            // À implémenter - retourner au menu de sélection
+            stateManager_.changeState<MainMenuState>(0, window_, stateManager_);
+            stateManager_.pushState<DifficultySelectState>(0, window_, stateManager_);
         });
         
         menu_->addItem("MENU PRINCIPAL", [this]() {
-            auto mainMenu = std::make_unique<MainMenuState>(window_, stateManager_);
-            stateManager_.changeState(std::move(mainMenu));
+            stateManager_.changeState<MainMenuState>(0, window_, stateManager_);
         });
         
-        menu_->addItem("QUITTER LE JEU", [this]() {
+        menu_->addItem("SAUVEGARDER ET QUITTER", [this]() {
             window_.close();
         });
     }
     
+    int PauseState::getPoolVariant() const {
+        return PlayingState::poolVariant(difficulty_, noGuess_);
+    }
+    
+    void PauseState::restartGame() {
+        // Same difficulty and mode, so the pooled PlayingState is reset and reused
+        stateManager_.changeState<PlayingState>(getPoolVariant(),
+                                                window_, stateManager_, difficulty_, noGuess_);
+    }
+    
     void PauseState::handleEvents(sf::RenderWindow& window) {
         sf::Event event;
         while (window.pollEvent(event)) {
@@ -74,13 +79,16 @@ namespace Minesweeper {
             }
             else if (event.type == sf::Event::KeyPressed) {
                 // Handle only pause-specific global keys here.
+                // This state leaves the stack: nothing may run after it (an
+                // Enter queued behind Escape would pop the PlayingState too)
                 if (event.key.code == sf::Keyboard::Escape || event.key.code == sf::Keyboard::P) {
                     // Resume the game
                     stateManager_.popState();
+                    return;
                 } else if (event.key.code == sf::Keyboard::R) {
                     // Shortcut to restart
-                    auto playingState = std::make_unique<PlayingState>(window_, stateManager_);
-                    stateManager_.changeState(std::move(playingState));
+                    restartGame();
+                    return;
                 }
                 // Do not handle Enter/Up/Down here — delegate to Menu::handleEvent to avoid double handling
             }
@@ -103,8 +111,8 @@ namespace Minesweeper {
         overlay_.setFillColor(sf::Color(0, 0, 0, alpha));
     }
     
-    void PauseState::render(sf::RenderWindow& window) {
-        window.draw(overlay_);
+    void PauseState::render(sf::RenderTarget& target) {
+        target.draw(overlay_);
         
         // Cadre pour le menu
         sf::RectangleShape menuBackground(sf::Vector2f(500, 400));
@@ -113,10 +121,10 @@ namespace Minesweeper {
         menuBackground.setOutlineColor(sf::Color(70, 70, 100));
         menuBackground.setPosition((Config::WINDOW_WIDTH - 500) / 2, 
                                   (Config::WINDOW_HEIGHT - 400) / 3);
-        window.draw(menuBackground);
+        target.draw(menuBackground);
                 
         // Rendre le menu
-        menu_->render();
+        menu_->render(target);
         
         // Informations de contrôle
         sf::Text controlsText;
@@ -129,7 +137,7 @@ namespace Minesweeper {
         sf::FloatRect ctrlBounds = controlsText.getLocalBounds();
         controlsText.setPosition((Config::WINDOW_WIDTH - ctrlBounds.width) / 2, 
                                 Config::WINDOW_HEIGHT - 80);
-        window.draw(controlsText);
+        target.draw(controlsText);
         
         // Message d'aide
         sf::Text helpText;
@@ -141,21 +149,23 @@ namespace Minesweeper {
         sf::FloatRect helpBounds = helpText.getLocalBounds();
         helpText.setPosition((Config::WINDOW_WIDTH - helpBounds.width) / 2, 
                             Config::WINDOW_HEIGHT - 50);
-        window.draw(helpText);
+        target.draw(helpText);
         
         // Effet de bordure décorative
         sf::RectangleShape topBorder(sf::Vector2f(Config::WINDOW_WIDTH, 2));
         topBorder.setFillColor(sf::Color(100, 100, 150, 100));
         topBorder.setPosition(0, (Config::WINDOW_HEIGHT - 400) / 3 - 10);
-        window.draw(topBorder);
+        target.draw(topBorder);
         
         sf::RectangleShape bottomBorder(sf::Vector2f(Config::WINDOW_WIDTH, 2));
         bottomBorder.setFillColor(sf::Color(100, 100, 150, 100));
         bottomBorder.setPosition(0, (Config::WINDOW_HEIGHT - 400) / 3 + 410);
-        window.draw(bottomBorder);
+        target.draw(bottomBorder);
     }
     
     void PauseState::onEnter() {
+        menu_->selectItem(0);
+        
         std::cout << "=== ENTREE MENU PAUSE ===" << std::endl;
         std::cout << "Jeu mis en pause" << std::endl;
         std::cout << "Options disponibles:" << std::endl;
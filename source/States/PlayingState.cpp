@@ -1,47 +1,62 @@
 #include "States/PlayingState.hpp"
 #include "States/PauseState.hpp"
+#include "Logic/StatsStore.hpp"
+#include <cstdio>
+#include <filesystem>
 #include <iostream>
 
 namespace Minesweeper {
-    PlayingState::PlayingState(sf::RenderWindow& window, StateManager& stateManager) 
-        : StateWithManager(window, stateManager) {  // CORRECTION ICI
+    PlayingState::PlayingState(sf::RenderWindow& window, StateManager& stateManager,
+                               Config::Difficulty difficulty, bool noGuess) 
+        : StateWithManager(window, stateManager), difficulty_(difficulty), noGuess_(noGuess) {
         initialize();
     }
     
     void PlayingState::initialize() {
         // Create shared instances
-        gameLogic_ = std::make_shared<GameLogic>();
-        assetManager_ = std::make_shared<AssetManager>();
+        gameLogic_ = std::make_shared<GameLogic>(Config::getDifficultySettings(difficulty_));
+        gameLogic_->setNoGuess(noGuess_);
+        // Boards of this difficulty and mode made ahead of time
+        Config::DifficultySettings settings = Config::getDifficultySettings(difficulty_);
+        auto pool = stateManager_.getBoardPool();
+        if (pool->addSettings(settings.width, settings.height, settings.mines, noGuess_)) {
+            gameLogic_->setBoardPool(pool);
+        }
         
-        // Load assets
-        assetManager_->loadAssets();
+        // Assets are shared and preloaded by LoadingState
+        assetManager_ = stateManager_.getAssetManager();
+        assetManager_->ensureLoaded();
         
         // Create renderer and input handler
         renderer_ = std::make_shared<Renderer>(gameLogic_, assetManager_);
         inputHandler_ = std::make_shared<InputHandler>(gameLogic_, renderer_);
         uiManager_ = std::make_shared<UIManager>(gameLogic_, assetManager_);
-        
-        // Start new game
-        gameLogic_->startNewGame();
     }
     
     void PlayingState::handleEvents(sf::RenderWindow& window) {
         sf::Event event;
         while (window.pollEvent(event)) {
             if (event.type == sf::Event::Closed) {
+                autosave();
                 window.close();
             }
             else if (event.type == sf::Event::KeyPressed) {
                 // Pause game
                 if (event.key.code == sf::Keyboard::Escape ||
                     event.key.code == sf::Keyboard::P) {
-                    auto pauseState = std::make_unique<PauseState>(window, stateManager_);
-                    stateManager_.pushState(std::move(pauseState));
+                    stateManager_.pushState<PauseState>(getPoolVariant(), window, stateManager_, difficulty_, noGuess_);
                 }
                 // Restart game
                 else if (event.key.code == sf::Keyboard::R) {
                     gameLogic_->startNewGame();
                 }
+                // Undo / redo
+                else if (event.key.control && event.key.code == sf::Keyboard::Z) {
+                    gameLogic_->undo();
+                }
+                else if (event.key.control && event.key.code == sf::Keyboard::Y) {
+                    gameLogic_->redo();
+                }
             }
             
             // Pass events to input handler for game controls
@@ -50,19 +65,113 @@ namespace Minesweeper {
     }
     
     void PlayingState::update(float deltaTime) {
-        gameLogic_->update(deltaTime);
+        renderer_->update(deltaTime);
         uiManager_->update(deltaTime);
+        
+        // Chaque partie terminée est gardée (à nouveau si un undo l'a relancée)
+        // et comptée une fois dans les statistiques
+        Config::GameState state = gameLogic_->getGameState();
+        if (state == Config::GameState::PLAYING && !gameLogic_->isInProgress()) {
+            statsRecorded_ = false; // new game, restarted from anywhere
+        }
+        if (state != lastGameState_ && state != Config::GameState::PLAYING) {
+            saveReplay();
+            if (!statsRecorded_) {
+                recordStats(state);
+            }
+        }
+        lastGameState_ = state;
+    }
+    
+    void PlayingState::interpolate(float alpha) {
+        renderer_->interpolate(alpha);
     }
     
-    void PlayingState::render(sf::RenderWindow& window) {
-        renderer_->render(window);
+    void PlayingState::render(sf::RenderTarget& target) {
+        renderer_->render(target);
     }
     
     void PlayingState::onEnter() {
         std::cout << "Entering Playing State" << std::endl;
+        
+        // Pooled instance: start over instead of rebuilding everything
+        gameLogic_->startNewGame();
+        inputHandler_->reset();
+        lastGameState_ = Config::GameState::PLAYING;
+        statsRecorded_ = false;
     }
     
     void PlayingState::onExit() {
         std::cout << "Exiting Playing State" << std::endl;
+        
+        autosave();
+    }
+    
+    void PlayingState::onPause() {
+        std::cout << "Playing State paused" << std::endl;
+        
+        // Time spent in the pause menu doesn't count
+        gameLogic_->pauseTimer();
+        autosave();
+    }
+    
+    void PlayingState::onResume() {
+        std::cout << "Playing State resumed" << std::endl;
+        
+        gameLogic_->resumeTimer();
+    }
+    
+    bool PlayingState::resumeSavedGame() {
+        if (!gameLogic_->loadGame(Config::AUTOSAVE_PATH)) {
+            return false;
+        }
+        
+        inputHandler_->reset();
+        lastGameState_ = gameLogic_->getGameState();
+        statsRecorded_ = lastGameState_ != Config::GameState::PLAYING;
+        return true;
+    }
+    
+    // Only a game that can still be continued is kept: a finished or not
+    // yet started one removes the previous save
+    void PlayingState::autosave() {
+        if (gameLogic_->isInProgress()) {
+            gameLogic_->saveGame(Config::AUTOSAVE_PATH);
+        }
+        else {
+            std::remove(Config::AUTOSAVE_PATH);
+        }
+    }
+    
+    // replays/<seed>.msreplay: the seed names the game
+    void PlayingState::saveReplay() {
+        if (!gameLogic_->hasReplay()) {
+            return;
+        }
+        
+        std::error_code error;
+        std::filesystem::create_directories(Config::REPLAY_DIRECTORY, error);
+        if (error) {
+            std::cerr << "Impossible de créer " << Config::REPLAY_DIRECTORY << ": " << error.message() << std::endl;
+            return;
+        }
+        
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx",
+                      static_cast<unsigned long long>(gameLogic_->getReplay().getSeed()));
+        std::string path = std::string(Config::REPLAY_DIRECTORY) + "/" + name + ReplayFile::EXTENSION;
+        if (gameLogic_->saveReplay(path)) {
+            std::cout << "Replay: " << path << std::endl;
+        }
+    }
+    
+    void PlayingState::recordStats(Config::GameState result) {
+        statsRecorded_ = true;
+        
+        StatsStore stats(Config::STATS_LOG_PATH, Config::STATS_INDEX_PATH);
+        if (stats.open()) {
+            stats.append(difficulty_, result, gameLogic_->getElapsedMilliseconds(),
+                         gameLogic_->getBoard()->getMetrics().bbbv, gameLogic_->getClickCount());
+        }
     }
 }
\ No newline at end of file
@@ -0,0 +1,234 @@
+#include "States/ReplayState.hpp"
+#include "Logic/Replay.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+
+namespace Minesweeper {
+    namespace {
+        // 83.4 s -> "01:23.4"
+        std::string formatTime(std::int64_t milliseconds) {
+            char text[32];
+            long long tenths = static_cast<long long>(milliseconds / 100);
+            std::snprintf(text, sizeof(text), "%02lld:%02lld.%lld",
+                          tenths / 600, (tenths / 10) % 60, tenths % 10);
+            return text;
+        }
+    }
+    
+    ReplayState::ReplayState(sf::RenderWindow& window, StateManager& stateManager, const std::string& path)
+        : StateWithManager(window, stateManager),
+          font_(stateManager.getAssetManager()->getFont()) {
+        
+        barBounds_ = sf::FloatRect(20.0f, Config::UI_HEIGHT - 22.0f, Config::WINDOW_WIDTH - 40.0f, 10.0f);
+        
+        Replay replay;
+        if (!replay.load(path)) {
+            error_ = "Replay illisible";
+            return;
+        }
+        
+        Config::DifficultySettings settings{replay.getWidth(), replay.getHeight(), replay.getMineCount(), 0};
+        gameLogic_ = std::make_shared<GameLogic>(settings);
+        gameLogic_->setRecordingReplay(false);
+        if (!timeline_.build(replay, *gameLogic_, error_)) {
+            std::cerr << path << ": " << error_ << std::endl;
+            error_ = "Replay invalide: " + error_;
+            return;
+        }
+        
+        renderer_ = std::make_shared<Renderer>(gameLogic_, stateManager_.getAssetManager());
+        std::cout << "Replay " << path << ": " << timeline_.getEventCount() << " coups, "
+                  << timeline_.getKeyframeCount() << " keyframes" << std::endl;
+    }
+    
+    std::string ReplayState::findLatestReplay() {
+        std::error_code error;
+        std::filesystem::directory_iterator it(Config::REPLAY_DIRECTORY, error);
+        if (error) {
+            return std::string();
+        }
+        
+        std::filesystem::path latest;
+        std::filesystem::file_time_type latestTime;
+        for (const auto& entry : it) {
+            if (entry.path().extension() != ReplayFile::EXTENSION || !entry.is_regular_file(error)) {
+                continue;
+            }
+            auto time = entry.last_write_time(error);
+            if (!error && (latest.empty() || time > latestTime)) {
+                latest = entry.path();
+                latestTime = time;
+            }
+        }
+        return latest.string();
+    }
+    
+    void ReplayState::handleEvents(sf::RenderWindow& window) {
+        sf::Event event;
+        while (window.pollEvent(event)) {
+            if (event.type == sf::Event::Closed) {
+                window.close();
+            }
+            else if (event.type == sf::Event::KeyPressed) {
+                switch (event.key.code) {
+                    case sf::Keyboard::Escape:
+                    case sf::Keyboard::BackSpace:
+                        stateManager_.popState();
+                        return;
+                    case sf::Keyboard::Space:
+                    case sf::Keyboard::P:
+                        // Play again from the start once at the end
+                        if (!playing_ && time_ >= timeline_.getDuration()) {
+                            seekTo(0.0);
+                        }
+                        playing_ = !playing_;
+                        break;
+                    case sf::Keyboard::Left:
+                        seekTo(time_ - SEEK_STEP_MS);
+                        break;
+                    case sf::Keyboard::Right:
+                        seekTo(time_ + SEEK_STEP_MS);
+                        break;
+                    case sf::Keyboard::Up:
+                        speed_ = std::min(MAX_SPEED, speed_ * 2.0f);
+                        break;
+                    case sf::Keyboard::Down:
+                        speed_ = std::max(MIN_SPEED, speed_ / 2.0f);
+                        break;
+                    case sf::Keyboard::Home:
+                        seekTo(0.0);
+                        break;
+                    case sf::Keyboard::End:
+                        seekTo(static_cast<double>(timeline_.getDuration()));
+                        break;
+                    default:
+                        break;
+                }
+            }
+            else if (event.type == sf::Event::MouseButtonPressed &&
+                     event.mouseButton.button == sf::Mouse::Left) {
+                // A little slack around the thin bar
+                sf::FloatRect grab(barBounds_.left, barBounds_.top - 8.0f,
+                                   barBounds_.width, barBounds_.height + 16.0f);
+                if (grab.contains(static_cast<float>(event.mouseButton.x), static_cast<float>(event.mouseButton.y))) {
+                    scrubbing_ = true;
+                    seekToMouse(event.mouseButton.x);
+                }
+            }
+            else if (event.type == sf::Event::MouseMoved && scrubbing_) {
+                seekToMouse(event.mouseMove.x);
+            }
+            else if (event.type == sf::Event::MouseButtonReleased &&
+                     event.mouseButton.button == sf::Mouse::Left) {
+                scrubbing_ = false;
+            }
+        }
+    }
+    
+    void ReplayState::update(float deltaTime) {
+        if (!renderer_) {
+            return;
+        }
+        
+        if (playing_ && !scrubbing_) {
+            double end = static_cast<double>(timeline_.getDuration());
+            time_ = std::min(end, time_ + deltaTime * 1000.0 * speed_);
+            timeline_.seekTime(static_cast<std::int64_t>(time_));
+            if (time_ >= end) {
+                playing_ = false;
+            }
+        }
+        renderer_->update(deltaTime);
+    }
+    
+    void ReplayState::seekTo(double time) {
+        time_ = std::max(0.0, std::min(time, static_cast<double>(timeline_.getDuration())));
+        timeline_.seekTime(static_cast<std::int64_t>(time_));
+    }
+    
+    void ReplayState::seekToMouse(int mouseX) {
+        float fraction = (static_cast<float>(mouseX) - barBounds_.left) / barBounds_.width;
+        fraction = std::max(0.0f, std::min(1.0f, fraction));
+        seekTo(fraction * static_cast<double>(timeline_.getDuration()));
+    }
+    
+    void ReplayState::render(sf::RenderTarget& target) {
+        target.clear(sf::Color(Config::BACKGROUND_COLOR));
+        
+        if (!renderer_) {
+            sf::Text errorText;
+            errorText.setFont(font_);
+            errorText.setString(error_ + "\nECHAP : Retour");
+            errorText.setCharacterSize(18);
+            errorText.setFillColor(sf::Color(255, 120, 120));
+            errorText.setPosition(30, Config::WINDOW_HEIGHT / 2.0f - 30);
+            target.draw(errorText);
+            return;
+        }
+        
+        renderer_->render(target);
+        renderTimeline(target);
+    }
+    
+    // Covers the instructions line at the bottom of the UI panel
+    void ReplayState::renderTimeline(sf::RenderTarget& target) {
+        sf::RectangleShape panel(sf::Vector2f(Config::WINDOW_WIDTH, 52.0f));
+        panel.setPosition(0.0f, Config::UI_HEIGHT - 52.0f);
+        panel.setFillColor(sf::Color(Config::UI_BACKGROUND_COLOR));
+        target.draw(panel);
+        
+        double duration = static_cast<double>(timeline_.getDuration());
+        float fraction = duration > 0.0 ? static_cast<float>(time_ / duration) : 1.0f;
+        
+        sf::RectangleShape bar(sf::Vector2f(barBounds_.width, barBounds_.height));
+        bar.setPosition(barBounds_.left, barBounds_.top);
+        bar.setFillColor(sf::Color(70, 70, 95));
+        target.draw(bar);
+        
+        sf::RectangleShape progress(sf::Vector2f(barBounds_.width * fraction, barBounds_.height));
+        progress.setPosition(barBounds_.left, barBounds_.top);
+        progress.setFillColor(sf::Color(255, 215, 0));
+        target.draw(progress);
+        
+        sf::CircleShape handle(8.0f);
+        handle.setOrigin(8.0f, 8.0f);
+        handle.setPosition(barBounds_.left + barBounds_.width * fraction, barBounds_.top + barBounds_.height / 2.0f);
+        handle.setFillColor(sf::Color::White);
+        target.draw(handle);
+        
+        char status[160];
+        std::snprintf(status, sizeof(status), "%s  x%g   %s / %s   Coup %zu/%zu",
+                      playing_ ? "LECTURE" : "PAUSE", speed_,
+                      formatTime(static_cast<std::int64_t>(time_)).c_str(),
+                      formatTime(timeline_.getDuration()).c_str(),
+                      timeline_.getPosition(), timeline_.getEventCount());
+        
+        sf::Text statusText;
+        statusText.setFont(font_);
+        statusText.setString(status);
+        statusText.setCharacterSize(14);
+        statusText.setFillColor(sf::Color(220, 220, 220));
+        statusText.setPosition(barBounds_.left, Config::UI_HEIGHT - 48.0f);
+        target.draw(statusText);
+        
+        sf::Text controlsText;
+        controlsText.setFont(font_);
+        controlsText.setString("ESPACE  <- ->  HAUT/BAS");
+        controlsText.setCharacterSize(12);
+        controlsText.setFillColor(sf::Color(200, 200, 200, 150));
+        sf::FloatRect bounds = controlsText.getLocalBounds();
+        controlsText.setPosition(barBounds_.left + barBounds_.width - bounds.width - bounds.left,
+                                 Config::UI_HEIGHT - 46.0f);
+        target.draw(controlsText);
+    }
+    
+    void ReplayState::onEnter() {
+        std::cout << "Entering Replay State" << std::endl;
+    }
+    
+    void ReplayState::onExit() {
+        std::cout << "Exiting Replay State" << std::endl;
+    }
+}
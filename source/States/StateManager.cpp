@@ -1,58 +1,121 @@
 #include "../../include/States/StateManager.hpp"
+#include "../../include/Game/Config.hpp"
 
 namespace Minesweeper {
     void StateManager::pushState(std::unique_ptr<GameState> state) {
         if (!states_.empty()) {
-            states_.top()->onExit();
+            states_.back()->onPause();
         }
         
-        states_.push(std::move(state));
-        states_.top()->onEnter();
+        states_.push_back(std::move(state));
+        snapshotValid_ = false;
+        states_.back()->onEnter();
     }
 
     void StateManager::popState() {
-        if (!states_.empty()) {
-            states_.top()->onExit();
-            states_.pop();
-        }
+        releaseTop();
+        snapshotValid_ = false;
         
         if (!states_.empty()) {
-            states_.top()->onEnter();
+            states_.back()->onResume();
         }
     }
 
     void StateManager::changeState(std::unique_ptr<GameState> state) {
+        clearStates();
+        pushState(std::move(state));
+    }
+
+    void StateManager::clearStates() {
         while (!states_.empty()) {
-            states_.top()->onExit();
-            states_.pop();
+            releaseTop();
+        }
+        snapshotValid_ = false;
+    }
+
+    void StateManager::releaseTop() {
+        if (states_.empty()) {
+            return;
         }
         
-        states_.push(std::move(state));
-        states_.top()->onEnter();
+        std::unique_ptr<GameState> state = std::move(states_.back());
+        states_.pop_back();
+        state->onExit();
+        
+        // Park poolable states instead of destroying them. This also keeps a
+        // state alive when it pops itself from inside one of its callbacks.
+        if (state->isPoolable()) {
+            GameState& released = *state;
+            PoolKey key(std::type_index(typeid(released)), released.getPoolVariant());
+            if (pool_.find(key) == pool_.end()) {
+                pool_.emplace(key, std::move(state));
+            }
+        }
     }
 
     GameState* StateManager::getCurrentState() {
         if (states_.empty()) {
             return nullptr;
         }
-        return states_.top().get();
+        return states_.back().get();
     }
 
     void StateManager::handleEvents(sf::RenderWindow& window) {
         if (!states_.empty()) {
-            states_.top()->handleEvents(window);
+            states_.back()->handleEvents(window);
         }
     }
 
     void StateManager::update(float deltaTime) {
         if (!states_.empty()) {
-            states_.top()->update(deltaTime);
+            states_.back()->update(deltaTime);
         }
     }
 
-    void StateManager::render(sf::RenderWindow& window) {
-        if (!states_.empty()) {
-            states_.top()->render(window);
+    void StateManager::render(sf::RenderWindow& window, float alpha) {
+        if (states_.empty()) {
+            return;
+        }
+        
+        GameState* top = states_.back().get();
+        top->interpolate(alpha);
+        if (!top->isOverlay() || states_.size() < 2) {
+            top->render(window);
+            return;
+        }
+        
+        // States below the overlay are frozen (only the top state is
+        // updated), so their picture is captured once and reused
+        if (!snapshotValid_) {
+            captureSnapshot(window.getSize());
+        }
+        
+        window.draw(snapshotSprite_);
+        top->render(window);
+    }
+
+    void StateManager::captureSnapshot(const sf::Vector2u& size) {
+        if (snapshot_.getSize() != size) {
+            snapshot_.create(size.x, size.y);
+        }
+        
+        snapshot_.clear(sf::Color(Config::BACKGROUND_COLOR));
+        renderLayers(snapshot_, states_.size() - 2);
+        snapshot_.display();
+        
+        snapshotSprite_.setTexture(snapshot_.getTexture(), true);
+        snapshotValid_ = true;
+    }
+
+    void StateManager::renderLayers(sf::RenderTarget& target, size_t top) {
+        // Walk down to the first opaque state, then draw upwards
+        size_t base = top;
+        while (base > 0 && states_[base]->isOverlay()) {
+            --base;
+        }
+        
+        for (size_t i = base; i <= top; ++i) {
+            states_[i]->render(target);
         }
     }
 }
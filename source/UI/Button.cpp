@@ -127,9 +127,9 @@ namespace Minesweeper {
         updateColors();
     }
 
-    void Button::draw(sf::RenderWindow& window) const {
-        window.draw(shape_);
-        window.draw(text_);
+    void Button::draw(sf::RenderTarget& target) const {
+        target.draw(shape_);
+        target.draw(text_);
     }
 
     void Button::updateColors() {
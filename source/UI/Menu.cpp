@@ -5,15 +5,11 @@
 namespace Minesweeper {
 
     Menu::Menu(sf::RenderWindow& window) : window_(window) {
-        // Default font (will be set later)
-        if (!font_.loadFromFile("assets/fonts/arial.ttf")) {
-            std::cerr << "Failed to load menu font" << std::endl;
-        }
+        // The font is shared and set by the owning state through setFont()
         // default sizes
         titleSize_ = 48;
         itemSize_ = 32;
 
-        title_.setFont(font_);
         title_.setCharacterSize(titleSize_);
         title_.setFillColor(sf::Color::Yellow);
         title_.setStyle(sf::Text::Bold);
@@ -37,8 +33,8 @@ namespace Minesweeper {
     }
     
     void Menu::setFont(const sf::Font& font) {
-        font_ = font;
-        title_.setFont(font_);
+        font_ = &font;
+        title_.setFont(*font_);
         updateItemsDisplay();
     }
 
@@ -57,7 +53,7 @@ namespace Minesweeper {
         MenuItem item;
         // Create a Button for this item
         item.button = std::make_unique<Button>();
-        item.button->setFont(font_);
+        if (font_) item.button->setFont(*font_);
         item.button->setText(text);
         item.button->setOnClick(action);
         item.button->setEnabled(enabled);
@@ -122,14 +118,18 @@ namespace Minesweeper {
     }
     
     void Menu::render() {
+        render(window_);
+    }
+
+    void Menu::render(sf::RenderTarget& target) {
         // Draw title
         title_.setPosition(x_, y_);
-        window_.draw(title_);
+        target.draw(title_);
         
         // Draw menu items
         for (size_t i = 0; i < items_.size(); ++i) {
             if (items_[i].button) {
-                items_[i].button->draw(window_);
+                items_[i].button->draw(target);
             }
         }
     }
@@ -186,7 +186,7 @@ namespace Minesweeper {
                 float by = y_ + 60 + i * spacing_;
                 items_[i].button->setPosition(sf::Vector2f(bx, by));
                 items_[i].button->setSize(sf::Vector2f(buttonWidth, buttonHeight));
-                items_[i].button->setFont(font_);
+                if (font_) items_[i].button->setFont(*font_);
                 items_[i].button->setTextSize(itemSize_);
                 items_[i].button->setSelected(static_cast<int>(i) == selectedIndex_);
             }
@@ -21,7 +21,9 @@ namespace Minesweeper {
 
     void UIManager::render(sf::RenderWindow& window) {
         window.draw(uiPanel_);
-        renderGameInfo(window);
+        if (!gameLogic_ || !assetManager_) return;
+        
+        renderGameInfo(window, gameLogic_->getBoardView());
         renderFaceButton(window);
     }
 
@@ -29,14 +31,9 @@ namespace Minesweeper {
         newGameButton_.handleEvent(event, window);
     }
 
-    void UIManager::renderGameInfo(sf::RenderWindow& window) {
-        if (!gameLogic_ || !assetManager_) return;
-        
-        auto board = gameLogic_->getBoard();
-        if (!board) return;
-        
+    void UIManager::renderGameInfo(sf::RenderWindow& window, const BoardView& board) {
         // Render mine counter
-        int minesLeft = board->getMineCount() - board->getFlagCount();
+        int minesLeft = board.getMineCount() - board.getFlagCount();
         std::string mineText = std::to_string(minesLeft);
         
         // Render timer
@@ -63,8 +60,6 @@ namespace Minesweeper {
     }
 
     void UIManager::renderFaceButton(sf::RenderWindow& window) {
-        if (!gameLogic_ || !assetManager_) return;
-        
         Config::GameState state = gameLogic_->getGameState();
         const sf::Texture& faceTexture = assetManager_->getFaceTexture(state);
         
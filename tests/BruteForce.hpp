@@ -0,0 +1,149 @@
+#pragma once
+#include "Logic/Board.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace Minesweeper {
+    namespace Test {
+        // Every mine layout of the covered cells that fits the revealed
+        // numbers and the mine count, counted: the frontier (covered cells
+        // next to a number) by backtracking, the other covered cells by
+        // binomials. Flags are not trusted. Exponential in the frontier, so
+        // only for the tests' small boards; the reference the solvers are
+        // checked against.
+        struct Enumeration {
+            std::vector<double> mineWeight; // row-major: layouts with a mine on the cell
+            double totalWeight = 0.0;       // layouts, 0 when none fits
+
+            bool isSafe(size_t cell) const { return totalWeight > 0.0 && mineWeight[cell] == 0.0; }
+            bool isMine(size_t cell) const { return totalWeight > 0.0 && mineWeight[cell] == totalWeight; }
+            double probability(size_t cell) const { return mineWeight[cell] / totalWeight; }
+        };
+
+        class LayoutCounter {
+        public:
+            explicit LayoutCounter(const Board& board)
+                : width_(board.getWidth()), height_(board.getHeight()), mineCount_(board.getMineCount()) {
+                size_t cells = static_cast<size_t>(width_) * height_;
+                std::vector<int> frontierOf(cells, -1);
+                for (int y = 0; y < height_; ++y) {
+                    for (int x = 0; x < width_; ++x) {
+                        const Cell& cell = board.getCell(x, y);
+                        if (!cell.isRevealed() || cell.hasMine()) {
+                            continue;
+                        }
+                        Constraint constraint{cell.getAdjacentMines(), 0, 0};
+                        for (int dy = -1; dy <= 1; ++dy) {
+                            for (int dx = -1; dx <= 1; ++dx) {
+                                int nx = x + dx, ny = y + dy;
+                                if ((dx == 0 && dy == 0) || nx < 0 || ny < 0 || nx >= width_ || ny >= height_ ||
+                                    board.getCell(nx, ny).isRevealed()) {
+                                    continue;
+                                }
+                                size_t index = static_cast<size_t>(ny) * width_ + nx;
+                                if (frontierOf[index] < 0) {
+                                    frontierOf[index] = static_cast<int>(frontier_.size());
+                                    frontier_.push_back(index);
+                                    constraintsOf_.emplace_back();
+                                }
+                                constraint.cells++;
+                                constraintsOf_[frontierOf[index]].push_back(constraints_.size());
+                            }
+                        }
+                        if (constraint.cells > 0) {
+                            constraints_.push_back(constraint);
+                        }
+                    }
+                }
+                for (size_t index = 0; index < cells; ++index) {
+                    int x = static_cast<int>(index % width_), y = static_cast<int>(index / width_);
+                    if (!board.getCell(x, y).isRevealed() && frontierOf[index] < 0) {
+                        interior_.push_back(index);
+                    }
+                }
+                mines_.assign(frontier_.size(), 0);
+            }
+
+            Enumeration count() {
+                result_ = Enumeration();
+                result_.mineWeight.assign(static_cast<size_t>(width_) * height_, 0.0);
+                interiorWeight_ = 0.0;
+                search(0, 0);
+                for (size_t index : interior_) {
+                    result_.mineWeight[index] = interiorWeight_;
+                }
+                return result_;
+            }
+
+        private:
+            struct Constraint {
+                int needed;   // mines still to place around the number
+                int cells;    // covered neighbours
+                int assigned; // of which already decided
+            };
+
+            int width_, height_, mineCount_;
+            std::vector<size_t> frontier_;
+            std::vector<std::vector<size_t>> constraintsOf_; // per frontier cell
+            std::vector<Constraint> constraints_;
+            std::vector<size_t> interior_;
+            std::vector<char> mines_;
+            Enumeration result_;
+            double interiorWeight_ = 0.0; // layouts with a mine on a given interior cell
+
+            static double choose(size_t n, size_t k) {
+                double value = 1.0;
+                for (size_t i = 1; i <= k; ++i) {
+                    value = value * static_cast<double>(n - k + i) / static_cast<double>(i);
+                }
+                return value;
+            }
+
+            void search(size_t position, int mines) {
+                if (mines > mineCount_) {
+                    return;
+                }
+                if (position == frontier_.size()) {
+                    size_t rest = static_cast<size_t>(mineCount_ - mines);
+                    if (rest > interior_.size()) {
+                        return;
+                    }
+                    double weight = choose(interior_.size(), rest);
+                    result_.totalWeight += weight;
+                    for (size_t i = 0; i < frontier_.size(); ++i) {
+                        if (mines_[i]) {
+                            result_.mineWeight[frontier_[i]] += weight;
+                        }
+                    }
+                    if (!interior_.empty()) {
+                        interiorWeight_ += weight * static_cast<double>(rest) / static_cast<double>(interior_.size());
+                    }
+                    return;
+                }
+
+                for (int mine = 0; mine <= 1; ++mine) {
+                    bool fits = true;
+                    for (size_t c : constraintsOf_[position]) {
+                        Constraint& constraint = constraints_[c];
+                        constraint.needed -= mine;
+                        constraint.assigned++;
+                        fits = fits && constraint.needed >= 0 &&
+                               constraint.needed <= constraint.cells - constraint.assigned;
+                    }
+                    if (fits) {
+                        mines_[position] = static_cast<char>(mine);
+                        search(position + 1, mines + mine);
+                    }
+                    for (size_t c : constraintsOf_[position]) {
+                        constraints_[c].needed += mine;
+                        constraints_[c].assigned--;
+                    }
+                }
+            }
+        };
+
+        inline Enumeration enumerateLayouts(const Board& board) {
+            return LayoutCounter(board).count();
+        }
+    }
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <cstdio>
+
+// Checks for the logic tests, no framework: a test program counts the
+// checks that failed and returns TEST_RESULT() from main (ctest runs one
+// program per file)
+namespace Minesweeper {
+    namespace Test {
+        inline int& failureCount() {
+            static int count = 0;
+            return count;
+        }
+
+        inline bool check(bool condition, const char* expression, const char* file, int line) {
+            if (!condition) {
+                std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+                failureCount()++;
+            }
+            return condition;
+        }
+    }
+}
+
+#define CHECK(condition) ::Minesweeper::Test::check((condition), #condition, __FILE__, __LINE__)
+#define TEST_RESULT() (::Minesweeper::Test::failureCount() == 0 ? 0 : 1)
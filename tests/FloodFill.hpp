@@ -0,0 +1,51 @@
+#pragma once
+#include "Logic/Board.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace Minesweeper {
+    namespace Test {
+        // Row-major revealed cells of the board
+        inline std::vector<bool> revealedCells(const Board& board) {
+            std::vector<bool> revealed(static_cast<size_t>(board.getWidth()) * board.getHeight());
+            for (int y = 0; y < board.getHeight(); ++y) {
+                for (int x = 0; x < board.getWidth(); ++x) {
+                    revealed[static_cast<size_t>(y) * board.getWidth() + x] = board.getCell(x, y).isRevealed();
+                }
+            }
+            return revealed;
+        }
+
+        // What a left click on the hidden, unflagged, safe cell (x, y)
+        // should leave revealed: the plain sequential flood fill, through
+        // zero cells, stopping at flags. The reference the cascades
+        // (level-parallel BFS, openings) are checked against.
+        inline std::vector<bool> floodFill(const Board& board, int x, int y) {
+            int width = board.getWidth(), height = board.getHeight();
+            std::vector<bool> revealed = revealedCells(board);
+            std::vector<size_t> stack{static_cast<size_t>(y) * width + x};
+            revealed[stack.back()] = true;
+            while (!stack.empty()) {
+                size_t cell = stack.back();
+                stack.pop_back();
+                int cx = static_cast<int>(cell % width), cy = static_cast<int>(cell / width);
+                if (board.getCell(cx, cy).getAdjacentMines() != 0) {
+                    continue;
+                }
+                for (int ny = cy - 1; ny <= cy + 1; ++ny) {
+                    for (int nx = cx - 1; nx <= cx + 1; ++nx) {
+                        if (nx < 0 || ny < 0 || nx >= width || ny >= height) {
+                            continue;
+                        }
+                        size_t neighbor = static_cast<size_t>(ny) * width + nx;
+                        if (!revealed[neighbor] && !board.getCell(nx, ny).isFlagged()) {
+                            revealed[neighbor] = true;
+                            stack.push_back(neighbor);
+                        }
+                    }
+                }
+            }
+            return revealed;
+        }
+    }
+}
@@ -0,0 +1,133 @@
+// Reveal cascades against the plain flood fill (FloodFill.hpp), on boards
+// large enough for the level-parallel BFS, and the Parallel worker pool
+// they run on.
+
+#include "Check.hpp"
+#include "FloodFill.hpp"
+#include "Logic/Parallel.hpp"
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using namespace Minesweeper;
+using namespace Minesweeper::Test;
+
+namespace {
+    // The cascade revealed what the flood fill does, counted once each, and
+    // its trace lists exactly the newly revealed cells
+    bool revealsLikeFloodFill(Board& board, int x, int y) {
+        std::vector<bool> before = revealedCells(board);
+        std::vector<bool> expected = floodFill(board, x, y);
+        int revealedBefore = board.getRevealedCount();
+        if (board.revealCell(x, y)) {
+            return false;
+        }
+
+        std::vector<bool> after = revealedCells(board);
+        size_t newCells = 0;
+        for (size_t i = 0; i < after.size(); ++i) {
+            newCells += after[i] && !before[i];
+        }
+        std::vector<bool> traced(after.size(), false);
+        bool traceOk = board.getLastReveal().cells.size() == newCells;
+        for (size_t index : board.getLastReveal().cells) {
+            int cx, cy;
+            board.cellPosition(index, cx, cy);
+            size_t cell = static_cast<size_t>(cy) * board.getWidth() + cx;
+            traceOk = traceOk && !before[cell] && !traced[cell];
+            traced[cell] = true;
+        }
+        return after == expected && traceOk &&
+               board.getRevealedCount() == revealedBefore + static_cast<int>(newCells);
+    }
+
+    // A flag inside the opening keeps the precomputed openings out of it, so
+    // the click runs the BFS, with levels of thousands of cells
+    void testLargeCascade(bool levels, CellLayout layout) {
+        const int width = 1500, height = 1200, firstX = 750, firstY = 600;
+        Board board(width, height, width * height / 100, layout);
+        board.setRevealLevels(levels);
+        board.reset(7);
+        board.initialize(firstX, firstY);
+
+        std::vector<bool> opening = floodFill(board, firstX, firstY);
+        int flagX = -1, flagY = -1;
+        for (int y = height - 1; y >= 0 && flagX < 0; --y) {
+            for (int x = width - 1; x >= 0 && flagX < 0; --x) {
+                if (opening[static_cast<size_t>(y) * width + x] && board.getCell(x, y).getAdjacentMines() == 0) {
+                    flagX = x;
+                    flagY = y;
+                }
+            }
+        }
+        if (!CHECK(flagX >= 0)) {
+            return;
+        }
+        board.toggleFlag(flagX, flagY);
+
+        CHECK(revealsLikeFloodFill(board, firstX, firstY));
+        CHECK(board.getLastReveal().cells.size() > 100000);
+        if (levels) {
+            CHECK(board.getLastReveal().getLevelCount() > 100);
+        }
+
+        // A second cascade from the other side of the flag
+        board.toggleFlag(flagX, flagY);
+        CHECK(revealsLikeFloodFill(board, flagX, flagY));
+    }
+
+    // Every index once, on the asked number of workers, the worker ids in
+    // range; nested and concurrent calls run inline and still cover all
+    void testParallel() {
+        for (unsigned workers : {1u, 2u, 4u, 7u}) {
+            const size_t count = 20000;
+            std::vector<std::atomic<int>> runs(count);
+            std::atomic<bool> workerInRange{true};
+            Parallel::forEachOnWorkers(count, [&](unsigned worker, size_t i) {
+                runs[i]++;
+                if (worker >= workers) {
+                    workerInRange = false;
+                }
+            }, workers);
+            bool once = true;
+            for (const auto& run : runs) {
+                once = once && run.load() == 1;
+            }
+            CHECK(once);
+            CHECK(workerInRange.load());
+        }
+
+        std::atomic<size_t> nested{0};
+        Parallel::forEachOnWorkers(64, [&](unsigned, size_t) {
+            Parallel::forEachOnWorkers(100, [&](unsigned, size_t) { nested++; }, 4);
+        }, 4);
+        CHECK(nested.load() == 6400);
+
+        std::atomic<size_t> concurrent{0};
+        std::vector<std::thread> callers;
+        for (int caller = 0; caller < 4; ++caller) {
+            callers.emplace_back([&concurrent]() {
+                for (int call = 0; call < 200; ++call) {
+                    Parallel::forEachOnWorkers(50, [&concurrent](unsigned, size_t) { concurrent++; }, 3);
+                }
+            });
+        }
+        for (std::thread& caller : callers) {
+            caller.join();
+        }
+        CHECK(concurrent.load() == 4 * 200 * 50);
+
+        size_t calls = 0;
+        Parallel::forEachOnWorkers(0, [&calls](unsigned, size_t) { calls++; }, 4);
+        CHECK(calls == 0);
+    }
+}
+
+int main() {
+    testLargeCascade(false, CellLayout::RowMajor);
+    testLargeCascade(true, CellLayout::RowMajor);
+    testLargeCascade(true, CellLayout::Tiled);
+    testParallel();
+    return TEST_RESULT();
+}
@@ -0,0 +1,194 @@
+// Endless board (ChunkedBoard): a cascade across chunk borders reveals what
+// a finite Board with the same mines does, and evicted chunks come back
+// with the same mines and counts.
+
+#include "Check.hpp"
+#include "Logic/Board.hpp"
+#include "Logic/ChunkedBoard.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace Minesweeper;
+
+namespace {
+    // The finite board covers SIZE x SIZE cells of the endless one, the
+    // endless origin at its center
+    constexpr int SIZE = 10 * ChunkedBoard::CHUNK_SIZE;
+    constexpr int OFFSET = SIZE / 2;
+
+    int floorChunk(int v) {
+        return v >= 0 ? v / ChunkedBoard::CHUNK_SIZE : -((-v - 1) / ChunkedBoard::CHUNK_SIZE) - 1;
+    }
+
+    // Every zero cell at a chunk corner is clicked on both boards, so the
+    // cascades straddle chunk borders. The finite board misses the mines
+    // outside its window: seeds whose cascades reach its border are skipped.
+    void testCascadeMatchesBoard() {
+        const int chunk = ChunkedBoard::CHUNK_SIZE;
+        int compared = 0;
+        int cascades = 0;
+        int wide = 0; // cascades over three chunks or more
+        size_t widest = 0;
+        for (std::uint64_t seed = 1; seed <= 12; ++seed) {
+            ChunkedBoard endless(seed, ChunkedBoard::MIN_MINE_DENSITY);
+
+            std::vector<std::uint64_t> mines((static_cast<size_t>(SIZE) * SIZE + 63) / 64, 0);
+            int mineCount = 0;
+            for (int y = 0; y < SIZE; ++y) {
+                for (int x = 0; x < SIZE; ++x) {
+                    if (endless.isMine(x - OFFSET, y - OFFSET)) {
+                        size_t i = static_cast<size_t>(y) * SIZE + x;
+                        mines[i >> 6] |= std::uint64_t(1) << (i & 63);
+                        mineCount++;
+                    }
+                }
+            }
+
+            // Origin and click on the same cell: the mines are placed as given
+            Board board(SIZE, SIZE, mineCount);
+            board.reset(seed);
+            board.setOrigin(OFFSET, OFFSET);
+            board.initialize(OFFSET, OFFSET, mines.data());
+
+            int seedCascades = 0, seedWide = 0;
+            for (int y = chunk; y < SIZE - chunk; ++y) {
+                for (int x = chunk; x < SIZE - chunk; ++x) {
+                    int lx = (x - OFFSET) & (chunk - 1), ly = (y - OFFSET) & (chunk - 1);
+                    bool corner = (lx == 0 || lx == chunk - 1) && (ly == 0 || ly == chunk - 1);
+                    const Cell& cell = endless.getCell(x - OFFSET, y - OFFSET);
+                    if (!corner || cell.hasMine() || cell.isRevealed() || cell.getAdjacentMines() != 0) {
+                        continue;
+                    }
+                    CHECK(!endless.revealCell(x - OFFSET, y - OFFSET));
+                    CHECK(!board.revealCell(x, y));
+
+                    std::set<std::pair<int, int>> chunks;
+                    for (size_t index : board.getLastReveal().cells) {
+                        int cx, cy;
+                        board.cellPosition(index, cx, cy);
+                        chunks.emplace(floorChunk(cx - OFFSET), floorChunk(cy - OFFSET));
+                    }
+                    seedCascades++;
+                    seedWide += chunks.size() >= 3;
+                    widest = std::max(widest, chunks.size());
+                }
+            }
+
+            bool inside = true;
+            for (int i = 0; i < SIZE; ++i) {
+                inside = inside && !endless.getCell(i - OFFSET, -OFFSET).isRevealed() &&
+                         !endless.getCell(i - OFFSET, SIZE - 1 - OFFSET).isRevealed() &&
+                         !endless.getCell(-OFFSET, i - OFFSET).isRevealed() &&
+                         !endless.getCell(SIZE - 1 - OFFSET, i - OFFSET).isRevealed();
+            }
+            if (!inside) {
+                continue;
+            }
+
+            bool same = board.getRevealedCount() == endless.getRevealedCount();
+            for (int y = 1; y < SIZE - 1 && same; ++y) {
+                for (int x = 1; x < SIZE - 1 && same; ++x) {
+                    const Cell& cell = board.getCell(x, y);
+                    const Cell& endlessCell = endless.getCell(x - OFFSET, y - OFFSET);
+                    same = cell.hasMine() == endlessCell.hasMine() &&
+                           cell.isRevealed() == endlessCell.isRevealed() &&
+                           (cell.hasMine() || cell.getAdjacentMines() == endlessCell.getAdjacentMines());
+                }
+            }
+            if (!CHECK(same)) {
+                std::fprintf(stderr, "  seed %llu\n", static_cast<unsigned long long>(seed));
+            }
+            compared++;
+            cascades += seedCascades;
+            wide += seedWide;
+        }
+        CHECK(compared >= 8);
+        CHECK(wide >= 100);
+        CHECK(widest >= 5);
+        std::printf("cascades: %d boards compared, %d cascades, %d over three chunks or more, up to %zu\n",
+                    compared, cascades, wide, widest);
+    }
+
+    std::vector<Cell> chunkCells(ChunkedBoard& endless, int chunkX, int chunkY) {
+        std::vector<Cell> cells;
+        for (int ly = 0; ly < ChunkedBoard::CHUNK_SIZE; ++ly) {
+            for (int lx = 0; lx < ChunkedBoard::CHUNK_SIZE; ++lx) {
+                cells.push_back(endless.getCell(chunkX * ChunkedBoard::CHUNK_SIZE + lx,
+                                                chunkY * ChunkedBoard::CHUNK_SIZE + ly));
+            }
+        }
+        return cells;
+    }
+
+    bool sameMines(const std::vector<Cell>& a, const std::vector<Cell>& b) {
+        if (a.size() != b.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (a[i].hasMine() != b[i].hasMine() ||
+                (!a[i].hasMine() && a[i].getAdjacentMines() != b[i].getAdjacentMines())) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Far chunks without player state are dropped, then rebuilt identically
+    // (counts included, against the stateless queries); chunks with
+    // revealed or flagged cells stay, state and all
+    void testEviction() {
+        ChunkedBoard endless(7, 0.2f);
+        CHECK(!endless.revealCell(0, 0));
+        int revealed = endless.getRevealedCount();
+
+        const int far[][2] = {{30, -12}, {-45, 3}, {-8, -70}, {100, 100}};
+        std::vector<std::vector<Cell>> before;
+        for (const auto& chunk : far) {
+            before.push_back(chunkCells(endless, chunk[0], chunk[1]));
+        }
+        // A flag far away keeps its chunk
+        int flagX = 20 * ChunkedBoard::CHUNK_SIZE + 5, flagY = -20 * ChunkedBoard::CHUNK_SIZE + 9;
+        endless.toggleFlag(flagX, flagY);
+
+        size_t chunksBefore = endless.getChunkCount();
+        endless.evictChunks(0, 0, 2);
+        CHECK(endless.getChunkCount() < chunksBefore);
+        CHECK(endless.getChunkCount() <= chunksBefore - 4);
+        CHECK(endless.getRevealedCount() == revealed);
+        CHECK(endless.getFlagCount() == 1);
+        CHECK(endless.getCell(flagX, flagY).isFlagged());
+        CHECK(endless.getCell(0, 0).isRevealed());
+
+        for (size_t i = 0; i < before.size(); ++i) {
+            std::vector<Cell> after = chunkCells(endless, far[i][0], far[i][1]);
+            CHECK(sameMines(before[i], after));
+            bool stateless = true;
+            for (int ly = 0; ly < ChunkedBoard::CHUNK_SIZE; ++ly) {
+                for (int lx = 0; lx < ChunkedBoard::CHUNK_SIZE; ++lx) {
+                    int x = far[i][0] * ChunkedBoard::CHUNK_SIZE + lx;
+                    int y = far[i][1] * ChunkedBoard::CHUNK_SIZE + ly;
+                    const Cell& cell = after[static_cast<size_t>(ly) * ChunkedBoard::CHUNK_SIZE + lx];
+                    stateless = stateless && cell.hasMine() == endless.isMine(x, y) && !cell.isRevealed() &&
+                                (cell.hasMine() || cell.getAdjacentMines() == endless.countAdjacentMines(x, y));
+                }
+            }
+            CHECK(stateless);
+        }
+
+        // Evicting everything but the chunks with player state
+        endless.evictChunks(0, 0, 0);
+        CHECK(endless.getCell(flagX, flagY).isFlagged());
+        CHECK(endless.getRevealedCount() == revealed);
+        std::printf("eviction: %zu chunks before, regenerated chunks identical\n", chunksBefore);
+    }
+}
+
+int main() {
+    testCascadeMatchesBoard();
+    testEviction();
+    return TEST_RESULT();
+}
@@ -0,0 +1,120 @@
+// EliminationSolver: what it proves beyond the Solver checked against the
+// enumeration of all mine layouts (BruteForce.hpp), alone and fed back to
+// the Solver until neither finds more.
+
+#include "BruteForce.hpp"
+#include "Check.hpp"
+#include "Logic/EliminationSolver.hpp"
+#include "Logic/Random.hpp"
+#include "Logic/Solver.hpp"
+#include <cstdio>
+#include <vector>
+
+using namespace Minesweeper;
+using namespace Minesweeper::Test;
+
+namespace {
+    struct Case {
+        int width, height, mines;
+    };
+    const Case CASES[] = {{8, 8, 10}, {9, 9, 10}, {10, 6, 12}, {7, 7, 12}, {16, 5, 16}};
+
+    void testRandomStates() {
+        Random::Generator random(48);
+        EliminationSolver elimination;
+        int states = 0, extra = 0, unsound = 0, moreAfterFeedback = 0, missedSafe = 0, brutelySafe = 0;
+        for (const Case& c : CASES) {
+            for (std::uint64_t seed = 1; seed <= 25; ++seed) {
+                Board board(c.width, c.height, c.mines);
+                board.reset(seed);
+                int firstX = static_cast<int>(seed * 3 % c.width), firstY = static_cast<int>(seed % c.height);
+                board.initialize(firstX, firstY);
+                board.revealCell(firstX, firstY);
+
+                int safeCount = c.width * c.height - c.mines;
+                while (board.getRevealedCount() < safeCount) {
+                    Enumeration layouts = enumerateLayouts(board);
+                    Solver solver;
+                    solver.attach(board);
+                    CHECK(solver.solve());
+
+                    // One pass on top of the Solver's rules
+                    std::vector<std::uint32_t> safe, mines;
+                    CHECK(elimination.deduce(solver, safe, mines));
+                    for (std::uint32_t cell : safe) {
+                        unsound += !layouts.isSafe(cell);
+                    }
+                    for (std::uint32_t cell : mines) {
+                        unsound += !layouts.isMine(cell);
+                    }
+                    extra += static_cast<int>(safe.size() + mines.size());
+
+                    // Both engines to a fixed point: still sound, and only
+                    // ever more
+                    size_t before = solver.getSafeCells().size() + solver.getMineCells().size();
+                    CHECK(elimination.solve(solver));
+                    const std::vector<std::uint32_t>& allSafe = solver.getSafeCells();
+                    for (std::uint32_t cell : allSafe) {
+                        unsound += !layouts.isSafe(cell);
+                    }
+                    for (std::uint32_t cell : solver.getMineCells()) {
+                        unsound += !layouts.isMine(cell);
+                    }
+                    moreAfterFeedback += allSafe.size() + solver.getMineCells().size() > before;
+
+                    // How much of the provable the engines reach (reported)
+                    for (int y = 0; y < c.height; ++y) {
+                        for (int x = 0; x < c.width; ++x) {
+                            size_t cell = static_cast<size_t>(y) * c.width + x;
+                            if (!board.getCell(x, y).isRevealed() && layouts.isSafe(cell)) {
+                                brutelySafe++;
+                                missedSafe += !solver.isKnownSafe(x, y);
+                            }
+                        }
+                    }
+                    states++;
+
+                    std::vector<std::pair<int, int>> hiddenSafe;
+                    for (int y = 0; y < c.height; ++y) {
+                        for (int x = 0; x < c.width; ++x) {
+                            if (!board.getCell(x, y).isRevealed() && !board.getCell(x, y).hasMine()) {
+                                hiddenSafe.push_back({x, y});
+                            }
+                        }
+                    }
+                    auto next = hiddenSafe[static_cast<size_t>(random.uniform() * hiddenSafe.size())];
+                    board.revealCell(next.first, next.second);
+                }
+            }
+        }
+        std::printf("%d states, %d cells proven beyond the Solver, %d of %d provably safe cells missed\n",
+                    states, extra, missedSafe, brutelySafe);
+        CHECK(unsound == 0);
+        CHECK(extra > 0 && moreAfterFeedback > 0);
+    }
+
+    // Contradictory trusted flags are reported, not turned into deductions
+    void testContradiction() {
+        Board board(9, 9, 10);
+        board.reset(11);
+        board.initialize(4, 4);
+        board.revealCell(4, 4);
+        for (int y = 0; y < 9; ++y) {
+            for (int x = 0; x < 9; ++x) {
+                if (!board.getCell(x, y).isRevealed()) {
+                    board.toggleFlag(x, y); // far more flags than mines
+                }
+            }
+        }
+        Solver solver(true);
+        solver.attach(board);
+        EliminationSolver elimination;
+        CHECK(!elimination.solve(solver));
+    }
+}
+
+int main() {
+    testRandomStates();
+    testContradiction();
+    return TEST_RESULT();
+}
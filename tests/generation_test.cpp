@@ -0,0 +1,220 @@
+// Mine placement (Board::placeMines): the mine count, the free zone around
+// the first click and the adjacent counts, on boards under and over the
+// size generated in parallel bands; the same mines for a seed whatever the
+// cell layout, and pinned boards for a few seeds; mines spread evenly over
+// bands and cells, and the band split's hypergeometric draws.
+
+#include "Check.hpp"
+#include "Logic/Board.hpp"
+#include "Logic/Random.hpp"
+#include "Logic/Replay.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace Minesweeper;
+
+namespace {
+    // Row-major mine bits, whatever the layout
+    std::vector<bool> minesOf(const Board& board) {
+        std::vector<bool> mines(static_cast<size_t>(board.getWidth()) * board.getHeight());
+        for (int y = 0; y < board.getHeight(); ++y) {
+            for (int x = 0; x < board.getWidth(); ++x) {
+                mines[static_cast<size_t>(y) * board.getWidth() + x] = board.getCell(x, y).hasMine();
+            }
+        }
+        return mines;
+    }
+
+    // Mine count, free zone and the count of every other cell recounted
+    bool isWellFormed(const Board& board, int firstX, int firstY) {
+        int mines = 0;
+        bool counts = true;
+        for (int y = 0; y < board.getHeight(); ++y) {
+            for (int x = 0; x < board.getWidth(); ++x) {
+                const Cell& cell = board.getCell(x, y);
+                if (cell.hasMine()) {
+                    mines++;
+                    if (std::abs(x - firstX) <= 1 && std::abs(y - firstY) <= 1) {
+                        return false;
+                    }
+                    continue; // mines have no count
+                }
+                int around = 0;
+                for (int ny = std::max(0, y - 1); ny <= std::min(board.getHeight() - 1, y + 1); ++ny) {
+                    for (int nx = std::max(0, x - 1); nx <= std::min(board.getWidth() - 1, x + 1); ++nx) {
+                        around += (nx != x || ny != y) && board.getCell(nx, ny).hasMine();
+                    }
+                }
+                counts = counts && cell.getAdjacentMines() == around;
+            }
+        }
+        return counts && mines == board.getMineCount();
+    }
+
+    // Small boards, boards of several bands, and boards large enough for
+    // the parallel bands (first clicks on band edges and corners)
+    void testPlacement() {
+        struct Case {
+            int width, height, mines, firstX, firstY;
+        };
+        const Case cases[] = {{9, 9, 10, 4, 4},       {30, 16, 99, 0, 0},         {3, 3, 0, 1, 1},
+                              {4, 4, 7, 3, 3},        {50, 200, 1500, 25, 63},    {50, 200, 1500, 49, 64},
+                              {600, 600, 72000, 0, 127}, {1000, 333, 50000, 999, 332}};
+        for (const Case& c : cases) {
+            for (std::uint64_t seed = 1; seed <= 3; ++seed) {
+                Board board(c.width, c.height, c.mines);
+                board.reset(seed);
+                board.initialize(c.firstX, c.firstY);
+                if (!CHECK(isWellFormed(board, c.firstX, c.firstY))) {
+                    std::fprintf(stderr, "  %dx%d, %d mines, seed %llu\n", c.width, c.height, c.mines,
+                                 static_cast<unsigned long long>(seed));
+                }
+            }
+        }
+    }
+
+    // The seed alone sets the mines: same board on a new Board, after a
+    // reset, and in the tiled layout
+    void testDeterminism() {
+        const int sizes[][3] = {{30, 16, 99}, {700, 500, 60000}};
+        for (const auto& size : sizes) {
+            int firstX = 5, firstY = std::min(70, size[1] - 1); // on a band edge when there are bands
+            Board first(size[0], size[1], size[2]);
+            first.reset(42);
+            first.initialize(firstX, firstY);
+            std::vector<bool> mines = minesOf(first);
+
+            Board again(size[0], size[1], size[2]);
+            again.reset(42);
+            again.initialize(firstX, firstY);
+            CHECK(minesOf(again) == mines);
+
+            first.reset(42);
+            first.initialize(firstX, firstY);
+            CHECK(minesOf(first) == mines);
+
+            Board tiled(size[0], size[1], size[2], CellLayout::Tiled);
+            tiled.reset(42);
+            tiled.initialize(firstX, firstY);
+            CHECK(minesOf(tiled) == mines);
+
+            Board other(size[0], size[1], size[2]);
+            other.reset(43);
+            other.initialize(firstX, firstY);
+            CHECK(minesOf(other) != mines);
+        }
+    }
+
+    // Every cell outside the free zone equally likely, on a board of three
+    // bands (the split between bands is drawn first): each cell's and each
+    // band's mine frequency within 5 standard deviations of uniform
+    void testUniformity() {
+        const int width = 4, height = 150, mineCount = 60, draws = 4000;
+        const int firstX = 0, firstY = 64; // free zone across two bands
+        std::vector<int> hits(static_cast<size_t>(width) * height, 0);
+        Board board(width, height, mineCount);
+        for (int draw = 0; draw < draws; ++draw) {
+            board.reset(static_cast<std::uint64_t>(draw) * 2654435761u + 1);
+            board.initialize(firstX, firstY);
+            std::vector<bool> mines = minesOf(board);
+            for (size_t i = 0; i < mines.size(); ++i) {
+                hits[i] += mines[i];
+            }
+        }
+
+        const int free = 2 * 3;
+        const double p = static_cast<double>(mineCount) / (width * height - free);
+        const double sigma = std::sqrt(draws * p * (1 - p));
+        double bandExpected[3] = {}, bandHits[3] = {};
+        int outliers = 0;
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                int cell = hits[static_cast<size_t>(y) * width + x];
+                if (std::abs(x - firstX) <= 1 && std::abs(y - firstY) <= 1) {
+                    CHECK(cell == 0);
+                    continue;
+                }
+                outliers += std::fabs(cell - draws * p) > 5 * sigma;
+                bandExpected[y / 64] += draws * p;
+                bandHits[y / 64] += cell;
+            }
+        }
+        CHECK(outliers == 0);
+        for (int band = 0; band < 3; ++band) {
+            // Cells of a band are negatively correlated: this bound is loose
+            CHECK(std::fabs(bandHits[band] - bandExpected[band]) <= 5 * std::sqrt(bandExpected[band]));
+        }
+    }
+
+    // Boards pinned to their hash (Replay::hashBoard): the same on every
+    // platform and compiler, or replays recorded elsewhere fail to verify.
+    // The last two split their mines between bands (Random::hypergeometric).
+    void testPinnedBoards() {
+        struct Pinned {
+            int width, height, mines, firstX, firstY;
+            std::uint64_t seed, hash;
+        };
+        const Pinned boards[] = {{9, 9, 10, 4, 4, 1, 0x75383eb3283cdf1fULL},
+                                 {30, 16, 99, 0, 0, 2, 0x0d37787cd3a9ca35ULL},
+                                 {200, 300, 9000, 100, 150, 3, 0x0f13c5183ab716e5ULL},
+                                 {600, 600, 72000, 599, 0, 4, 0x3c2fe685cc876e25ULL}};
+        for (const Pinned& pinned : boards) {
+            Board board(pinned.width, pinned.height, pinned.mines);
+            board.reset(pinned.seed);
+            board.initialize(pinned.firstX, pinned.firstY);
+            CHECK(Replay::hashBoard(board) == pinned.hash);
+        }
+
+        Random::Generator generator(99);
+        const std::uint64_t draws[] = {12856, 12735, 12851, 12698, 12925, 12646, 12895, 12668};
+        for (std::uint64_t expected : draws) {
+            CHECK(Random::hypergeometric(generator, 1000000, 200000, 64000) == expected);
+        }
+    }
+
+    // Draw frequencies against the exact pmf, C(K, k) C(N - K, n - k) / C(N, n)
+    void testHypergeometric() {
+        struct Params {
+            std::uint64_t population, successes, draws;
+        };
+        const Params params[] = {{20, 7, 9}, {50, 45, 10}, {30, 3, 28}, {1000, 100, 64}};
+        const int samples = 50000;
+        Random::Generator generator(5);
+        for (const Params& p : params) {
+            auto choose = [](std::uint64_t n, std::uint64_t k) {
+                double value = 1.0;
+                for (std::uint64_t i = 1; i <= k; ++i) {
+                    value = value * static_cast<double>(n - k + i) / static_cast<double>(i);
+                }
+                return value;
+            };
+            std::vector<int> counts(p.draws + 1, 0);
+            for (int i = 0; i < samples; ++i) {
+                std::uint64_t k = Random::hypergeometric(generator, p.population, p.successes, p.draws);
+                CHECK(k <= p.draws && k <= p.successes && p.draws - k <= p.population - p.successes);
+                counts[std::min<std::uint64_t>(k, p.draws)]++;
+            }
+            for (std::uint64_t k = 0; k <= p.draws; ++k) {
+                if (k > p.successes || p.draws - k > p.population - p.successes) {
+                    continue;
+                }
+                double pmf = choose(p.successes, k) * choose(p.population - p.successes, p.draws - k) /
+                             choose(p.population, p.draws);
+                double sigma = std::sqrt(samples * pmf * (1 - pmf));
+                CHECK(std::fabs(counts[k] - samples * pmf) <= 5 * sigma + 1);
+            }
+        }
+    }
+}
+
+int main() {
+    testPlacement();
+    testDeterminism();
+    testUniformity();
+    testPinnedBoards();
+    testHypergeometric();
+    return TEST_RESULT();
+}
@@ -0,0 +1,320 @@
+// Move history: MoveJournal's ring against a plain list of moves, dropping
+// the oldest ones when full, and GameLogic's undo, redo and rewindTo on
+// real games, down to the board planes and the clock.
+
+#include "Check.hpp"
+#include "Logic/GameLogic.hpp"
+#include "Logic/MoveJournal.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace Minesweeper;
+
+namespace {
+    const Config::DifficultySettings EXPERT = Config::getDifficultySettings(Config::Difficulty::EXPERT);
+
+    std::vector<size_t> cellsOf(const MoveJournal& journal, const MoveJournal::Move& move) {
+        std::vector<size_t> cells;
+        journal.forEachCell(move, [&cells](std::uint32_t index) { cells.push_back(index); });
+        return cells;
+    }
+
+    // Random moves on a small ring, mirrored by a list that drops its
+    // oldest moves by the same rule: every move still held reads back
+    // intact (across the wrap of the ring) and undo stops at the oldest
+    void testRingOverflow() {
+        const size_t capacity = 64;
+        MoveJournal journal(capacity);
+        std::deque<std::vector<size_t>> model;
+        size_t dropped = 0;
+        std::mt19937 rng(3);
+        size_t next = 0;
+
+        for (int step = 0; step < 2000; ++step) {
+            // Sometimes step back first, so the next move forgets the redo ones
+            size_t back = rng() % 4 == 0 ? rng() % 3 : 0;
+            for (size_t i = 0; i < back && journal.canUndo(); ++i) {
+                journal.undo();
+            }
+            while (model.size() > journal.getMoveNumber() - dropped) {
+                model.pop_back();
+            }
+
+            std::vector<size_t> cells(1 + rng() % 20);
+            for (size_t& cell : cells) {
+                cell = next++;
+            }
+            journal.record(MoveJournal::MoveType::Reveal, 0, cells.data(), cells.size());
+            model.push_back(cells);
+            size_t held = 0;
+            for (const auto& move : model) {
+                held += move.size();
+            }
+            while (held > capacity) {
+                held -= model.front().size();
+                model.pop_front();
+                dropped++;
+            }
+
+            bool same = journal.getOldestMoveNumber() == dropped &&
+                        journal.getLatestMoveNumber() == dropped + model.size() &&
+                        journal.getMoveNumber() == journal.getLatestMoveNumber();
+            for (size_t i = 0; i < model.size() && same; ++i) {
+                const MoveJournal::Move* move = journal.getMove(dropped + i);
+                same = move && cellsOf(journal, *move) == model[i];
+            }
+            same = same && (dropped == 0 || !journal.getMove(dropped - 1));
+            if (!CHECK(same)) {
+                std::fprintf(stderr, "  step %d\n", step);
+                return;
+            }
+        }
+
+        // Undo all the way down to the oldest move held, in order, then redo
+        size_t undone = 0;
+        while (const MoveJournal::Move* move = journal.undo()) {
+            CHECK(cellsOf(journal, *move) == model[model.size() - 1 - undone]);
+            undone++;
+        }
+        CHECK(undone == model.size());
+        CHECK(journal.getMoveNumber() == dropped);
+        size_t redone = 0;
+        while (const MoveJournal::Move* move = journal.redo()) {
+            CHECK(cellsOf(journal, *move) == model[redone]);
+            redone++;
+        }
+        CHECK(redone == model.size());
+
+        // A move larger than the ring empties the journal
+        std::vector<size_t> huge(capacity + 1, 0);
+        size_t latest = journal.getLatestMoveNumber();
+        journal.record(MoveJournal::MoveType::Reveal, 0, huge.data(), huge.size());
+        CHECK(!journal.canUndo() && !journal.canRedo());
+        CHECK(journal.getMoveNumber() == latest + 1);
+        std::printf("ring: %zu moves dropped, %zu held and undone\n", dropped, model.size());
+    }
+
+    struct Snapshot {
+        std::vector<std::uint64_t> mines, revealed, flagged;
+        int revealedCount, flagCount, solvedBBBV;
+        Config::GameState state;
+
+        bool operator==(const Snapshot& other) const {
+            return mines == other.mines && revealed == other.revealed && flagged == other.flagged &&
+                   revealedCount == other.revealedCount && flagCount == other.flagCount &&
+                   solvedBBBV == other.solvedBBBV && state == other.state;
+        }
+    };
+
+    Snapshot snapshotOf(const GameLogic& game) {
+        const Board& board = *game.getBoard();
+        size_t words = board.getPlaneWordCount();
+        Snapshot snapshot{std::vector<std::uint64_t>(words), std::vector<std::uint64_t>(words),
+                          std::vector<std::uint64_t>(words), board.getRevealedCount(),
+                          board.getFlagCount(), board.getSolvedBBBV(), game.getGameState()};
+        board.packPlanes(snapshot.mines.data(), snapshot.revealed.data(), snapshot.flagged.data());
+        return snapshot;
+    }
+
+    // A cascade, a flag and a chord undone and redone one by one
+    void testUndoRedo() {
+        GameLogic game(EXPERT);
+        game.startNewGame(8);
+        const Board& board = *game.getBoard();
+        game.handleLeftClick(0, 0); // places the mines
+        CHECK(game.undo());
+        Snapshot start = snapshotOf(game);
+
+        // The first click again, then a cascade elsewhere
+        std::vector<Snapshot> after;
+        CHECK(game.redo());
+        after.push_back(snapshotOf(game));
+        int cascade = 0;
+        for (int y = 0; y < board.getHeight() && !cascade; ++y) {
+            for (int x = 0; x < board.getWidth() && !cascade; ++x) {
+                const Cell& cell = board.getCell(x, y);
+                if (!cell.isRevealed() && !cell.hasMine() && cell.getAdjacentMines() == 0) {
+                    int before = board.getRevealedCount();
+                    game.handleLeftClick(x, y);
+                    cascade = board.getRevealedCount() - before;
+                }
+            }
+        }
+        CHECK(cascade > 1);
+        after.push_back(snapshotOf(game));
+
+        // A flag on a mine next to a revealed number, then a chord on it
+        // when the flag completes it
+        bool chorded = false;
+        for (int y = 0; y < board.getHeight() && !chorded; ++y) {
+            for (int x = 0; x < board.getWidth() && !chorded; ++x) {
+                const Cell& cell = board.getCell(x, y);
+                if (!cell.isRevealed() || cell.getAdjacentMines() != 1) {
+                    continue;
+                }
+                for (int ny = y - 1; ny <= y + 1 && !chorded; ++ny) {
+                    for (int nx = x - 1; nx <= x + 1 && !chorded; ++nx) {
+                        if (board.isCellValid(nx, ny) && board.getCell(nx, ny).hasMine()) {
+                            game.handleRightClick(nx, ny);
+                            after.push_back(snapshotOf(game));
+                            int before = board.getRevealedCount();
+                            game.handleChord(x, y);
+                            chorded = board.getRevealedCount() > before;
+                            if (chorded) {
+                                after.push_back(snapshotOf(game));
+                            } else {
+                                game.undo(); // nothing to chord here: drop the flag
+                                after.pop_back();
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        CHECK(chorded);
+
+        // Down to the start, checking each step, then back up
+        for (size_t i = after.size(); i-- > 0;) {
+            CHECK(snapshotOf(game) == after[i]);
+            CHECK(game.undo());
+            CHECK(board.getLastReveal().cells.empty());
+        }
+        CHECK(snapshotOf(game) == start);
+        CHECK(!game.undo());
+        for (const Snapshot& expected : after) {
+            CHECK(game.redo());
+            CHECK(snapshotOf(game) == expected);
+        }
+        CHECK(!game.redo());
+        std::printf("undo/redo: cascade of %d cells, flag and chord, %zu moves each way\n", cascade, after.size());
+    }
+
+    // Undoing the click on a mine: playing again, the clock going on from
+    // where it stopped; redo ends the game again
+    void testUndoLoss() {
+        GameLogic game(EXPERT);
+        game.startNewGame(9);
+        const Board& board = *game.getBoard();
+        game.handleLeftClick(15, 8);
+        Snapshot alive = snapshotOf(game);
+
+        int mineX = -1, mineY = -1;
+        for (int y = 0; y < board.getHeight() && mineX < 0; ++y) {
+            for (int x = 0; x < board.getWidth() && mineX < 0; ++x) {
+                if (board.getCell(x, y).hasMine()) {
+                    mineX = x;
+                    mineY = y;
+                }
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        game.handleLeftClick(mineX, mineY);
+        CHECK(game.getGameState() == Config::GameState::LOST);
+        std::int64_t stopped = game.getElapsedMilliseconds();
+        CHECK(stopped >= 20);
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        CHECK(game.getElapsedMilliseconds() == stopped);
+
+        CHECK(game.undo());
+        CHECK(game.getGameState() == Config::GameState::PLAYING);
+        CHECK(game.isInProgress());
+        CHECK(snapshotOf(game) == alive);
+        CHECK(!board.getCell(mineX, mineY).isRevealed());
+        std::int64_t resumed = game.getElapsedMilliseconds();
+        CHECK(resumed >= stopped && resumed < stopped + 25); // the 30 ms lost don't count
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        CHECK(game.getElapsedMilliseconds() >= resumed + 30);
+
+        CHECK(game.redo());
+        CHECK(game.getGameState() == Config::GameState::LOST);
+        CHECK(board.getCell(mineX, mineY).isRevealed());
+        std::int64_t again = game.getElapsedMilliseconds();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        CHECK(game.getElapsedMilliseconds() == again);
+        std::printf("undo loss: clock stopped at %lld ms, running again after undo\n",
+                    static_cast<long long>(stopped));
+    }
+
+    // Random reveals, flags and chords until the game ends or 60 moves
+    void playRandomGame(GameLogic& game, std::uint64_t seed) {
+        game.startNewGame(seed);
+        const Board& board = *game.getBoard();
+        std::mt19937 rng(static_cast<std::uint32_t>(seed));
+        game.handleLeftClick(board.getWidth() / 2, board.getHeight() / 2);
+        while (game.getGameState() == Config::GameState::PLAYING && game.getJournal().getMoveNumber() < 60) {
+            int x = static_cast<int>(rng() % board.getWidth());
+            int y = static_cast<int>(rng() % board.getHeight());
+            const Cell& cell = board.getCell(x, y);
+            if (cell.isRevealed()) {
+                game.handleChord(x, y);
+            } else if (cell.hasMine() && rng() % 8 != 0) {
+                game.handleRightClick(x, y);
+            } else if (!cell.isFlagged()) {
+                game.handleLeftClick(x, y);
+            }
+        }
+    }
+
+    // rewindTo(n) leaves the game as a new one given the replay's first n
+    // events (each event a move); forwards and backwards, in any order
+    void testRewindMatchesReplay() {
+        int checked = 0;
+        for (std::uint64_t seed = 31; seed < 36; ++seed) {
+            GameLogic game(EXPERT);
+            playRandomGame(game, seed);
+            std::vector<ReplayEvent> events = game.getReplay().decodeEvents();
+            CHECK(events.size() == game.getJournal().getLatestMoveNumber());
+            Snapshot last = snapshotOf(game);
+
+            std::vector<size_t> targets;
+            for (size_t n = 0; n <= events.size(); n += 1 + events.size() / 7) {
+                targets.push_back(n);
+            }
+            targets.push_back(events.size() / 2);
+            targets.push_back(1);
+            targets.push_back(events.size());
+            for (size_t n : targets) {
+                GameLogic truncated(EXPERT);
+                truncated.startReplayedGame(game.getReplay().getSeed());
+                for (size_t i = 0; i < n; ++i) {
+                    const ReplayEvent& event = events[i];
+                    switch (event.action) {
+                        case ReplayAction::Reveal: truncated.handleLeftClick(event.x, event.y); break;
+                        case ReplayAction::Flag: truncated.handleRightClick(event.x, event.y); break;
+                        case ReplayAction::Chord: truncated.handleChord(event.x, event.y); break;
+                        default: break;
+                    }
+                }
+
+                CHECK(game.rewindTo(n));
+                CHECK(game.getJournal().getMoveNumber() == n);
+                Snapshot rewound = snapshotOf(game);
+                if (n == 0) {
+                    // The board stays mined when the first move is undone
+                    rewound.mines = snapshotOf(truncated).mines;
+                }
+                if (!CHECK(rewound == snapshotOf(truncated))) {
+                    std::fprintf(stderr, "  seed %llu, move %zu of %zu\n",
+                                 static_cast<unsigned long long>(seed), n, events.size());
+                }
+                CHECK(Replay::hashBoard(*game.getBoard()) == Replay::hashBoard(*truncated.getBoard()) || n == 0);
+                checked++;
+            }
+            CHECK(snapshotOf(game) == last);
+        }
+        std::printf("rewind: %d positions matched against truncated replays\n", checked);
+    }
+}
+
+int main() {
+    testRingOverflow();
+    testUndoRedo();
+    testUndoLoss();
+    testRewindMatchesReplay();
+    return TEST_RESULT();
+}
@@ -0,0 +1,198 @@
+// Memory-mapped board files (Board::createMapped/openMapped): a board
+// created, played, flushed and reopened in both layouts comes back cell for
+// cell, and headers that don't describe the file are refused before any
+// cell is touched.
+
+#include "Check.hpp"
+#include "Logic/Board.hpp"
+#include "Logic/BoardFile.hpp"
+#include "Logic/Replay.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+using namespace Minesweeper;
+
+namespace {
+    const char* const PATH = "mapped_test.msboard";
+    const int WIDTH = 203, HEIGHT = 150, MINES = 4000; // tiles padded on the right and bottom
+
+    std::vector<char> readFile(const char* path) {
+        std::ifstream in(path, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    void writeFile(const char* path, const std::vector<char>& bytes) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    bool sameCells(const Board& a, const Board& b) {
+        if (a.getWidth() != b.getWidth() || a.getHeight() != b.getHeight() ||
+            a.getMineCount() != b.getMineCount() || a.getRevealedCount() != b.getRevealedCount() ||
+            a.getFlagCount() != b.getFlagCount() || a.isInitialized() != b.isInitialized()) {
+            return false;
+        }
+        for (int y = 0; y < a.getHeight(); ++y) {
+            for (int x = 0; x < a.getWidth(); ++x) {
+                const Cell& ca = a.getCell(x, y);
+                const Cell& cb = b.getCell(x, y);
+                if (ca.hasMine() != cb.hasMine() || ca.isRevealed() != cb.isRevealed() ||
+                    ca.isFlagged() != cb.isFlagged() || ca.getAdjacentMines() != cb.getAdjacentMines()) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // A first click, flags on the first mines of each row, a few reveals
+    void play(Board& board) {
+        board.reset(77);
+        board.initialize(board.getWidth() / 2, board.getHeight() / 2);
+        board.revealCell(board.getWidth() / 2, board.getHeight() / 2);
+        for (int y = 0; y < board.getHeight(); ++y) {
+            bool flagged = false;
+            for (int x = 0; x < board.getWidth(); ++x) {
+                const Cell& cell = board.getCell(x, y);
+                if (!flagged && cell.hasMine()) {
+                    board.toggleFlag(x, y);
+                    flagged = true;
+                } else if (!cell.hasMine() && !cell.isRevealed() && (x * 31 + y * 17) % 97 == 0) {
+                    board.revealCell(x, y);
+                }
+            }
+        }
+    }
+
+    void testRoundTrip(CellLayout layout) {
+        std::remove(PATH);
+        Board reference(WIDTH, HEIGHT, MINES, layout);
+        play(reference);
+
+        {
+            std::unique_ptr<Board> board = Board::createMapped(PATH, WIDTH, HEIGHT, MINES, layout);
+            if (!CHECK(board != nullptr)) {
+                return;
+            }
+            CHECK(board->isMapped());
+            CHECK(!board->resize(WIDTH, HEIGHT + 1, MINES));
+            play(*board);
+            CHECK(sameCells(*board, reference));
+            CHECK(Replay::hashBoard(*board) == Replay::hashBoard(reference));
+            CHECK(board->flush());
+
+            // Changes after the flush reach the file when the board closes
+            board->toggleFlag(0, 0);
+            reference.toggleFlag(0, 0);
+        }
+
+        std::vector<char> bytes = readFile(PATH);
+        CHECK(bytes.size() == sizeof(BoardFileHeader) + reference.getStorageSize());
+
+        std::unique_ptr<Board> reopened = Board::openMapped(PATH);
+        if (!CHECK(reopened != nullptr)) {
+            return;
+        }
+        CHECK(reopened->getLayout() == layout);
+        CHECK(sameCells(*reopened, reference));
+        CHECK(Replay::hashBoard(*reopened) == Replay::hashBoard(reference));
+
+        // And once more, after playing on the reopened board
+        reopened->toggleFlag(WIDTH - 1, HEIGHT - 1);
+        reference.toggleFlag(WIDTH - 1, HEIGHT - 1);
+        CHECK(reopened->flush());
+        reopened.reset();
+        reopened = Board::openMapped(PATH);
+        CHECK(reopened && sameCells(*reopened, reference));
+        reopened.reset();
+        std::remove(PATH);
+        std::printf("round trip (%s): %dx%d, %d revealed, %d flags\n",
+                    layout == CellLayout::Tiled ? "tiled" : "row-major", WIDTH, HEIGHT,
+                    reference.getRevealedCount(), reference.getFlagCount());
+    }
+
+    // Each damaged copy of a valid file is refused and left as it was
+    void testCorruptedHeaders() {
+        std::remove(PATH);
+        {
+            std::unique_ptr<Board> board = Board::createMapped(PATH, 40, 30, 200, CellLayout::Tiled);
+            CHECK(board != nullptr);
+            if (board) {
+                play(*board);
+            }
+        }
+        const std::vector<char> good = readFile(PATH);
+        BoardFileHeader header;
+        std::memcpy(&header, good.data(), sizeof(header));
+
+        std::vector<std::vector<char>> bad;
+        auto withHeader = [&](void (*edit)(BoardFileHeader&)) {
+            BoardFileHeader damaged = header;
+            edit(damaged);
+            std::vector<char> bytes = good;
+            std::memcpy(bytes.data(), &damaged, sizeof(damaged));
+            bad.push_back(bytes);
+        };
+        withHeader([](BoardFileHeader& h) { h.magic[3] ^= 0x20; });
+        withHeader([](BoardFileHeader& h) { h.version = 2; });
+        withHeader([](BoardFileHeader& h) { h.headerSize = 128; });
+        withHeader([](BoardFileHeader& h) { h.bitsPerCell = 4; });
+        withHeader([](BoardFileHeader& h) { h.tileWidth = 4; h.tileHeight = 4; });
+        withHeader([](BoardFileHeader& h) { h.width = 0; });
+        withHeader([](BoardFileHeader& h) { h.height = 0; });
+        withHeader([](BoardFileHeader& h) { h.width = 0x10000; h.height = 0x10000; }); // 2^32 cells
+        withHeader([](BoardFileHeader& h) { h.width = 0x7FFFFFFF; h.height = 2; });
+        withHeader([](BoardFileHeader& h) { h.width = 80; }); // cells past the end of the file
+        withHeader([](BoardFileHeader& h) { h.mineCount = 40 * 30 + 1; });
+        withHeader([](BoardFileHeader& h) { h.flagCount = 0xFFFFFFFF; });
+        withHeader([](BoardFileHeader& h) { h.revealedCount = 40 * 30 + 1; });
+        bad.emplace_back(good.begin(), good.end() - 1);
+        bad.emplace_back(good.begin(), good.begin() + sizeof(BoardFileHeader));
+        bad.emplace_back(good.begin(), good.begin() + 20);
+        bad.emplace_back();
+
+        int refused = 0;
+        for (size_t i = 0; i < bad.size(); ++i) {
+            writeFile(PATH, bad[i]);
+            std::unique_ptr<Board> board = Board::openMapped(PATH);
+            if (!CHECK(!board)) {
+                std::fprintf(stderr, "  damaged file %zu opened\n", i);
+                continue;
+            }
+            CHECK(readFile(PATH) == bad[i]);
+            refused++;
+        }
+
+        writeFile(PATH, good);
+        std::unique_ptr<Board> board = Board::openMapped(PATH);
+        CHECK(board && board->getWidth() == 40 && board->getHeight() == 30);
+        board.reset();
+        std::remove(PATH);
+
+        // Sizes createMapped() refuses, before creating the file
+        const int sizes[][3] = {{0, 10, 0}, {10, 0, 0}, {10, 10, -1}, {10, 10, 101},
+                                {70000, 70000, 10}, {65536, 32768, 0}}; // 2^31 cells
+        int refusedSizes = 0;
+        for (const auto& size : sizes) {
+            for (CellLayout layout : {CellLayout::RowMajor, CellLayout::Tiled}) {
+                CHECK(!Board::createMapped(PATH, size[0], size[1], size[2], layout));
+                CHECK(!std::ifstream(PATH));
+                refusedSizes++;
+            }
+        }
+        std::printf("corrupted: %d damaged files and %d sizes refused\n", refused, refusedSizes);
+    }
+}
+
+int main() {
+    testRoundTrip(CellLayout::RowMajor);
+    testRoundTrip(CellLayout::Tiled);
+    testCorruptedHeaders();
+    return TEST_RESULT();
+}
@@ -0,0 +1,133 @@
+// NoGuessGenerator: a board within the first click's budget, the same one
+// whatever the number of threads, and cleared from the first click without
+// guessing. That last check enumerates every mine layout (BruteForce.hpp)
+// instead of trusting the solvers the generator plays with.
+
+#include "BruteForce.hpp"
+#include "Check.hpp"
+#include "Logic/NoGuessGenerator.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+using namespace Minesweeper;
+using namespace Minesweeper::Test;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct Settings {
+        int width;
+        int height;
+        int mineCount;
+    };
+
+    const Settings DIFFICULTIES[] = {{9, 9, 10}, {16, 16, 40}, {30, 16, 99}};
+
+    double millisecondsSince(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    // Every safe cell gets revealed, a step at a time, from cells proven
+    // safe by the enumeration alone
+    bool clearsWithoutGuessing(const Settings& settings, std::uint64_t seed, int firstX, int firstY) {
+        Board board(settings.width, settings.height, settings.mineCount);
+        board.reset(seed);
+        board.initialize(firstX, firstY);
+        if (board.revealCell(firstX, firstY)) {
+            return false;
+        }
+        int safeCount = settings.width * settings.height - settings.mineCount;
+        while (board.getRevealedCount() < safeCount) {
+            Enumeration layouts = enumerateLayouts(board);
+            bool progress = false;
+            for (int y = 0; y < settings.height; ++y) {
+                for (int x = 0; x < settings.width; ++x) {
+                    if (!board.getCell(x, y).isRevealed() && layouts.isSafe(static_cast<size_t>(y) * settings.width + x)) {
+                        CHECK(!board.revealCell(x, y));
+                        progress = true;
+                    }
+                }
+            }
+            if (!progress) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // The search ends within the budget, with a board, from the centre and
+    // from a corner
+    void testBudget() {
+        for (const Settings& settings : DIFFICULTIES) {
+            const int clicks[][2] = {{settings.width / 2, settings.height / 2}, {0, 0}};
+            double slowest = 0.0;
+            for (const auto& click : clicks) {
+                for (std::uint64_t baseSeed = 1; baseSeed <= 20; ++baseSeed) {
+                    Clock::time_point start = Clock::now();
+                    std::uint64_t seed;
+                    CHECK(NoGuessGenerator::findSeed(settings.width, settings.height, settings.mineCount,
+                                                     click[0], click[1], baseSeed * 7919, seed));
+                    slowest = std::max(slowest, millisecondsSince(start));
+                }
+            }
+            std::printf("%dx%d, %d mines: slowest search %.1f ms\n",
+                        settings.width, settings.height, settings.mineCount, slowest);
+            CHECK(slowest <= NoGuessGenerator::BUDGET_MILLISECONDS);
+        }
+    }
+
+    // Out of time: an ordinary board, from the base seed, straight away
+    void testTimeout() {
+        Clock::time_point start = Clock::now();
+        std::uint64_t seed = 0;
+        CHECK(!NoGuessGenerator::findSeed(30, 16, 99, 15, 8, 12345, seed, 1, 0.0));
+        CHECK(seed == 12345);
+        CHECK(millisecondsSince(start) < NoGuessGenerator::BUDGET_MILLISECONDS);
+    }
+
+    // Same base seed and first click, same board, on one thread or several
+    void testDeterminism() {
+        for (std::uint64_t baseSeed = 1; baseSeed <= 10; ++baseSeed) {
+            std::uint64_t single, several;
+            CHECK(NoGuessGenerator::findSeed(16, 16, 40, 3, 5, baseSeed, single, 1));
+            CHECK(NoGuessGenerator::findSeed(16, 16, 40, 3, 5, baseSeed, several, 4));
+            CHECK(single == several);
+        }
+    }
+
+    void testNoGuessing() {
+        const Settings boards[] = {{9, 9, 10}, {8, 8, 12}, {12, 6, 14}};
+        for (const Settings& settings : boards) {
+            for (std::uint64_t baseSeed = 1; baseSeed <= 15; ++baseSeed) {
+                int firstX = static_cast<int>(baseSeed % settings.width);
+                int firstY = static_cast<int>(baseSeed * 5 % settings.height);
+                std::uint64_t seed;
+                if (!CHECK(NoGuessGenerator::findSeed(settings.width, settings.height, settings.mineCount,
+                                                      firstX, firstY, baseSeed, seed))) {
+                    continue;
+                }
+                if (!CHECK(clearsWithoutGuessing(settings, seed, firstX, firstY))) {
+                    std::fprintf(stderr, "  %dx%d, seed %llu, first click (%d, %d)\n", settings.width,
+                                 settings.height, static_cast<unsigned long long>(seed), firstX, firstY);
+                }
+            }
+        }
+
+        // The check itself can fail: about half of these ordinary boards
+        // need a guess
+        int guessing = 0;
+        for (std::uint64_t seed = 1; seed <= 20; ++seed) {
+            guessing += clearsWithoutGuessing({8, 8, 12}, seed, 0, 0) ? 0 : 1;
+        }
+        CHECK(guessing > 0);
+    }
+}
+
+int main() {
+    testBudget();
+    testTimeout();
+    testDeterminism();
+    testNoGuessing();
+    return TEST_RESULT();
+}
@@ -0,0 +1,190 @@
+// Openings precomputed at initialize() (BoardOpenings.cpp): the 3BV
+// metrics against a direct count, and games played with random clicks,
+// flags and chords revealing exactly what the plain flood fill does
+// (FloodFill.hpp), up to a solved 3BV equal to the board's.
+
+#include "Check.hpp"
+#include "FloodFill.hpp"
+#include "Logic/Random.hpp"
+#include <cstdio>
+#include <vector>
+
+using namespace Minesweeper;
+using namespace Minesweeper::Test;
+
+namespace {
+    bool hasZeroNeighbor(const Board& board, int x, int y) {
+        for (int ny = y - 1; ny <= y + 1; ++ny) {
+            for (int nx = x - 1; nx <= x + 1; ++nx) {
+                if ((nx != x || ny != y) && board.isCellValid(nx, ny) && !board.getCell(nx, ny).hasMine() &&
+                    board.getCell(nx, ny).getAdjacentMines() == 0) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // Openings are the 8-connected groups of zero cells; isolated numbers
+    // the numbers touching none
+    BoardMetrics countMetrics(const Board& board) {
+        int width = board.getWidth(), height = board.getHeight();
+        BoardMetrics metrics;
+        std::vector<bool> seen(static_cast<size_t>(width) * height, false);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                const Cell& cell = board.getCell(x, y);
+                if (cell.hasMine()) {
+                    continue;
+                }
+                if (cell.getAdjacentMines() != 0) {
+                    metrics.isolatedNumbers += !hasZeroNeighbor(board, x, y);
+                    continue;
+                }
+                if (seen[static_cast<size_t>(y) * width + x]) {
+                    continue;
+                }
+                metrics.openings++;
+                std::vector<std::pair<int, int>> stack{{x, y}};
+                seen[static_cast<size_t>(y) * width + x] = true;
+                while (!stack.empty()) {
+                    auto [cx, cy] = stack.back();
+                    stack.pop_back();
+                    for (int ny = cy - 1; ny <= cy + 1; ++ny) {
+                        for (int nx = cx - 1; nx <= cx + 1; ++nx) {
+                            size_t neighbor = static_cast<size_t>(ny) * width + nx;
+                            if (board.isCellValid(nx, ny) && !seen[neighbor] && !board.getCell(nx, ny).hasMine() &&
+                                board.getCell(nx, ny).getAdjacentMines() == 0) {
+                                seen[neighbor] = true;
+                                stack.push_back({nx, ny});
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        metrics.bbbv = metrics.openings + metrics.isolatedNumbers;
+        return metrics;
+    }
+
+    struct Case {
+        int width, height, mines;
+    };
+    const Case CASES[] = {{9, 9, 10}, {16, 16, 40}, {30, 16, 99}, {64, 40, 200}, {100, 70, 300}, {5, 90, 20}};
+
+    void testMetrics() {
+        for (const Case& c : CASES) {
+            for (std::uint64_t seed = 1; seed <= 10; ++seed) {
+                for (CellLayout layout : {CellLayout::RowMajor, CellLayout::Tiled}) {
+                    Board board(c.width, c.height, c.mines, layout);
+                    board.reset(seed);
+                    board.initialize(static_cast<int>(seed % c.width), static_cast<int>(seed * 3 % c.height));
+                    BoardMetrics expected = countMetrics(board);
+                    const BoardMetrics& metrics = board.getMetrics();
+                    CHECK(board.hasOpenings());
+                    CHECK(metrics.openings == expected.openings && board.getOpeningCount() == expected.openings);
+                    CHECK(metrics.isolatedNumbers == expected.isolatedNumbers);
+                    CHECK(metrics.bbbv == expected.bbbv);
+                }
+            }
+        }
+    }
+
+    // Chord on (x, y) with its mines flagged: every hidden neighbor floods
+    std::vector<bool> chordFill(const Board& board, int x, int y) {
+        std::vector<bool> expected = revealedCells(board);
+        for (int ny = y - 1; ny <= y + 1; ++ny) {
+            for (int nx = x - 1; nx <= x + 1; ++nx) {
+                if (!board.isCellValid(nx, ny) || board.getCell(nx, ny).isFlagged() ||
+                    expected[static_cast<size_t>(ny) * board.getWidth() + nx]) {
+                    continue;
+                }
+                std::vector<bool> filled = floodFill(board, nx, ny);
+                for (size_t i = 0; i < filled.size(); ++i) {
+                    expected[i] = expected[i] || filled[i];
+                }
+            }
+        }
+        return expected;
+    }
+
+    // Flags land anywhere, zero cells of unopened openings included (the
+    // click then takes the BFS), and are often lifted again
+    void playRandomGame(Board& board, Random::Generator& random, int& mismatches) {
+        int width = board.getWidth(), height = board.getHeight();
+        auto pick = [&random](int n) { return static_cast<int>(random.uniform() * n); };
+        int safeCount = width * height - board.getMineCount();
+        for (int move = 0; move < 4 * width * height && board.getRevealedCount() < safeCount; ++move) {
+            int x = pick(width), y = pick(height);
+            const Cell& cell = board.getCell(x, y);
+            int action = pick(10);
+            if (action < 3 && !cell.isRevealed()) {
+                board.toggleFlag(x, y);
+            } else if (action < 5 && cell.isRevealed() && cell.getAdjacentMines() > 0) {
+                // Flag exactly its mines, then chord
+                for (int ny = y - 1; ny <= y + 1; ++ny) {
+                    for (int nx = x - 1; nx <= x + 1; ++nx) {
+                        if (board.isCellValid(nx, ny) && !board.getCell(nx, ny).isRevealed() &&
+                            board.getCell(nx, ny).hasMine() != board.getCell(nx, ny).isFlagged()) {
+                            board.toggleFlag(nx, ny);
+                        }
+                    }
+                }
+                std::vector<bool> expected = chordFill(board, x, y);
+                CHECK(!board.chordCell(x, y));
+                mismatches += revealedCells(board) != expected;
+            } else if (!cell.isRevealed() && !cell.hasMine()) {
+                if (cell.isFlagged()) {
+                    board.toggleFlag(x, y);
+                }
+                std::vector<bool> expected = floodFill(board, x, y);
+                CHECK(!board.revealCell(x, y));
+                mismatches += revealedCells(board) != expected;
+            }
+        }
+        // Whatever the flags left hidden, clicked one by one
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                if (!board.getCell(x, y).isRevealed() && !board.getCell(x, y).hasMine()) {
+                    if (board.getCell(x, y).isFlagged()) {
+                        board.toggleFlag(x, y);
+                    }
+                    std::vector<bool> expected = floodFill(board, x, y);
+                    board.revealCell(x, y);
+                    mismatches += revealedCells(board) != expected;
+                }
+            }
+        }
+    }
+
+    void testRandomGames() {
+        Random::Generator random(12345);
+        for (const Case& c : CASES) {
+            for (std::uint64_t seed = 1; seed <= 6; ++seed) {
+                for (CellLayout layout : {CellLayout::RowMajor, CellLayout::Tiled}) {
+                    Board board(c.width, c.height, c.mines, layout);
+                    board.reset(seed);
+                    int firstX = static_cast<int>(seed * 5 % c.width), firstY = static_cast<int>(seed % c.height);
+                    board.initialize(firstX, firstY);
+                    std::vector<bool> expected = floodFill(board, firstX, firstY);
+                    board.revealCell(firstX, firstY);
+                    int mismatches = revealedCells(board) != expected;
+
+                    playRandomGame(board, random, mismatches);
+                    if (!CHECK(mismatches == 0)) {
+                        std::fprintf(stderr, "  %dx%d, seed %llu: %d reveals differ\n", c.width, c.height,
+                                     static_cast<unsigned long long>(seed), mismatches);
+                    }
+                    CHECK(board.getRevealedCount() == c.width * c.height - c.mines);
+                    CHECK(board.getSolvedBBBV() == board.getMetrics().bbbv);
+                }
+            }
+        }
+    }
+}
+
+int main() {
+    testMetrics();
+    testRandomGames();
+    return TEST_RESULT();
+}
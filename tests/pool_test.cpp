@@ -0,0 +1,84 @@
+// BoardPool: pooled boards, moved to the real first click, give games that
+// replay (the origin is recorded), and stopping the pool doesn't wait for
+// a no-guess search
+
+#include "Check.hpp"
+#include "Logic/GameLogic.hpp"
+#include "Logic/ReplayPlayer.hpp"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+
+using namespace Minesweeper;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    const Config::DifficultySettings EXPERT{30, 16, 99, 0};
+
+    // A first click at (x, y) served from the pool, retried (as new games)
+    // until the producer has filled that queue, at most a few seconds
+    bool startPooledGame(GameLogic& game, int x, int y, std::uint64_t seed) {
+        Clock::time_point limit = Clock::now() + std::chrono::seconds(5);
+        do {
+            game.startNewGame(seed);
+            game.handleLeftClick(x, y);
+            if (game.getBoard()->hasOrigin()) {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        } while (Clock::now() < limit);
+        return false;
+    }
+
+    // Every first click of a row, then of a column: edges, corners and
+    // inside cells, reached through each kind of transform
+    void testPooledGames(bool noGuess) {
+        auto pool = std::make_shared<BoardPool>();
+        CHECK(pool->addSettings(EXPERT.width, EXPERT.height, EXPERT.mines, noGuess));
+        GameLogic game(EXPERT);
+        game.setNoGuess(noGuess);
+        game.setBoardPool(pool);
+        GameLogic player(EXPERT);
+        player.setRecordingReplay(false);
+
+        for (int click = 0; click < EXPERT.width + EXPERT.height; ++click) {
+            int x = click < EXPERT.width ? click : click % 3;
+            int y = click < EXPERT.width ? click % EXPERT.height : click - EXPERT.width;
+            if (!CHECK(startPooledGame(game, x, y, click + 1))) {
+                return;
+            }
+            CHECK(!game.isGameOver() || game.isGameWon()); // the first click is safe
+            game.handleRightClick((x + 7) % EXPERT.width, (y + 3) % EXPERT.height);
+
+            Replay replay = game.getReplay();
+            replay.setResult(game.getReplayResult());
+            CHECK(replay.hasOrigin());
+            ReplayPlayer::Report report = ReplayPlayer::play(replay, player);
+            if (!CHECK(report.ok)) {
+                std::fprintf(stderr, "  first click (%d, %d): %s\n", x, y, report.error.c_str());
+            }
+        }
+    }
+
+    // A density the search never clears: the producer is inside findSeed
+    // when the pool goes away
+    void testStopDuringSearch() {
+        auto pool = std::make_unique<BoardPool>();
+        CHECK(pool->addSettings(30, 16, 200, true));
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        Clock::time_point start = Clock::now();
+        pool.reset();
+        double milliseconds = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        std::printf("pool stopped in %.1f ms\n", milliseconds);
+        CHECK(milliseconds < 50.0);
+    }
+}
+
+int main() {
+    testPooledGames(false);
+    testPooledGames(true);
+    testStopDuringSearch();
+    return TEST_RESULT();
+}
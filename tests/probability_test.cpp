@@ -0,0 +1,148 @@
+// ProbabilityEngine: every cell's mine probability against the exact one
+// from the enumeration of all mine layouts (BruteForce.hpp) on small
+// boards, and on boards too large to enumerate, the probabilities adding
+// up to the mine count.
+
+#include "BruteForce.hpp"
+#include "Check.hpp"
+#include "Logic/ProbabilityEngine.hpp"
+#include "Logic/Random.hpp"
+#include "Logic/Solver.hpp"
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace Minesweeper;
+using namespace Minesweeper::Test;
+
+namespace {
+    struct Case {
+        int width, height, mines;
+    };
+
+    // States of games advanced by revealing random safe cells:
+    // fn(board, solver) at each, the solver solved
+    template <typename Fn>
+    void forEachState(const Case& c, std::uint64_t seed, Random::Generator& random, Fn&& fn) {
+        Board board(c.width, c.height, c.mines);
+        board.reset(seed);
+        int firstX = static_cast<int>(seed % c.width), firstY = static_cast<int>(seed * 7 % c.height);
+        board.initialize(firstX, firstY);
+        board.revealCell(firstX, firstY);
+
+        int safeCount = c.width * c.height - c.mines;
+        while (board.getRevealedCount() < safeCount) {
+            Solver solver;
+            solver.attach(board);
+            CHECK(solver.solve());
+            fn(board, solver);
+
+            std::vector<std::pair<int, int>> hiddenSafe;
+            for (int y = 0; y < c.height; ++y) {
+                for (int x = 0; x < c.width; ++x) {
+                    if (!board.getCell(x, y).isRevealed() && !board.getCell(x, y).hasMine()) {
+                        hiddenSafe.push_back({x, y});
+                    }
+                }
+            }
+            auto next = hiddenSafe[static_cast<size_t>(random.uniform() * hiddenSafe.size())];
+            board.revealCell(next.first, next.second);
+        }
+    }
+
+    void testExact() {
+        const Case cases[] = {{8, 8, 10}, {9, 9, 10}, {10, 6, 12}, {7, 7, 12}, {12, 4, 9}};
+        Random::Generator random(77);
+        ProbabilityEngine engine;
+        int states = 0, incomplete = 0, wrong = 0;
+        double worst = 0.0;
+        for (const Case& c : cases) {
+            for (std::uint64_t seed = 1; seed <= 20; ++seed) {
+                forEachState(c, seed, random, [&](const Board& board, const Solver& solver) {
+                    ProbabilityMap map;
+                    CHECK(engine.compute(solver, map, 1000.0));
+                    states++;
+                    incomplete += !map.complete;
+
+                    Enumeration layouts = enumerateLayouts(board);
+                    for (int y = 0; y < c.height; ++y) {
+                        for (int x = 0; x < c.width; ++x) {
+                            size_t cell = static_cast<size_t>(y) * c.width + x;
+                            double expected = board.getCell(x, y).isRevealed() ? 0.0 : layouts.probability(cell);
+                            double error = std::fabs(map.at(x, y) - expected);
+                            worst = std::max(worst, error);
+                            wrong += error > 1e-5;
+                        }
+                    }
+                });
+            }
+        }
+        std::printf("%d states, largest error %.2e\n", states, worst);
+        CHECK(states > 400);
+        CHECK(incomplete == 0);
+        CHECK(wrong == 0);
+    }
+
+    // Each layout has exactly mineCount mines, so the probabilities of the
+    // hidden cells add up to it, exactly when the map is complete
+    void testMineTotal() {
+        const Case cases[] = {{30, 16, 99}, {50, 50, 400}};
+        Random::Generator random(78);
+        ProbabilityEngine engine;
+        int states = 0, complete = 0;
+        for (const Case& c : cases) {
+            for (std::uint64_t seed = 1; seed <= 4; ++seed) {
+                forEachState(c, seed, random, [&](const Board& board, const Solver& solver) {
+                    ProbabilityMap map;
+                    CHECK(engine.compute(solver, map, 1000.0));
+                    double total = 0.0;
+                    bool inRange = true;
+                    for (int y = 0; y < c.height; ++y) {
+                        for (int x = 0; x < c.width; ++x) {
+                            float p = map.at(x, y);
+                            inRange = inRange && p >= 0.0f && p <= 1.0f;
+                            total += board.getCell(x, y).isRevealed() ? 0.0 : p;
+                        }
+                    }
+                    CHECK(inRange);
+                    if (map.complete) {
+                        complete++;
+                        CHECK(std::fabs(total - c.mines) < 1e-3 * c.mines);
+                    }
+                    states++;
+                });
+            }
+        }
+        std::printf("%d large states, %d complete\n", states, complete);
+        CHECK(complete > states / 2);
+    }
+
+    // Out of time: local estimates, still probabilities, the map marked
+    // incomplete when a component wasn't counted
+    void testNoBudget() {
+        Random::Generator random(79);
+        ProbabilityEngine engine;
+        int incomplete = 0;
+        forEachState({30, 16, 99}, 9, random, [&](const Board& board, const Solver& solver) {
+            ProbabilityMap map;
+            CHECK(engine.compute(solver, map, 0.0));
+            bool valid = true;
+            for (int y = 0; y < 16; ++y) {
+                for (int x = 0; x < 30; ++x) {
+                    float p = map.at(x, y);
+                    valid = valid && p >= 0.0f && p <= 1.0f && (!board.getCell(x, y).isRevealed() || p == 0.0f);
+                }
+            }
+            CHECK(valid);
+            incomplete += !map.complete;
+        });
+        CHECK(incomplete > 0);
+    }
+}
+
+int main() {
+    testExact();
+    testMineTotal();
+    testNoBudget();
+    return TEST_RESULT();
+}
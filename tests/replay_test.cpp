@@ -0,0 +1,114 @@
+// Recorded games play back to the same end (GameLogic records, ReplayPlayer
+// plays, as replay_verify does)
+
+#include "Check.hpp"
+#include "Logic/GameLogic.hpp"
+#include "Logic/ReplayPlayer.hpp"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace Minesweeper;
+
+namespace {
+    const Config::DifficultySettings BEGINNER{9, 9, 10, 0};
+
+    // Plays the recorded game back on a fresh GameLogic, through a file
+    bool playsBack(const GameLogic& game, std::string& error) {
+        Replay replay = game.getReplay();
+        replay.setResult(game.getReplayResult());
+        std::string path = "replay_test" + std::string(ReplayFile::EXTENSION);
+        Replay loaded;
+        if (!replay.save(path) || !loaded.load(path)) {
+            error = "cannot save or load the replay";
+            return false;
+        }
+        std::remove(path.c_str());
+
+        GameLogic player(BEGINNER);
+        player.setRecordingReplay(false);
+        ReplayPlayer::Report report = ReplayPlayer::play(loaded, player);
+        error = report.error;
+        return report.ok;
+    }
+
+    // The first left click on a flagged cell does nothing: the mines are
+    // laid by the next one, which is the one the replay records
+    void testFirstClickOnFlag() {
+        GameLogic game(BEGINNER);
+        game.startNewGame(0xca65d1555075e73aULL);
+        game.handleRightClick(5, 7);
+        game.handleLeftClick(5, 7);
+        CHECK(!game.isInProgress());
+        CHECK(game.getElapsedMilliseconds() == 0);
+        game.handleRightClick(8, 7);
+        game.handleLeftClick(7, 5);
+        CHECK(game.isInProgress() || game.isGameOver());
+
+        std::string error;
+        CHECK(playsBack(game, error));
+        if (!error.empty()) {
+            std::fprintf(stderr, "  %s\n", error.c_str());
+        }
+    }
+
+    // Ordinary and no-guess games, a few clicks each
+    void testPlayBack(bool noGuess) {
+        GameLogic game(BEGINNER);
+        game.setNoGuess(noGuess);
+        for (std::uint64_t seed = 1; seed <= 20; ++seed) {
+            game.startNewGame(seed);
+            for (int click = 0; click < 6 && !game.isGameOver(); ++click) {
+                int cell = static_cast<int>((seed * 31 + click * 17) % 81);
+                game.handleLeftClick(cell % 9, cell / 9);
+                game.handleRightClick((cell + 40) % 9, (cell + 40) % 81 / 9);
+            }
+            std::string error;
+            if (!CHECK(playsBack(game, error))) {
+                std::fprintf(stderr, "  seed %llu: %s\n", static_cast<unsigned long long>(seed), error.c_str());
+            }
+        }
+    }
+
+    // A replay header declaring a board over ReplayFile::MAX_CELLS is
+    // refused before anything is allocated for it
+    void testRejectsHugeBoard() {
+        const std::uint64_t sizes[][2] = {{0x7FFFFFFF, 0x7FFFFFFF}, {2048, 2049}, {ReplayFile::MAX_CELLS + 1, 1}};
+        for (const auto& size : sizes) {
+            std::vector<std::uint8_t> data(ReplayFile::MAGIC, ReplayFile::MAGIC + sizeof(ReplayFile::MAGIC));
+            ReplayCoding::putVarint(data, ReplayFile::VERSION);
+            ReplayCoding::putVarint(data, size[0]);
+            ReplayCoding::putVarint(data, size[1]);
+            ReplayCoding::putVarint(data, 10); // mines
+            data.insert(data.end(), 8, 0);     // seed
+            for (int field = 0; field < 8; ++field) {
+                ReplayCoding::putVarint(data, 0); // origin, no events, empty result
+            }
+            data.insert(data.end(), 8, 0); // board hash
+
+            std::string path = "replay_test_huge" + std::string(ReplayFile::EXTENSION);
+            std::FILE* file = std::fopen(path.c_str(), "wb");
+            CHECK(file && std::fwrite(data.data(), 1, data.size(), file) == data.size());
+            if (file) {
+                std::fclose(file);
+            }
+            Replay replay;
+            CHECK(!replay.load(path));
+            std::remove(path.c_str());
+        }
+
+        Replay largest;
+        largest.begin(2048, 2048, 10, 1);
+        std::string path = "replay_test_largest" + std::string(ReplayFile::EXTENSION);
+        CHECK(largest.save(path) && Replay().load(path));
+        std::remove(path.c_str());
+    }
+}
+
+int main() {
+    testFirstClickOnFlag();
+    testPlayBack(false);
+    testPlayBack(true);
+    testRejectsHugeBoard();
+    return TEST_RESULT();
+}
@@ -0,0 +1,225 @@
+// Saved games (GameLogic::saveGame/loadGame): a game in progress and a lost
+// one come back with the same planes, timer and state in both cell
+// layouts, and damaged or inconsistent saves are refused with the game
+// left as it was.
+
+#include "Check.hpp"
+#include "Logic/GameLogic.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace Minesweeper;
+
+namespace {
+    const Config::DifficultySettings SETTINGS = {30, 16, 99, 0}; // tiles padded on both sides
+    const char* const PATH = "save_test.mssave";
+
+    struct Planes {
+        std::vector<std::uint64_t> mines, revealed, flagged;
+        bool operator==(const Planes& other) const {
+            return mines == other.mines && revealed == other.revealed && flagged == other.flagged;
+        }
+    };
+
+    Planes planesOf(const GameLogic& game) {
+        const Board& board = *game.getBoard();
+        size_t words = board.getPlaneWordCount();
+        Planes planes{std::vector<std::uint64_t>(words), std::vector<std::uint64_t>(words),
+                      std::vector<std::uint64_t>(words)};
+        board.packPlanes(planes.mines.data(), planes.revealed.data(), planes.flagged.data());
+        return planes;
+    }
+
+    // A few moves: the first click, flags on some mines, a safe click
+    void playSome(GameLogic& game, std::uint64_t seed) {
+        game.startNewGame(seed);
+        game.handleLeftClick(SETTINGS.width / 2, SETTINGS.height / 2);
+        const Board& board = *game.getBoard();
+        int flags = 0, clicks = 0;
+        for (int y = 0; y < board.getHeight(); ++y) {
+            for (int x = 0; x < board.getWidth(); ++x) {
+                const Cell& cell = board.getCell(x, y);
+                if (cell.isRevealed()) {
+                    continue;
+                }
+                if (cell.hasMine() && flags < 5) {
+                    game.handleRightClick(x, y);
+                    flags++;
+                } else if (!cell.hasMine() && clicks < 2 && (x + y) % 7 == 0) {
+                    game.handleLeftClick(x, y);
+                    clicks++;
+                }
+            }
+        }
+    }
+
+    bool sameGame(const GameLogic& a, const GameLogic& b) {
+        const Board& boardA = *a.getBoard();
+        const Board& boardB = *b.getBoard();
+        return planesOf(a) == planesOf(b) && a.getGameState() == b.getGameState() &&
+               a.getClickCount() == b.getClickCount() && boardA.getSeed() == boardB.getSeed() &&
+               boardA.getRevealedCount() == boardB.getRevealedCount() &&
+               boardA.getFlagCount() == boardB.getFlagCount() &&
+               boardA.getSolvedBBBV() == boardB.getSolvedBBBV() && a.isInProgress() == b.isInProgress();
+    }
+
+    void testRoundTrip(CellLayout layout) {
+        // In progress: the clock resumes from the saved time
+        GameLogic game(SETTINGS, layout);
+        playSome(game, 11);
+        game.pauseTimer();
+        std::int64_t elapsed = game.getElapsedMilliseconds();
+        CHECK(game.saveGame(PATH));
+
+        GameLogic loaded(SETTINGS, layout);
+        playSome(loaded, 12);
+        CHECK(loaded.loadGame(PATH));
+        CHECK(sameGame(game, loaded));
+        CHECK(loaded.getElapsedMilliseconds() >= elapsed);
+        CHECK(loaded.getElapsedMilliseconds() < elapsed + 1000);
+        CHECK(!loaded.hasReplay());
+
+        // Both play on the same way
+        for (int x = 0; x < SETTINGS.width; ++x) {
+            if (!game.getBoard()->getCell(x, 0).hasMine()) {
+                game.handleLeftClick(x, 0);
+                loaded.handleLeftClick(x, 0);
+            }
+        }
+        CHECK(planesOf(game) == planesOf(loaded));
+
+        // Lost: the state and the stopped clock exactly
+        for (int x = 0; x < SETTINGS.width; ++x) {
+            if (game.getBoard()->getCell(x, SETTINGS.height - 1).hasMine() &&
+                !game.getBoard()->getCell(x, SETTINGS.height - 1).isFlagged()) {
+                game.handleLeftClick(x, SETTINGS.height - 1);
+                break;
+            }
+        }
+        CHECK(game.getGameState() == Config::GameState::LOST);
+        CHECK(game.saveGame(PATH));
+        GameLogic lost(SETTINGS, layout);
+        CHECK(lost.loadGame(PATH));
+        CHECK(sameGame(game, lost));
+        CHECK(lost.getElapsedMilliseconds() == game.getElapsedMilliseconds());
+
+        // Not started yet: no mines, the first click places them
+        GameLogic fresh(SETTINGS, layout);
+        fresh.startNewGame(13);
+        CHECK(fresh.saveGame(PATH));
+        CHECK(lost.loadGame(PATH));
+        CHECK(sameGame(fresh, lost));
+        CHECK(!lost.getBoard()->isInitialized());
+
+        std::remove(PATH);
+        std::printf("round trip (%s): in progress, lost and fresh games restored\n",
+                    layout == CellLayout::Tiled ? "tiled" : "row-major");
+    }
+
+    std::vector<char> readFile(const char* path) {
+        std::ifstream in(path, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    void writeFile(const char* path, const std::vector<char>& bytes) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    // Planes edited in place, with the checksum (FNV-1a over the plane
+    // words) made right again so only the consistency checks can refuse it
+    std::vector<char> editPlanes(std::vector<char> bytes, void (*edit)(std::uint64_t*, size_t)) {
+        SaveFileHeader header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        size_t words = static_cast<size_t>(header.planeWords);
+        std::vector<std::uint64_t> planes(SaveFile::PLANE_COUNT * words);
+        std::memcpy(planes.data(), bytes.data() + header.headerSize, planes.size() * sizeof(std::uint64_t));
+        edit(planes.data(), words);
+
+        std::uint64_t hash = 0xCBF29CE484222325ull;
+        for (std::uint64_t word : planes) {
+            hash = (hash ^ word) * 0x100000001B3ull;
+        }
+        header.checksum = hash;
+        std::memcpy(bytes.data(), &header, sizeof(header));
+        std::memcpy(bytes.data() + header.headerSize, planes.data(), planes.size() * sizeof(std::uint64_t));
+        return bytes;
+    }
+
+    void testRejected(CellLayout layout) {
+        GameLogic game(SETTINGS, layout);
+        playSome(game, 21);
+        CHECK(game.saveGame(PATH));
+        const std::vector<char> good = readFile(PATH);
+
+        std::vector<std::vector<char>> bad;
+        // One byte of the checksum, one byte of a plane
+        std::vector<char> bytes = good;
+        bytes[offsetof(SaveFileHeader, checksum) + 2] ^= 0x10;
+        bad.push_back(bytes);
+        bytes = good;
+        bytes[sizeof(SaveFileHeader) + 5] ^= 0x01;
+        bad.push_back(bytes);
+        // Truncated, by a word and inside the header
+        bad.emplace_back(good.begin(), good.end() - 8);
+        bad.emplace_back(good.begin(), good.begin() + 40);
+        // A revealed cell off the board: the last stored one (past cell 480
+        // row-major, padding of the last tile), and (30, 0) in the padding
+        // of the first row of tiles
+        bad.push_back(editPlanes(good, [](std::uint64_t* planes, size_t words) {
+            planes[words + words - 1] |= std::uint64_t(1) << 63;
+        }));
+        if (layout == CellLayout::Tiled) {
+            bad.push_back(editPlanes(good, [](std::uint64_t* planes, size_t words) {
+                planes[words + 3] |= std::uint64_t(1) << 6;
+            }));
+        }
+        // A flag on a revealed cell
+        bad.push_back(editPlanes(good, [](std::uint64_t* planes, size_t words) {
+            for (size_t w = 0; w < words; ++w) {
+                if (planes[words + w] != 0) {
+                    planes[2 * words + w] |= planes[words + w] & (~planes[words + w] + 1);
+                    break;
+                }
+            }
+        }));
+
+        GameLogic target(SETTINGS, layout);
+        playSome(target, 22);
+        Planes before = planesOf(target);
+        Config::GameState state = target.getGameState();
+        int clicks = target.getClickCount();
+        int rejected = 0;
+        for (size_t i = 0; i < bad.size(); ++i) {
+            writeFile(PATH, bad[i]);
+            if (!CHECK(!target.loadGame(PATH))) {
+                std::fprintf(stderr, "  damaged save %zu accepted\n", i);
+            }
+            rejected++;
+        }
+        CHECK(planesOf(target) == before);
+        CHECK(target.getGameState() == state && target.getClickCount() == clicks);
+
+        // The undamaged file still loads
+        writeFile(PATH, good);
+        CHECK(target.loadGame(PATH));
+        CHECK(sameGame(game, target));
+        std::remove(PATH);
+        std::printf("rejected (%s): %d damaged saves\n", layout == CellLayout::Tiled ? "tiled" : "row-major",
+                    rejected);
+    }
+}
+
+int main() {
+    testRoundTrip(CellLayout::RowMajor);
+    testRoundTrip(CellLayout::Tiled);
+    testRejected(CellLayout::RowMajor);
+    testRejected(CellLayout::Tiled);
+    return TEST_RESULT();
+}
@@ -0,0 +1,230 @@
+// Solver: every deduction checked against the enumeration of all mine
+// layouts (BruteForce.hpp), the single-number rules complete, and the
+// solver kept up to date move by move (and through an undo) deducing the
+// same as one attached afresh.
+
+#include "BruteForce.hpp"
+#include "Check.hpp"
+#include "Logic/Random.hpp"
+#include "Logic/Solver.hpp"
+#include <cstdio>
+#include <vector>
+
+using namespace Minesweeper;
+using namespace Minesweeper::Test;
+
+namespace {
+    struct Case {
+        int width, height, mines;
+    };
+    const Case CASES[] = {{8, 8, 10}, {9, 9, 10}, {10, 6, 12}, {7, 7, 12}};
+
+    // Reveals one cell, telling the solver what changed
+    void revealFor(Board& board, Solver& solver, int x, int y) {
+        std::uint64_t serial = board.getRevealSerial();
+        board.revealCell(x, y);
+        if (board.getRevealSerial() != serial) {
+            for (size_t index : board.getLastReveal().cells) {
+                solver.cellChanged(index);
+            }
+        } else {
+            solver.cellChanged(board.cellIndex(x, y));
+        }
+    }
+
+    // Hidden cells the solver settled: 1 safe, 2 mine, 0 unknown
+    std::vector<int> knownCells(const Board& board, Solver& solver) {
+        std::vector<int> known(static_cast<size_t>(board.getWidth()) * board.getHeight(), 0);
+        for (std::uint32_t cell : solver.getSafeCells()) {
+            known[cell] = 1;
+        }
+        for (std::uint32_t cell : solver.getMineCells()) {
+            known[cell] = 2;
+        }
+        return known;
+    }
+
+    struct Tally {
+        int states = 0;
+        int deductions = 0;
+        int unsound = 0;
+        int missedByCountRule = 0;
+        int differsFromFresh = 0;
+    };
+
+    void checkState(const Board& board, Solver& kept, Tally& tally) {
+        int width = board.getWidth();
+        CHECK(kept.solve());
+        std::vector<int> known = knownCells(board, kept);
+
+        Solver fresh;
+        fresh.attach(board);
+        CHECK(fresh.solve());
+        tally.differsFromFresh += knownCells(board, fresh) != known;
+
+        Enumeration layouts = enumerateLayouts(board);
+        for (size_t cell = 0; cell < known.size(); ++cell) {
+            if (known[cell] != 0) {
+                tally.deductions++;
+                tally.unsound += known[cell] == 1 ? !layouts.isSafe(cell) : !layouts.isMine(cell);
+            }
+        }
+
+        // A number whose hidden neighbors are all mines, or that has all
+        // its mines among the proven ones, settles the rest
+        for (int y = 0; y < board.getHeight(); ++y) {
+            for (int x = 0; x < width; ++x) {
+                const Cell& cell = board.getCell(x, y);
+                if (!cell.isRevealed() || cell.getAdjacentMines() == 0) {
+                    continue;
+                }
+                int hidden = 0, provenMines = 0;
+                std::vector<size_t> neighbors;
+                for (int ny = y - 1; ny <= y + 1; ++ny) {
+                    for (int nx = x - 1; nx <= x + 1; ++nx) {
+                        if (board.isCellValid(nx, ny) && !board.getCell(nx, ny).isRevealed()) {
+                            size_t index = static_cast<size_t>(ny) * width + nx;
+                            hidden++;
+                            provenMines += known[index] == 2;
+                            neighbors.push_back(index);
+                        }
+                    }
+                }
+                for (size_t index : neighbors) {
+                    if (hidden == cell.getAdjacentMines()) {
+                        tally.missedByCountRule += known[index] != 2;
+                    } else if (provenMines == cell.getAdjacentMines()) {
+                        tally.missedByCountRule += known[index] == 0;
+                    }
+                }
+            }
+        }
+        tally.states++;
+    }
+
+    // Games advanced by revealing a random safe cell (not necessarily a
+    // proven one), so the states cover what a player can see
+    void testRandomGames() {
+        Random::Generator random(2024);
+        Tally tally;
+        for (const Case& c : CASES) {
+            for (std::uint64_t seed = 1; seed <= 25; ++seed) {
+                Board board(c.width, c.height, c.mines);
+                board.reset(seed);
+                int firstX = static_cast<int>(seed % c.width), firstY = static_cast<int>(seed * 7 % c.height);
+                board.initialize(firstX, firstY);
+                Solver kept;
+                board.revealCell(firstX, firstY);
+                kept.attach(board);
+
+                int safeCount = c.width * c.height - c.mines;
+                while (board.getRevealedCount() < safeCount) {
+                    checkState(board, kept, tally);
+                    std::vector<std::pair<int, int>> hiddenSafe;
+                    for (int y = 0; y < c.height; ++y) {
+                        for (int x = 0; x < c.width; ++x) {
+                            if (!board.getCell(x, y).isRevealed() && !board.getCell(x, y).hasMine()) {
+                                hiddenSafe.push_back({x, y});
+                            }
+                        }
+                    }
+                    auto next = hiddenSafe[static_cast<size_t>(random.uniform() * hiddenSafe.size())];
+                    revealFor(board, kept, next.first, next.second);
+                }
+            }
+        }
+        std::printf("%d states, %d deductions checked\n", tally.states, tally.deductions);
+        CHECK(tally.states > 500 && tally.deductions > 5000);
+        CHECK(tally.unsound == 0);
+        CHECK(tally.missedByCountRule == 0);
+        CHECK(tally.differsFromFresh == 0);
+    }
+
+    // Hiding cells again (undo) rebuilds the solver from the board
+    void testUndo() {
+        Board board(9, 9, 10);
+        board.reset(5);
+        board.initialize(4, 4);
+        board.revealCell(4, 4);
+        Solver solver;
+        solver.attach(board);
+        CHECK(solver.solve());
+
+        std::vector<size_t> revealed;
+        for (int y = 0; y < 9; ++y) {
+            for (int x = 0; x < 9; ++x) {
+                if (board.getCell(x, y).isRevealed() && (x != 4 || y != 4)) {
+                    revealed.push_back(board.cellIndex(x, y));
+                }
+            }
+        }
+        for (size_t i = 0; i < revealed.size(); i += 2) {
+            board.setCellRevealed(revealed[i], false);
+            solver.cellChanged(revealed[i]);
+        }
+        Tally tally;
+        checkState(board, solver, tally);
+        CHECK(tally.unsound == 0 && tally.differsFromFresh == 0);
+    }
+
+    // Trusted flags count as mines, and misplaced ones are reported
+    void testTrustedFlags() {
+        Board board(9, 9, 10);
+        board.reset(3);
+        board.initialize(0, 0);
+        board.revealCell(0, 0);
+        Solver solver(true);
+        solver.attach(board);
+        CHECK(solver.solve());
+        for (std::uint32_t cell : std::vector<std::uint32_t>(solver.getMineCells())) {
+            board.toggleFlag(static_cast<int>(cell % 9), static_cast<int>(cell / 9));
+            solver.cellChanged(board.cellIndex(static_cast<int>(cell % 9), static_cast<int>(cell / 9)));
+        }
+        CHECK(solver.solve());
+        Enumeration layouts = enumerateLayouts(board);
+        for (std::uint32_t cell : solver.getSafeCells()) {
+            CHECK(layouts.isSafe(cell));
+        }
+
+        // A flag on every hidden neighbor of a 1 that has two or more
+        // contradicts it
+        bool contradicted = false;
+        for (int y = 0; y < 9 && !contradicted; ++y) {
+            for (int x = 0; x < 9 && !contradicted; ++x) {
+                if (!board.getCell(x, y).isRevealed() || board.getCell(x, y).getAdjacentMines() != 1) {
+                    continue;
+                }
+                std::vector<std::pair<int, int>> hidden;
+                for (int ny = y - 1; ny <= y + 1; ++ny) {
+                    for (int nx = x - 1; nx <= x + 1; ++nx) {
+                        if (board.isCellValid(nx, ny) && !board.getCell(nx, ny).isRevealed()) {
+                            hidden.push_back({nx, ny});
+                        }
+                    }
+                }
+                if (hidden.size() < 2) {
+                    continue;
+                }
+                for (auto [nx, ny] : hidden) {
+                    if (!board.getCell(nx, ny).isFlagged()) {
+                        board.toggleFlag(nx, ny);
+                        solver.cellChanged(board.cellIndex(nx, ny));
+                    }
+                }
+                contradicted = true;
+            }
+        }
+        CHECK(contradicted);
+        CHECK(!solver.solve());
+        Solver fresh(true);
+        fresh.attach(board);
+        CHECK(!fresh.solve());
+    }
+}
+
+int main() {
+    testRandomGames();
+    testUndo();
+    testTrustedFlags();
+    return TEST_RESULT();
+}
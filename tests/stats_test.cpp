@@ -0,0 +1,230 @@
+// Statistics (StatsStore): games appended and read back after reopening,
+// and the log and index recovering from crashes: a torn last record, an
+// index behind or ahead of the log, a log cut short before its header.
+
+#include "Check.hpp"
+#include "Logic/StatsStore.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+using namespace Minesweeper;
+
+namespace {
+    const char* const LOG = "stats_test.log";
+    const char* const INDEX = "stats_test.idx";
+    const Config::Difficulty DIFFICULTIES[] = {Config::Difficulty::BEGINNER, Config::Difficulty::INTERMEDIATE,
+                                               Config::Difficulty::EXPERT, Config::Difficulty::CUSTOM};
+
+    void removeFiles() {
+        std::remove(LOG);
+        std::remove(INDEX);
+    }
+
+    std::vector<char> readFile(const char* path) {
+        std::ifstream in(path, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    void writeFile(const char* path, const std::vector<char>& bytes) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    // Game i: won two times out of three, times out of order
+    bool appendGame(StatsStore& store, int i) {
+        Config::GameState result = i % 3 != 2 ? Config::GameState::WON : Config::GameState::LOST;
+        return store.append(DIFFICULTIES[i % 2 == 0 ? 0 : 2], result, 1000 + (i * 7919) % 5000, 10 + i, 20 + i);
+    }
+
+    // Same counts, best times and last game as a store that read every
+    // record of the log from scratch
+    bool sameAsRebuilt(const StatsStore& store) {
+        std::vector<char> index = readFile(INDEX);
+        std::remove(INDEX);
+        StatsStore rebuilt(LOG, INDEX);
+        bool same = rebuilt.open() && rebuilt.getRecordCount() == store.getRecordCount();
+        for (Config::Difficulty difficulty : DIFFICULTIES) {
+            same = same && std::memcmp(&store.getDifficulty(difficulty), &rebuilt.getDifficulty(difficulty),
+                                       sizeof(StatsDifficulty)) == 0;
+        }
+        StatsRecord a, b;
+        bool hasA = store.getLastGame(a), hasB = rebuilt.getLastGame(b);
+        same = same && hasA == hasB && (!hasA || std::memcmp(&a, &b, sizeof(a)) == 0);
+        writeFile(INDEX, index);
+        return same;
+    }
+
+    void testAppendAndReopen() {
+        removeFiles();
+        const int games = 40;
+        {
+            StatsStore store(LOG, INDEX);
+            CHECK(store.open());
+            CHECK(store.getRecordCount() == 0);
+            StatsRecord last;
+            CHECK(!store.getLastGame(last));
+            for (int i = 0; i < games; ++i) {
+                CHECK(appendGame(store, i));
+            }
+        }
+
+        StatsStore store(LOG, INDEX);
+        CHECK(store.open());
+        CHECK(store.getRecordCount() == games);
+
+        // Beginner: the even games; won unless i % 3 == 2
+        const StatsDifficulty& beginner = store.getDifficulty(Config::Difficulty::BEGINNER);
+        std::vector<std::uint32_t> times;
+        int played = 0, won = 0;
+        for (int i = 0; i < games; i += 2) {
+            played++;
+            if (i % 3 != 2) {
+                won++;
+                times.push_back(static_cast<std::uint32_t>(1000 + (i * 7919) % 5000));
+            }
+        }
+        std::sort(times.begin(), times.end());
+        CHECK(beginner.played == static_cast<std::uint64_t>(played));
+        CHECK(beginner.won == static_cast<std::uint64_t>(won));
+        CHECK(beginner.bestCount == StatsFile::BEST_COUNT);
+        bool sorted = true;
+        for (std::uint32_t i = 0; i < beginner.bestCount; ++i) {
+            sorted = sorted && beginner.best[i].timeMilliseconds == times[i];
+        }
+        CHECK(sorted);
+        CHECK(store.getWinRate(Config::Difficulty::BEGINNER) == static_cast<double>(won) / played);
+        CHECK(store.getDifficulty(Config::Difficulty::INTERMEDIATE).played == 0);
+        CHECK(store.getWinRate(Config::Difficulty::INTERMEDIATE) == 0.0);
+
+        StatsRecord last;
+        CHECK(store.getLastGame(last));
+        CHECK(last.bbbv == 10 + games - 1 && last.clicks == 20 + games - 1);
+        CHECK(last.difficulty == static_cast<std::uint8_t>(Config::Difficulty::EXPERT));
+        CHECK(sameAsRebuilt(store));
+        std::printf("append: %d games, beginner %d of %d won, best %u ms\n", games, won, played, times[0]);
+    }
+
+    // A record cut short, or whole but corrupted, ends the log; the next
+    // append goes over it
+    void testTornRecord() {
+        removeFiles();
+        {
+            StatsStore store(LOG, INDEX);
+            CHECK(store.open());
+            for (int i = 0; i < 5; ++i) {
+                CHECK(appendGame(store, i));
+            }
+        }
+        std::vector<char> log = readFile(LOG);
+        const size_t full = sizeof(StatsLogHeader) + 5 * sizeof(StatsRecord);
+        CHECK(log.size() == full);
+
+        for (int torn = 0; torn < 2; ++torn) {
+            std::vector<char> damaged = log;
+            if (torn == 0) {
+                damaged.insert(damaged.end(), log.end() - 13, log.end()); // 13 bytes of a sixth record
+            } else {
+                damaged.insert(damaged.end(), log.end() - sizeof(StatsRecord), log.end());
+                damaged.back() ^= 0x40; // its checksum
+            }
+            writeFile(LOG, damaged);
+            std::remove(INDEX);
+
+            StatsStore store(LOG, INDEX);
+            CHECK(store.open());
+            CHECK(store.getRecordCount() == 5);
+            CHECK(appendGame(store, 5));
+            CHECK(store.getRecordCount() == 6);
+            CHECK(readFile(LOG).size() == full + sizeof(StatsRecord));
+
+            StatsStore reopened(LOG, INDEX);
+            CHECK(reopened.open());
+            CHECK(reopened.getRecordCount() == 6);
+            CHECK(sameAsRebuilt(reopened));
+        }
+        std::printf("torn record: ignored, then overwritten\n");
+    }
+
+    // An index saved before the last appends catches up with the log; one
+    // counting more records than the log holds is rebuilt
+    void testIndexRecovery() {
+        removeFiles();
+        std::vector<char> oldIndex, shortLog;
+        {
+            StatsStore store(LOG, INDEX);
+            CHECK(store.open());
+            for (int i = 0; i < 12; ++i) {
+                if (i == 4) {
+                    oldIndex = readFile(INDEX);
+                    shortLog = readFile(LOG);
+                }
+                CHECK(appendGame(store, i));
+            }
+        }
+
+        // Behind: 4 of 12 records counted
+        writeFile(INDEX, oldIndex);
+        {
+            StatsStore store(LOG, INDEX);
+            CHECK(store.open());
+            CHECK(store.getRecordCount() == 12);
+            CHECK(sameAsRebuilt(store));
+        }
+        StatsStore caughtUp(LOG, INDEX); // and saved while catching up
+        CHECK(caughtUp.open() && caughtUp.getRecordCount() == 12);
+
+        // Ahead: a 12-record index over the 4-record log
+        writeFile(LOG, shortLog);
+        {
+            StatsStore store(LOG, INDEX);
+            CHECK(store.open());
+            CHECK(store.getRecordCount() == 4);
+            CHECK(store.getDifficulty(Config::Difficulty::BEGINNER).played == 2);
+            CHECK(sameAsRebuilt(store));
+            CHECK(appendGame(store, 4));
+        }
+        StatsStore rebuilt(LOG, INDEX);
+        CHECK(rebuilt.open() && rebuilt.getRecordCount() == 5);
+        std::printf("index: caught up from 4 to 12 records, rebuilt from 12 down to 4\n");
+    }
+
+    // A log cut short before its header holds no games and is created
+    // again; one with another header is left alone
+    void testBrokenHeader() {
+        for (size_t length : {size_t(0), size_t(5), sizeof(StatsLogHeader) - 1}) {
+            removeFiles();
+            writeFile(LOG, std::vector<char>(length, 'M'));
+            StatsStore store(LOG, INDEX);
+            CHECK(store.open());
+            CHECK(store.getRecordCount() == 0);
+            CHECK(appendGame(store, 0));
+            CHECK(readFile(LOG).size() == sizeof(StatsLogHeader) + sizeof(StatsRecord));
+            StatsStore reopened(LOG, INDEX);
+            CHECK(reopened.open() && reopened.getRecordCount() == 1);
+        }
+
+        removeFiles();
+        std::vector<char> other(sizeof(StatsLogHeader) + sizeof(StatsRecord), 'x');
+        writeFile(LOG, other);
+        StatsStore store(LOG, INDEX);
+        CHECK(!store.open());
+        CHECK(!appendGame(store, 0));
+        CHECK(readFile(LOG) == other);
+        removeFiles();
+        std::printf("header: short logs created again, foreign log untouched\n");
+    }
+}
+
+int main() {
+    testAppendAndReopen();
+    testTornRecord();
+    testIndexRecovery();
+    testBrokenHeader();
+    return TEST_RESULT();
+}
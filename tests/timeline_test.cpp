@@ -0,0 +1,192 @@
+// Replay viewer seeking (ReplayTimeline): every seek, forwards and
+// backwards, within and across keyframe intervals, shows what a full
+// replay shows after the same event. Also with a journal too small for the
+// first cascade, which then becomes a keyframe of its own.
+
+#include "Check.hpp"
+#include "Logic/GameLogic.hpp"
+#include "Logic/ReplayPlayer.hpp"
+#include "Logic/ReplayTimeline.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Minesweeper;
+
+namespace {
+    const Config::DifficultySettings SETTINGS = {60, 40, 240, 0};
+
+    struct Frame {
+        std::vector<std::uint64_t> revealed, flagged;
+        Config::GameState state;
+        int clickCount;
+
+        bool operator==(const Frame& other) const {
+            return revealed == other.revealed && flagged == other.flagged && state == other.state &&
+                   clickCount == other.clickCount;
+        }
+    };
+
+    Frame frameOf(const GameLogic& game) {
+        const Board& board = *game.getBoard();
+        size_t words = board.getPlaneWordCount();
+        std::vector<std::uint64_t> mines(words);
+        Frame frame{std::vector<std::uint64_t>(words), std::vector<std::uint64_t>(words),
+                    game.getGameState(), game.getClickCount()};
+        board.packPlanes(mines.data(), frame.revealed.data(), frame.flagged.data());
+        return frame;
+    }
+
+    // Reveals, flags, chords, undo and redo; a lost game is undone and goes
+    // on. Only moves of a few cells are undone, so a journal just smaller
+    // than the opening still has them. Returns the opening's size.
+    int recordGame(Replay& replay, std::uint64_t seed, size_t events) {
+        GameLogic game(SETTINGS);
+        game.startNewGame(seed);
+        const Board& board = *game.getBoard();
+        game.handleLeftClick(0, 0);
+        int opening = board.getRevealedCount();
+
+        std::mt19937 rng(static_cast<std::uint32_t>(seed));
+        int smallMoves = 0; // undoable moves at the end of the history
+        while (game.getReplay().getEventCount() < events && !game.isGameWon()) {
+            if (game.getGameState() == Config::GameState::LOST) {
+                game.undo();
+                smallMoves = 0;
+                continue;
+            }
+            int x = static_cast<int>(rng() % board.getWidth());
+            int y = static_cast<int>(rng() % board.getHeight());
+            const Cell& cell = board.getCell(x, y);
+            int revealed = board.getRevealedCount();
+            size_t before = game.getReplay().getEventCount();
+            unsigned roll = rng() % 10;
+            if (roll < 2 && smallMoves > 0) {
+                game.undo();
+                smallMoves--;
+                if (rng() % 2) {
+                    game.redo();
+                    smallMoves++;
+                }
+                continue;
+            }
+            if (cell.isRevealed()) {
+                game.handleChord(x, y);
+            } else if (roll < 6) {
+                game.handleRightClick(x, y);
+            } else if (!cell.isFlagged()) {
+                game.handleLeftClick(x, y);
+            }
+            if (game.getReplay().getEventCount() != before) {
+                bool small = board.getRevealedCount() - revealed <= 5;
+                smallMoves = small ? std::min(smallMoves + 1, 2) : 0;
+            }
+        }
+
+        replay = game.getReplay();
+        replay.setResult(game.getReplayResult());
+        return opening;
+    }
+
+    // frames[n]: the game after n events, from one full replay
+    std::vector<Frame> fullReplay(const Replay& replay) {
+        GameLogic game(SETTINGS);
+        std::vector<Frame> frames;
+        frames.push_back(Frame{std::vector<std::uint64_t>(game.getBoard()->getPlaneWordCount(), 0),
+                               std::vector<std::uint64_t>(game.getBoard()->getPlaneWordCount(), 0),
+                               Config::GameState::PLAYING, 0});
+        ReplayPlayer::Report report = ReplayPlayer::play(replay, game, [&](size_t, const ReplayEvent&) {
+            frames.push_back(frameOf(game));
+        });
+        CHECK(report.ok);
+        return frames;
+    }
+
+    // Seeks around the timeline, each checked against the full replay
+    int checkSeeks(ReplayTimeline& timeline, GameLogic& game, const std::vector<Frame>& frames) {
+        size_t count = timeline.getEventCount();
+        size_t interval = timeline.getKeyframeInterval();
+        std::vector<size_t> targets = {0, 1, 2, 3, interval - 1, interval, interval + 1,
+                                       interval + 5, interval + 2, 2 * interval + 3, interval - 2,
+                                       count, count - 1, count - interval / 2, 5, count / 2,
+                                       count / 2 + interval + 7, count / 2 + 1, 0};
+        std::mt19937 rng(17);
+        for (int i = 0; i < 60; ++i) {
+            size_t from = targets.back();
+            size_t step = rng() % (2 * interval);
+            targets.push_back(rng() % 2 ? std::min(count, from + step % 9) : rng() % (count + 1));
+            targets.push_back(step <= from ? from - step : count - step % count);
+        }
+        for (size_t position = 0; position <= count; ++position) {
+            targets.push_back(position); // every event, one step at a time
+        }
+
+        int seeks = 0;
+        for (size_t target : targets) {
+            target = std::min(target, count);
+            timeline.seek(target);
+            CHECK(timeline.getPosition() == target);
+            if (!CHECK(frameOf(game) == frames[target])) {
+                std::fprintf(stderr, "  seek to %zu of %zu\n", target, count);
+                return seeks;
+            }
+            seeks++;
+        }
+        return seeks;
+    }
+
+    void testSeek() {
+        Replay replay;
+        recordGame(replay, 41, 700);
+        std::vector<Frame> frames = fullReplay(replay);
+        CHECK(frames.size() == replay.getEventCount() + 1);
+
+        GameLogic game(SETTINGS);
+        ReplayTimeline timeline;
+        std::string error;
+        CHECK(timeline.build(replay, game, error));
+        CHECK(timeline.getEventCount() == replay.getEventCount());
+        CHECK(timeline.getEventCount() > 5 * timeline.getKeyframeInterval());
+        CHECK(timeline.getKeyframeCount() == 1 + timeline.getEventCount() / timeline.getKeyframeInterval());
+        CHECK(frameOf(game) == frames[0]);
+        int seeks = checkSeeks(timeline, game, frames);
+        std::printf("seek: %zu events, %zu keyframes, %d seeks matched\n", timeline.getEventCount(),
+                    timeline.getKeyframeCount(), seeks);
+    }
+
+    // The opening doesn't fit the journal: its step restores a keyframe
+    // taken right after it, and seeking through it still works
+    void testMoveTooLargeForJournal() {
+        Replay replay;
+        int opening = 0;
+        for (std::uint64_t seed = 42; seed < 142 && opening < 200; ++seed) {
+            opening = recordGame(replay, seed, 300);
+        }
+        CHECK(opening >= 200);
+        std::vector<Frame> frames = fullReplay(replay);
+
+        GameLogic game(SETTINGS);
+        game.setJournalCapacity(static_cast<size_t>(opening) - 1);
+        ReplayTimeline timeline;
+        std::string error;
+        if (!CHECK(timeline.build(replay, game, error))) {
+            std::fprintf(stderr, "  %s\n", error.c_str());
+            return;
+        }
+        // Any later cascade as large is one too
+        size_t regular = 1 + timeline.getEventCount() / timeline.getKeyframeInterval();
+        CHECK(timeline.getKeyframeCount() > regular);
+        int seeks = checkSeeks(timeline, game, frames);
+        std::printf("large move: opening of %d cells over a %d-cell journal, %zu keyframes, %d seeks matched\n",
+                    opening, opening - 1, timeline.getKeyframeCount(), seeks);
+    }
+}
+
+int main() {
+    testSeek();
+    testMoveTooLargeForJournal();
+    return TEST_RESULT();
+}
@@ -0,0 +1,107 @@
+// Board benchmark: generation and reveal cascade throughput, row-major
+// against tiled cell layout, and the cost of one Parallel::forEach call
+// (what each BFS level of a parallel cascade pays twice).
+//
+//   board_bench [width] [height] [mine density]
+//
+// Defaults to a 10000 x 10000 board at 8% mines, sparse enough for the
+// first click to open most of the board in a single cascade.
+
+#include "Logic/Board.hpp"
+#include "Logic/Parallel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace Minesweeper;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    
+    double millisecondsSince(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+    
+    void runBench(const char* name, CellLayout layout, int width, int height, int mines) {
+        Board board(width, height, mines, layout);
+        board.setSeed(0x5EED);
+        board.setRevealLevels(true);
+        
+        Clock::time_point start = Clock::now();
+        board.initialize(width / 2, height / 2);
+        double generateMs = millisecondsSince(start);
+        
+        start = Clock::now();
+        board.revealCell(width / 2, height / 2);
+        double revealMs = millisecondsSince(start);
+        
+        double revealed = board.getRevealedCount();
+        std::printf("%-10s generate %9.1f ms | cascade %9.1f ms, %11.0f cells, %7.1f Mcells/s, %zu levels\n",
+                    name, generateMs, revealMs, revealed,
+                    revealMs > 0 ? revealed / revealMs / 1000.0 : 0.0, board.getLastReveal().getLevelCount());
+    }
+    
+    // Reference: threads created and joined for every call
+    template <typename Fn>
+    void forEachNewThreads(size_t count, unsigned workers, Fn&& fn) {
+        std::atomic<size_t> next{0};
+        auto work = [&]() {
+            for (size_t i = next++; i < count; i = next++) {
+                fn(i);
+            }
+        };
+        std::vector<std::thread> threads;
+        for (unsigned t = 1; t < workers; ++t) {
+            threads.emplace_back(work);
+        }
+        work();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+    
+    // One call per BFS level: a frontier of a few chunks of light work
+    void runDispatchBench(unsigned workers, int calls) {
+        const size_t tasks = 8;
+        std::vector<std::atomic<std::uint64_t>> sums(tasks);
+        auto task = [&sums](size_t i) {
+            std::uint64_t sum = 0;
+            for (std::uint64_t k = 0; k < 1024; ++k) {
+                sum += k * (i + 1);
+            }
+            sums[i] += sum;
+        };
+        
+        Clock::time_point start = Clock::now();
+        for (int c = 0; c < calls; ++c) {
+            Parallel::forEachOnWorkers(tasks, [&task](unsigned, size_t i) { task(i); }, workers);
+        }
+        double poolUs = millisecondsSince(start) * 1000.0 / calls;
+        
+        start = Clock::now();
+        for (int c = 0; c < calls; ++c) {
+            forEachNewThreads(tasks, workers, task);
+        }
+        double threadsUs = millisecondsSince(start) * 1000.0 / calls;
+        
+        std::printf("dispatch   %u workers, %zu tasks: kept threads %7.1f us/call | new threads %7.1f us/call\n",
+                    workers, tasks, poolUs, threadsUs);
+    }
+}
+
+int main(int argc, char** argv) {
+    int width = argc > 1 ? std::atoi(argv[1]) : 10000;
+    int height = argc > 2 ? std::atoi(argv[2]) : 10000;
+    double density = argc > 3 ? std::atof(argv[3]) : 0.08;
+    int mines = static_cast<int>(static_cast<double>(width) * height * density);
+    
+    std::printf("Board %d x %d, %d mines\n", width, height, mines);
+    runBench("row-major", CellLayout::RowMajor, width, height, mines);
+    runBench("tiled 8x8", CellLayout::Tiled, width, height, mines);
+    runDispatchBench(std::max(2u, Parallel::workerCount()), 2000);
+    return 0;
+}
@@ -0,0 +1,55 @@
+// Headless replay player: plays recorded games through GameLogic as fast
+// as possible and checks each one ends as recorded.
+//
+//   replay_play <file.msreplay>...
+//
+// Prints one line per failing replay, then the totals and the event
+// throughput; exits with 1 when any replay fails. Feeding it a corpus of
+// real games gives a realistic workload for performance runs.
+
+#include "Logic/GameLogic.hpp"
+#include "Logic/ReplayPlayer.hpp"
+#include <chrono>
+#include <cstdio>
+
+using namespace Minesweeper;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <file.msreplay>...\n", argv[0]);
+        return 2;
+    }
+    
+    size_t passed = 0, failed = 0, events = 0;
+    double playMs = 0.0;
+    for (int i = 1; i < argc; ++i) {
+        Replay replay;
+        if (!replay.load(argv[i])) {
+            failed++;
+            continue;
+        }
+        
+        Config::DifficultySettings settings{replay.getWidth(), replay.getHeight(), replay.getMineCount(), 0};
+        GameLogic game(settings);
+        
+        Clock::time_point start = Clock::now();
+        ReplayPlayer::Report report = ReplayPlayer::play(replay, game);
+        playMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        events += report.eventsPlayed;
+        
+        if (report.ok) {
+            passed++;
+        } else {
+            failed++;
+            std::printf("FAIL %s: %s\n", argv[i], report.error.c_str());
+        }
+    }
+    
+    std::printf("%zu replays ok, %zu failed | %zu events in %.1f ms, %.0f events/s\n",
+                passed, failed, events, playMs, playMs > 0 ? events * 1000.0 / playMs : 0.0);
+    return failed == 0 ? 0 : 1;
+}
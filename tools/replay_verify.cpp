@@ -0,0 +1,128 @@
+// Leaderboard replay verifier: checks every replay of a directory by
+// playing it through the headless GameLogic.
+//
+//   replay_verify [--threads N] [--allow-undo] <directory>
+//
+// A replay passes when its board regenerates from the seed, every event is
+// a legal move that changes the game, and the recorded time and result
+// match the playback (see ReplayPlayer). Undo and redo are refused unless
+// --allow-undo is given. Replays are spread over a pool of worker threads,
+// each playing on its own GameLogic reused from one replay to the next.
+// Prints the failing replays and a summary; exits with 1 when any failed.
+
+#include "Logic/GameLogic.hpp"
+#include "Logic/Parallel.hpp"
+#include "Logic/ReplayPlayer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Minesweeper;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct Worker {
+        std::unique_ptr<GameLogic> game;
+        Replay replay;
+    };
+
+    struct Outcome {
+        bool ok = false;
+        std::string error;
+        size_t events = 0;
+    };
+
+    Outcome verify(Worker& worker, const std::string& path, bool allowUndo) {
+        Outcome outcome;
+        if (!worker.replay.load(path)) {
+            outcome.error = "unreadable replay";
+            return outcome;
+        }
+
+        // Same board size as the last replay (the usual case): just restart
+        const Replay& replay = worker.replay;
+        Config::DifficultySettings settings{replay.getWidth(), replay.getHeight(), replay.getMineCount(), 0};
+        if (!worker.game) {
+            worker.game = std::make_unique<GameLogic>(settings);
+            worker.game->setRecordingReplay(false);
+        } else {
+            const Board& board = *worker.game->getBoard();
+            if (board.getWidth() != settings.width || board.getHeight() != settings.height ||
+                board.getMineCount() != settings.mines) {
+                worker.game->resizeBoard(settings);
+            }
+        }
+
+        ReplayPlayer::Report report = ReplayPlayer::play(replay, *worker.game);
+        outcome.events = report.eventsPlayed;
+        if (!report.ok) {
+            outcome.error = report.error;
+        } else if (!allowUndo && report.undoCount > 0) {
+            outcome.error = "uses undo";
+        } else {
+            outcome.ok = true;
+        }
+        return outcome;
+    }
+}
+
+int main(int argc, char** argv) {
+    unsigned threads = Parallel::workerCount();
+    bool allowUndo = false;
+    const char* directory = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        } else if (std::strcmp(argv[i], "--allow-undo") == 0) {
+            allowUndo = true;
+        } else {
+            directory = argv[i];
+        }
+    }
+    if (!directory) {
+        std::fprintf(stderr, "usage: %s [--threads N] [--allow-undo] <directory>\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<std::string> paths;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        if (entry.path().extension() == ReplayFile::EXTENSION) {
+            paths.push_back(entry.path().string());
+        }
+    }
+    if (error) {
+        std::fprintf(stderr, "%s: %s\n", directory, error.message().c_str());
+        return 2;
+    }
+    std::sort(paths.begin(), paths.end());
+
+    Clock::time_point start = Clock::now();
+    std::vector<Worker> workers(threads);
+    std::vector<Outcome> outcomes(paths.size());
+    Parallel::forEachOnWorkers(paths.size(), [&](unsigned worker, size_t i) {
+        outcomes[i] = verify(workers[worker], paths[i], allowUndo);
+    }, threads);
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    size_t failed = 0, events = 0;
+    for (size_t i = 0; i < paths.size(); ++i) {
+        events += outcomes[i].events;
+        if (!outcomes[i].ok) {
+            failed++;
+            std::printf("FAIL %s: %s\n", paths[i].c_str(), outcomes[i].error.c_str());
+        }
+    }
+
+    std::printf("%zu replays, %zu ok, %zu failed | %zu events | %.2f s on %u threads, %.0f replays/s\n",
+                paths.size(), paths.size() - failed, failed, events, seconds, threads,
+                seconds > 0 ? paths.size() / seconds : 0.0);
+    return failed == 0 ? 0 : 1;
+}